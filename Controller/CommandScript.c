@@ -0,0 +1,770 @@
+#include "Controller/CommandScript.h"
+#include "Controller/EmergencyStop.h"
+#include "Controller/HeaterTemperatureController.h"
+#include "Controller/HeaterTemperatureReader.h"
+#include "Controller/ReferenceTemperatureController.h"
+#include "Controller/ReferenceTemperatureReader.h"
+#include "Controller/SegmentsManager.h"
+
+#include "SharedDefines/ECommandScriptOpcode.h"
+#include "SharedDefines/ECommandScriptRegister.h"
+#include "SharedDefines/ECommandScriptCondition.h"
+#include "SharedDefines/ADS1248Types.h"
+#include "SharedDefines/EControlSystemType.h"
+#include "SharedDefines/SSegmentData.h"
+
+#include "Devices/ADS1248.h"
+#include "Peripherals/TIM2.h"
+
+#include "Utilities/Logger/Logger.h"
+#include "Utilities/Printer/CStringConverter.h"
+
+#include "cmsis_os.h"
+
+#include "string.h"
+
+// Compact bytecode executed by a dedicated thread, so a sequence of set points, waits and register
+// writes runs with local timing instead of one request per step. A script is uploaded in chunks and
+// validated as a whole on commit, the interpreter then trusts the operands. Delays are scheduled from
+// the previous instruction deadline, not from the moment the thread woke up, so loops do not drift.
+// Every loop body has to contain a wait, otherwise it would starve the lower priority threads.
+
+#define COMMAND_SCRIPT_MAX_SIZE 1024
+#define COMMAND_SCRIPT_MAX_LOOP_DEPTH 4
+#define COMMAND_SCRIPT_CONDITION_POLL_PERIOD_MS 10
+
+#define COMMAND_SCRIPT_START_SIGNAL 0x01
+#define COMMAND_SCRIPT_STOP_SIGNAL 0x02
+
+typedef struct _SLoopFrame
+{
+    u16 bodyPc;
+    u16 iterationsLeft;
+    bool isEndless;
+} SLoopFrame;
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+static osThreadId mExecutorThreadId = NULL;
+
+static TByte mScriptBanks [2][COMMAND_SCRIPT_MAX_SIZE];
+static TByte* mScript = mScriptBanks[0];
+static TByte* mUploadedScript = mScriptBanks[1];
+static u16 mScriptLength = 0;
+static u16 mUploadedLength = 0;
+static bool mIsUploadStarted = false;
+
+static volatile bool mIsRunning = false;
+static volatile bool mIsStopRequested = false;
+
+static void (*mMarkerIndCallback)(u16, u16, u32) = NULL;
+static void (*mScriptDoneIndCallback)(ECommandScriptStatus, u16, u32) = NULL;
+
+static void commandScriptExecutor(void const* arg);
+static ECommandScriptStatus executeScript(u16* pc);
+static bool executeSetRegister(ECommandScriptRegister scriptRegister, float value);
+static ECommandScriptStatus executeWait(ECommandScriptCondition condition, float threshold, u32 timeout, u32* scheduleTime);
+static bool executeSetSegment(SSegmentData* segment);
+static void emitMarker(u16 marker, u16 pc);
+static bool isConditionMet(ECommandScriptCondition condition, float threshold);
+static ECommandScriptStatus getInterruptedStatus(void);
+static bool validateScript(const TByte* script, u16 length);
+static bool isRegisterValueValid(ECommandScriptRegister scriptRegister, float value);
+static u8 getInstructionSize(ECommandScriptOpcode opcode);
+static u16 readU16(const TByte* data);
+static u32 readU32(const TByte* data);
+static float readFloat(const TByte* data);
+static const char* getLoggerPrefix(void);
+
+void CommandScript_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+    osThreadDef(commandScriptThread, commandScriptExecutor, osPriorityAboveNormal, 0, configNORMAL_STACK_SIZE);
+    mExecutorThreadId = osThreadCreate(osThread(commandScriptThread), NULL);
+}
+
+bool CommandScript_startUpload(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    mUploadedLength = 0;
+    mIsUploadStarted = true;
+    
+    Logger_debug("%s: Script upload started.", getLoggerPrefix());
+    
+    osMutexRelease(mMutexId);
+    
+    return true;
+}
+
+bool CommandScript_uploadChunk(const TByte* code, u8 length)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = false;
+    
+    if (!mIsUploadStarted)
+    {
+        Logger_error("%s: Uploading script chunk is not possible. Script upload not started.", getLoggerPrefix());
+    }
+    else if (COMMAND_SCRIPT_MAX_SIZE - mUploadedLength < length)
+    {
+        Logger_error("%s: Uploading script chunk is not possible. Script exceeds %u bytes.", getLoggerPrefix(), COMMAND_SCRIPT_MAX_SIZE);
+    }
+    else
+    {
+        memcpy(&(mUploadedScript[mUploadedLength]), code, length);
+        mUploadedLength += length;
+        result = true;
+    }
+    
+    if (!result)
+    {
+        mIsUploadStarted = false;
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool CommandScript_commitUpload(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = false;
+    
+    if (!mIsUploadStarted)
+    {
+        Logger_error("%s: Committing uploaded script is not possible. Script upload not started or failed.", getLoggerPrefix());
+    }
+    else if (mIsRunning)
+    {
+        Logger_error("%s: Committing uploaded script is not possible. Script is running.", getLoggerPrefix());
+    }
+    else if (validateScript(mUploadedScript, mUploadedLength))
+    {
+        TByte* previousScript = mScript;
+        mScript = mUploadedScript;
+        mUploadedScript = previousScript;
+        mScriptLength = mUploadedLength;
+        
+        Logger_info("%s: Uploaded script of %u bytes applied.", getLoggerPrefix(), mScriptLength);
+        
+        result = true;
+    }
+    
+    mIsUploadStarted = false;
+    mUploadedLength = 0;
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void CommandScript_abortUpload(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mIsUploadStarted)
+    {
+        Logger_warning("%s: Script upload aborted after %u bytes.", getLoggerPrefix(), mUploadedLength);
+    }
+    
+    mIsUploadStarted = false;
+    mUploadedLength = 0;
+    
+    osMutexRelease(mMutexId);
+}
+
+u16 CommandScript_getLoadedLength(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    u16 length = mScriptLength;
+    osMutexRelease(mMutexId);
+    return length;
+}
+
+bool CommandScript_start(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = false;
+    
+    if (EmergencyStop_isActive())
+    {
+        Logger_warning("%s: Emergency stop is active. Script not started.", getLoggerPrefix());
+    }
+    else if (mIsRunning)
+    {
+        Logger_warning("%s: Script is already running.", getLoggerPrefix());
+    }
+    else if (0 == mScriptLength)
+    {
+        Logger_warning("%s: No script loaded.", getLoggerPrefix());
+    }
+    else
+    {
+        mIsStopRequested = false;
+        mIsRunning = true;
+        osSignalSet(mExecutorThreadId, COMMAND_SCRIPT_START_SIGNAL);
+        
+        Logger_info("%s: Script started.", getLoggerPrefix());
+        
+        result = true;
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool CommandScript_stop(void)
+{
+    // Executor holds the mutex while reporting, so the request is passed without taking it.
+    bool result = mIsRunning;
+    if (result)
+    {
+        mIsStopRequested = true;
+        osSignalSet(mExecutorThreadId, COMMAND_SCRIPT_STOP_SIGNAL);
+    }
+    
+    return result;
+}
+
+bool CommandScript_isRunning(void)
+{
+    return mIsRunning;
+}
+
+void CommandScript_registerMarkerIndCallback(void (*callback)(u16, u16, u32))
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mMarkerIndCallback = callback;
+    osMutexRelease(mMutexId);
+}
+
+void CommandScript_deregisterMarkerIndCallback(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mMarkerIndCallback = NULL;
+    osMutexRelease(mMutexId);
+}
+
+void CommandScript_registerScriptDoneIndCallback(void (*callback)(ECommandScriptStatus, u16, u32))
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mScriptDoneIndCallback = callback;
+    osMutexRelease(mMutexId);
+}
+
+void CommandScript_deregisterScriptDoneIndCallback(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mScriptDoneIndCallback = NULL;
+    osMutexRelease(mMutexId);
+}
+
+void commandScriptExecutor(void const* arg)
+{
+    while (true)
+    {
+        osSignalWait(COMMAND_SCRIPT_START_SIGNAL, osWaitForever);
+        if (!mIsRunning)
+        {
+            continue;
+        }
+        
+        u32 startTime = TIM2_getMicroseconds();
+        u16 pc = 0;
+        ECommandScriptStatus status = executeScript(&pc);
+        u32 executionTime = TIM2_getMicroseconds() - startTime;
+        
+        osMutexWait(mMutexId, osWaitForever);
+        
+        mIsRunning = false;
+        mIsStopRequested = false;
+        
+        if (ECommandScriptStatus_Done == status)
+        {
+            Logger_info("%s: Script done after %u us.", getLoggerPrefix(), executionTime);
+        }
+        else
+        {
+            Logger_warning("%s: Script finished at %u: %s.", getLoggerPrefix(), pc, CStringConverter_ECommandScriptStatus(status));
+        }
+        
+        if (mScriptDoneIndCallback)
+        {
+            (*mScriptDoneIndCallback)(status, pc, executionTime);
+        }
+        
+        osMutexRelease(mMutexId);
+    }
+}
+
+ECommandScriptStatus executeScript(u16* pc)
+{
+    SLoopFrame loops [COMMAND_SCRIPT_MAX_LOOP_DEPTH];
+    u8 loopDepth = 0;
+    u32 scheduleTime = TIM2_getMicroseconds();
+    
+    while (true)
+    {
+        if ( mIsStopRequested || EmergencyStop_isActive() )
+        {
+            return getInterruptedStatus();
+        }
+        
+        const TByte* instruction = &(mScript[*pc]);
+        ECommandScriptOpcode opcode = (ECommandScriptOpcode) instruction[0];
+        u16 nextPc = *pc + getInstructionSize(opcode);
+        
+        switch (opcode)
+        {
+            case ECommandScriptOpcode_End :
+                return ECommandScriptStatus_Done;
+            
+            case ECommandScriptOpcode_SetRegister :
+            {
+                ECommandScriptRegister scriptRegister = (ECommandScriptRegister) instruction[1];
+                if (!executeSetRegister(scriptRegister, readFloat(&(instruction[2]))))
+                {
+                    Logger_error("%s: Setting %s at %u failed.", getLoggerPrefix(), CStringConverter_ECommandScriptRegister(scriptRegister), *pc);
+                    return ECommandScriptStatus_InstructionFailed;
+                }
+                
+                break;
+            }
+            
+            case ECommandScriptOpcode_Wait :
+            {
+                ECommandScriptStatus status = executeWait((ECommandScriptCondition) instruction[1], readFloat(&(instruction[2])), readU32(&(instruction[6])), &scheduleTime);
+                if (ECommandScriptStatus_Done != status)
+                {
+                    return status;
+                }
+                
+                break;
+            }
+            
+            case ECommandScriptOpcode_SetSegment :
+            {
+                SSegmentData segment;
+                segment.number = readU16(&(instruction[1]));
+                segment.type = (ESegmentType) instruction[3];
+                segment.startTemperature = readFloat(&(instruction[4]));
+                segment.stopTemperature = readFloat(&(instruction[8]));
+                segment.settingTimeInterval = readU32(&(instruction[12]));
+                segment.temperatureStep = readFloat(&(instruction[16]));
+                
+                if (!executeSetSegment(&segment))
+                {
+                    Logger_error("%s: Setting segment %u at %u failed.", getLoggerPrefix(), segment.number, *pc);
+                    return ECommandScriptStatus_InstructionFailed;
+                }
+                
+                break;
+            }
+            
+            case ECommandScriptOpcode_LoopBegin :
+            {
+                u16 iterations = readU16(&(instruction[1]));
+                loops[loopDepth].bodyPc = nextPc;
+                loops[loopDepth].iterationsLeft = iterations;
+                loops[loopDepth].isEndless = ( 0 == iterations );
+                ++loopDepth;
+                break;
+            }
+            
+            case ECommandScriptOpcode_LoopEnd :
+            {
+                SLoopFrame* loop = &(loops[loopDepth - 1]);
+                if (!(loop->isEndless))
+                {
+                    --(loop->iterationsLeft);
+                }
+                
+                if ( loop->isEndless || (0 != loop->iterationsLeft) )
+                {
+                    // A condition wait that is already met returns at once, so every iteration yields at least one tick.
+                    osDelay(1);
+                    nextPc = loop->bodyPc;
+                }
+                else
+                {
+                    --loopDepth;
+                }
+                
+                break;
+            }
+            
+            case ECommandScriptOpcode_EmitMarker :
+                emitMarker(readU16(&(instruction[1])), *pc);
+                break;
+            
+            case ECommandScriptOpcode_Count :
+                return ECommandScriptStatus_InstructionFailed;
+        }
+        
+        *pc = nextPc;
+    }
+}
+
+bool executeSetRegister(ECommandScriptRegister scriptRegister, float value)
+{
+    bool isEnabled = ( 0.0f != value );
+    
+    switch (scriptRegister)
+    {
+        case ECommandScriptRegister_HeaterPower :
+            return HeaterTemperatureController_setPowerInPercent(value);
+        
+        case ECommandScriptRegister_HeaterSetPoint :
+            return HeaterTemperatureController_setTemperature(value);
+        
+        case ECommandScriptRegister_HeaterControllerRunning :
+            return isEnabled ? HeaterTemperatureController_start() : HeaterTemperatureController_stop();
+        
+        case ECommandScriptRegister_ReferenceStabilization :
+            if (isEnabled)
+            {
+                return ReferenceTemperatureController_startStabilization();
+            }
+            
+            ReferenceTemperatureController_stopStabilization();
+            return true;
+        
+        case ECommandScriptRegister_ADS1248Gain :
+            return ADS1248_setChannelGain((EADS1248GainValue) value);
+        
+        case ECommandScriptRegister_ADS1248SamplingSpeed :
+            return ADS1248_setChannelSamplingSpeed((EADS1248SamplingSpeed) value);
+        
+        case ECommandScriptRegister_ControlSystemType :
+            return HeaterTemperatureController_setSystemType((EControlSystemType) value);
+        
+        case ECommandScriptRegister_AlgorithmExecutionPeriod :
+            return HeaterTemperatureController_setAlgorithmExecutionPeriod((u16) value);
+        
+        case ECommandScriptRegister_SegmentsProgramRunning :
+            return isEnabled ? SegmentsManager_startProgram() : SegmentsManager_stopProgram();
+        
+        case ECommandScriptRegister_Count :
+            break;
+    }
+    
+    return false;
+}
+
+ECommandScriptStatus executeWait(ECommandScriptCondition condition, float threshold, u32 timeout, u32* scheduleTime)
+{
+    u32 timeoutUs = timeout * 1000;
+    u32 waitStartTime = ( ECommandScriptCondition_Delay == condition ) ? *scheduleTime : TIM2_getMicroseconds();
+    
+    while (true)
+    {
+        u32 elapsedTime = TIM2_getMicroseconds() - waitStartTime;
+        
+        if (ECommandScriptCondition_Delay == condition)
+        {
+            if (elapsedTime >= timeoutUs)
+            {
+                // Next delay counts from this deadline, so the wake-up latency is not accumulated.
+                *scheduleTime += timeoutUs;
+                return ECommandScriptStatus_Done;
+            }
+        }
+        else if (isConditionMet(condition, threshold))
+        {
+            *scheduleTime = TIM2_getMicroseconds();
+            return ECommandScriptStatus_Done;
+        }
+        else if ( (0 != timeout) && (elapsedTime >= timeoutUs) )
+        {
+            Logger_warning("%s: %s %.2f not met within %u ms.", getLoggerPrefix(), CStringConverter_ECommandScriptCondition(condition), threshold, timeout);
+            return ECommandScriptStatus_WaitTimeout;
+        }
+        
+        u32 waitTime = COMMAND_SCRIPT_CONDITION_POLL_PERIOD_MS;
+        if ( (ECommandScriptCondition_Delay == condition) || (0 != timeout) )
+        {
+            u32 leftTime = ( timeoutUs - elapsedTime ) / 1000;
+            waitTime = ( leftTime < waitTime ) ? leftTime : waitTime;
+        }
+        
+        if (0 != waitTime)
+        {
+            osSignalWait(COMMAND_SCRIPT_STOP_SIGNAL, waitTime);
+        }
+        
+        if ( mIsStopRequested || EmergencyStop_isActive() )
+        {
+            return getInterruptedStatus();
+        }
+    }
+}
+
+bool executeSetSegment(SSegmentData* segment)
+{
+    bool isProgramRunning = false;
+    u16 currentSegmentNumber;
+    u16 registeredSegmentsCount;
+    u32 timestamp;
+    
+    SegmentsManager_readProgramStatusSnapshot(&isProgramRunning, &currentSegmentNumber, &registeredSegmentsCount, &timestamp);
+    
+    if ( (0 != registeredSegmentsCount) && SegmentsManager_modifyRegisteredSegment(segment) )
+    {
+        return true;
+    }
+    
+    return SegmentsManager_registerNewSegment(segment);
+}
+
+void emitMarker(u16 marker, u16 pc)
+{
+    u32 timestamp = TIM2_getMicroseconds();
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    Logger_debug("%s: Marker %u at %u.", getLoggerPrefix(), marker, pc);
+    
+    if (mMarkerIndCallback)
+    {
+        (*mMarkerIndCallback)(marker, pc, timestamp);
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+bool isConditionMet(ECommandScriptCondition condition, float threshold)
+{
+    float controllerError;
+    
+    switch (condition)
+    {
+        case ECommandScriptCondition_HeaterTemperatureAbove :
+            return HeaterTemperatureReader_getTemperature() > threshold;
+        
+        case ECommandScriptCondition_HeaterTemperatureBelow :
+            return HeaterTemperatureReader_getTemperature() < threshold;
+        
+        case ECommandScriptCondition_ReferenceTemperatureAbove :
+            return ReferenceTemperatureReader_getTemperature() > threshold;
+        
+        case ECommandScriptCondition_ReferenceTemperatureBelow :
+            return ReferenceTemperatureReader_getTemperature() < threshold;
+        
+        case ECommandScriptCondition_ControllerErrorWithin :
+            controllerError = HeaterTemperatureController_getControllerError();
+            return ( controllerError <= threshold ) && ( -threshold <= controllerError );
+        
+        case ECommandScriptCondition_Delay :
+        case ECommandScriptCondition_Count :
+            break;
+    }
+    
+    return false;
+}
+
+ECommandScriptStatus getInterruptedStatus(void)
+{
+    return EmergencyStop_isActive() ? ECommandScriptStatus_EmergencyStop : ECommandScriptStatus_Stopped;
+}
+
+bool validateScript(const TByte* script, u16 length)
+{
+    u8 loopDepth = 0;
+    bool hasLoopWait [COMMAND_SCRIPT_MAX_LOOP_DEPTH];
+    u16 pc = 0;
+    
+    while (length > pc)
+    {
+        ECommandScriptOpcode opcode = (ECommandScriptOpcode) script[pc];
+        u8 size = getInstructionSize(opcode);
+        
+        if (0 == size)
+        {
+            Logger_error("%s: Validation: unknown opcode %u at %u.", getLoggerPrefix(), opcode, pc);
+            return false;
+        }
+        
+        if (length - pc < size)
+        {
+            Logger_error("%s: Validation: %s at %u truncated.", getLoggerPrefix(), CStringConverter_ECommandScriptOpcode(opcode), pc);
+            return false;
+        }
+        
+        const TByte* instruction = &(script[pc]);
+        
+        switch (opcode)
+        {
+            case ECommandScriptOpcode_End :
+                if ( (0 != loopDepth) || (length != pc + size) )
+                {
+                    Logger_error("%s: Validation: %s at %u with open loops or trailing code.", getLoggerPrefix(), CStringConverter_ECommandScriptOpcode(opcode), pc);
+                    return false;
+                }
+                
+                return true;
+            
+            case ECommandScriptOpcode_SetRegister :
+                if (!isRegisterValueValid((ECommandScriptRegister) instruction[1], readFloat(&(instruction[2]))))
+                {
+                    Logger_error("%s: Validation: invalid register %u value at %u.", getLoggerPrefix(), instruction[1], pc);
+                    return false;
+                }
+                
+                break;
+            
+            case ECommandScriptOpcode_Wait :
+                if ( (ECommandScriptCondition_Count <= instruction[1]) || (UINT32_MAX / 1000 < readU32(&(instruction[6]))) )
+                {
+                    Logger_error("%s: Validation: invalid wait at %u.", getLoggerPrefix(), pc);
+                    return false;
+                }
+                
+                // A zero delay returns at once, it does not make a loop yield.
+                for (u8 iter = 0; ( (ECommandScriptCondition_Delay != instruction[1]) || (0 != readU32(&(instruction[6]))) ) && (loopDepth > iter); ++iter)
+                {
+                    hasLoopWait[iter] = true;
+                }
+                
+                break;
+            
+            case ECommandScriptOpcode_SetSegment :
+                if ( (ESegmentType_Static != instruction[3]) && (ESegmentType_Dynamic != instruction[3]) )
+                {
+                    Logger_error("%s: Validation: unknown segment type at %u.", getLoggerPrefix(), pc);
+                    return false;
+                }
+                
+                break;
+            
+            case ECommandScriptOpcode_LoopBegin :
+                if (COMMAND_SCRIPT_MAX_LOOP_DEPTH == loopDepth)
+                {
+                    Logger_error("%s: Validation: loops nested deeper than %u at %u.", getLoggerPrefix(), COMMAND_SCRIPT_MAX_LOOP_DEPTH, pc);
+                    return false;
+                }
+                
+                hasLoopWait[loopDepth] = false;
+                ++loopDepth;
+                break;
+            
+            case ECommandScriptOpcode_LoopEnd :
+                if ( (0 == loopDepth) || !hasLoopWait[loopDepth - 1] )
+                {
+                    Logger_error("%s: Validation: unmatched loop or loop without wait at %u.", getLoggerPrefix(), pc);
+                    return false;
+                }
+                
+                --loopDepth;
+                break;
+            
+            case ECommandScriptOpcode_EmitMarker :
+            case ECommandScriptOpcode_Count :
+                break;
+        }
+        
+        pc += size;
+    }
+    
+    Logger_error("%s: Validation: script does not end with %s.", getLoggerPrefix(), CStringConverter_ECommandScriptOpcode(ECommandScriptOpcode_End));
+    return false;
+}
+
+bool isRegisterValueValid(ECommandScriptRegister scriptRegister, float value)
+{
+    switch (scriptRegister)
+    {
+        case ECommandScriptRegister_HeaterPower :
+            return ( 0.0f <= value ) && ( 100.0f >= value );
+        
+        case ECommandScriptRegister_HeaterSetPoint :
+        case ECommandScriptRegister_HeaterControllerRunning :
+        case ECommandScriptRegister_ReferenceStabilization :
+        case ECommandScriptRegister_SegmentsProgramRunning :
+            return true;
+        
+        case ECommandScriptRegister_ADS1248Gain :
+            return ( 0.0f <= value ) && ( (float) EADS1248GainValue_128 >= value );
+        
+        case ECommandScriptRegister_ADS1248SamplingSpeed :
+            return ( 0.0f <= value ) && ( (float) EADS1248SamplingSpeed_2000SPS >= value );
+        
+        case ECommandScriptRegister_ControlSystemType :
+            return ( 0.0f <= value ) && ( (float) EControlSystemType_MFCFeedback >= value );
+        
+        case ECommandScriptRegister_AlgorithmExecutionPeriod :
+            return ( 1.0f <= value ) && ( (float) UINT16_MAX >= value );
+        
+        case ECommandScriptRegister_Count :
+            break;
+    }
+    
+    return false;
+}
+
+u8 getInstructionSize(ECommandScriptOpcode opcode)
+{
+    switch (opcode)
+    {
+        case ECommandScriptOpcode_End :
+            return 1;
+        
+        case ECommandScriptOpcode_SetRegister :
+            return 6;
+        
+        case ECommandScriptOpcode_Wait :
+            return 10;
+        
+        case ECommandScriptOpcode_SetSegment :
+            return 20;
+        
+        case ECommandScriptOpcode_LoopBegin :
+            return 3;
+        
+        case ECommandScriptOpcode_LoopEnd :
+            return 1;
+        
+        case ECommandScriptOpcode_EmitMarker :
+            return 3;
+        
+        case ECommandScriptOpcode_Count :
+            break;
+    }
+    
+    return 0;
+}
+
+u16 readU16(const TByte* data)
+{
+    return (u16) ( data[0] | (data[1] << 8) );
+}
+
+u32 readU32(const TByte* data)
+{
+    return (u32) data[0] | ( (u32) data[1] << 8 ) | ( (u32) data[2] << 16 ) | ( (u32) data[3] << 24 );
+}
+
+float readFloat(const TByte* data)
+{
+    u32 raw = readU32(data);
+    float value;
+    memcpy(&value, &raw, sizeof(value));
+    return value;
+}
+
+const char* getLoggerPrefix(void)
+{
+    static const char* loggerPrefix = "CommandScript";
+    return loggerPrefix;
+}
+
+#undef COMMAND_SCRIPT_MAX_SIZE
+#undef COMMAND_SCRIPT_MAX_LOOP_DEPTH
+#undef COMMAND_SCRIPT_CONDITION_POLL_PERIOD_MS
+#undef COMMAND_SCRIPT_START_SIGNAL
+#undef COMMAND_SCRIPT_STOP_SIGNAL
@@ -0,0 +1,26 @@
+#ifndef _COMMAND_SCRIPT_H_
+
+#define _COMMAND_SCRIPT_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/ECommandScriptStatus.h"
+#include "stdbool.h"
+
+void CommandScript_setup(void);
+
+bool CommandScript_startUpload(void);
+bool CommandScript_uploadChunk(const TByte* code, u8 length);
+bool CommandScript_commitUpload(void);
+void CommandScript_abortUpload(void);
+u16 CommandScript_getLoadedLength(void);
+
+bool CommandScript_start(void);
+bool CommandScript_stop(void);
+bool CommandScript_isRunning(void);
+
+void CommandScript_registerMarkerIndCallback(void (*callback)(u16, u16, u32));
+void CommandScript_deregisterMarkerIndCallback(void);
+void CommandScript_registerScriptDoneIndCallback(void (*callback)(ECommandScriptStatus, u16, u32));
+void CommandScript_deregisterScriptDoneIndCallback(void);
+
+#endif
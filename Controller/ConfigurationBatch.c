@@ -0,0 +1,590 @@
+#include "Controller/ConfigurationBatch.h"
+#include "Controller/HeaterTemperatureController.h"
+
+#include "Devices/ADS1248.h"
+#include "Devices/LMP90100ControlSystem.h"
+#include "Devices/LMP90100SignalsMeasurement.h"
+
+#include "Utilities/Printer/CStringConverter.h"
+#include "Utilities/Logger/Logger.h"
+#include "Utilities/CopyObject.h"
+
+#include "cmsis_os.h"
+
+// Settings requested by Master between begin and commit are only staged here. Commit validates the
+// staged set as a whole and then applies it in one ordered pass, touching every device once:
+// ADS1248 (mode, then gain and sampling speed in a single SYS0 write), both LMP90100s, and finally
+// the heater controller, whose system type goes last so a started algorithm uses the new tunes.
+// Device writes can still fail on the bus, so the current values of everything staged are
+// snapshotted first and, when a step fails, the steps taken so far are undone in reverse order.
+
+#define CONFIGURATION_BATCH_PIDS_COUNT 2
+
+typedef struct _SConfigurationBatch
+{
+    bool isADS1248ModeStaged;
+    EADS1248Mode ads1248Mode;
+    bool isADS1248GainStaged;
+    EADS1248GainValue ads1248Gain;
+    bool isADS1248SamplingSpeedStaged;
+    EADS1248SamplingSpeed ads1248SamplingSpeed;
+    bool isLMP90100ControlSystemModeStaged;
+    ELMP90100Mode lmp90100ControlSystemMode;
+    bool isLMP90100SignalsMeasurementModeStaged;
+    ELMP90100Mode lmp90100SignalsMeasurementMode;
+    bool isControlSystemTypeStaged;
+    EControlSystemType controlSystemType;
+    bool areTunesStaged [CONFIGURATION_BATCH_PIDS_COUNT];
+    SPidTunes tunes [CONFIGURATION_BATCH_PIDS_COUNT];
+    bool isAlgorithmExecutionPeriodStaged;
+    u16 algorithmExecutionPeriod;
+} SConfigurationBatch;
+
+typedef bool (*TApplyStep)(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+
+static volatile bool mIsOpen = false;
+static SConfigurationBatch mBatch;
+
+static void clearBatch(void);
+static u8 countStagedChanges(void);
+static bool validateBatch(void);
+static void takeSnapshot(SConfigurationBatch* snapshot);
+static bool applyADS1248Mode(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+static bool applyADS1248ChannelConfiguration(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+static bool applyLMP90100ControlSystemMode(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+static bool applyLMP90100SignalsMeasurementMode(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+static bool applyAlgorithmExecutionPeriod(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+static bool applyControllerTunes(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+static bool applyControlSystemType(const SConfigurationBatch* configuration, u8* appliedChangesCount);
+static bool isLMP90100ModeValid(ELMP90100Mode mode);
+static const char* getLoggerPrefix(void);
+
+static const TApplyStep mApplySteps [] =
+{
+    applyADS1248Mode,
+    applyADS1248ChannelConfiguration,
+    applyLMP90100ControlSystemMode,
+    applyLMP90100SignalsMeasurementMode,
+    applyAlgorithmExecutionPeriod,
+    applyControllerTunes,
+    applyControlSystemType
+};
+
+#define CONFIGURATION_BATCH_STEPS_COUNT ( sizeof(mApplySteps) / sizeof(mApplySteps[0]) )
+
+void ConfigurationBatch_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+    clearBatch();
+}
+
+bool ConfigurationBatch_begin(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mIsOpen)
+    {
+        osMutexRelease(mMutexId);
+        Logger_warning("%s: Batch is already open. New begin request skipped.", getLoggerPrefix());
+        return false;
+    }
+    
+    clearBatch();
+    mIsOpen = true;
+    
+    osMutexRelease(mMutexId);
+    
+    Logger_info("%s: Batch opened.", getLoggerPrefix());
+    return true;
+}
+
+bool ConfigurationBatch_isOpen(void)
+{
+    return mIsOpen;
+}
+
+bool ConfigurationBatch_commit(u8* stagedChangesCount, u8* appliedChangesCount)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    *stagedChangesCount = 0;
+    *appliedChangesCount = 0;
+    
+    if (!mIsOpen)
+    {
+        osMutexRelease(mMutexId);
+        Logger_warning("%s: No batch is open. Commit skipped.", getLoggerPrefix());
+        return false;
+    }
+    
+    mIsOpen = false;
+    *stagedChangesCount = countStagedChanges();
+    
+    if (!validateBatch())
+    {
+        Logger_error("%s: Batch commit rejected, no change applied.", getLoggerPrefix());
+        clearBatch();
+        osMutexRelease(mMutexId);
+        return false;
+    }
+    
+    SConfigurationBatch snapshot;
+    takeSnapshot(&snapshot);
+    
+    u8 step = 0;
+    bool result = true;
+    
+    for (; result && (CONFIGURATION_BATCH_STEPS_COUNT > step); ++step)
+    {
+        result = (*mApplySteps[step])(&mBatch, appliedChangesCount);
+    }
+    
+    if (result)
+    {
+        Logger_info("%s: Batch committed, %u changes applied.", getLoggerPrefix(), *appliedChangesCount);
+    }
+    else
+    {
+        Logger_error("%s: Batch commit failed after %u of %u changes. Rolling back...", getLoggerPrefix(), *appliedChangesCount, *stagedChangesCount);
+        
+        // The failed step is undone as well, a combined write may have been applied partially.
+        u8 restoredChangesCount = 0;
+        bool isRolledBack = true;
+        
+        while (0 < step)
+        {
+            --step;
+            isRolledBack = (*mApplySteps[step])(&snapshot, &restoredChangesCount) && isRolledBack;
+        }
+        
+        if (isRolledBack)
+        {
+            *appliedChangesCount = 0;
+            Logger_info("%s: Batch rolled back.", getLoggerPrefix());
+        }
+        else
+        {
+            Logger_error("%s: Batch rollback failed, configuration is inconsistent!", getLoggerPrefix());
+        }
+    }
+    
+    clearBatch();
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_abort(u8* discardedChangesCount)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = mIsOpen;
+    *discardedChangesCount = mIsOpen ? countStagedChanges() : 0;
+    mIsOpen = false;
+    clearBatch();
+    
+    osMutexRelease(mMutexId);
+    
+    if (result)
+    {
+        Logger_info("%s: Batch aborted, %u changes discarded.", getLoggerPrefix(), *discardedChangesCount);
+    }
+    else
+    {
+        Logger_warning("%s: No batch is open. Abort skipped.", getLoggerPrefix());
+    }
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageADS1248Mode(EADS1248Mode mode)
+{
+    if ( (EADS1248Mode_Off != mode) && (EADS1248Mode_On != mode) )
+    {
+        Logger_warning("%s: Unknown ADS1248 mode %u. Not staged.", getLoggerPrefix(), mode);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.isADS1248ModeStaged = true;
+        mBatch.ads1248Mode = mode;
+        Logger_debug("%s: Staged ADS1248 mode: %s.", getLoggerPrefix(), CStringConverter_EADS1248Mode(mode));
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageADS1248Gain(EADS1248GainValue gainValue)
+{
+    if (EADS1248GainValue_128 < gainValue)
+    {
+        Logger_warning("%s: Unknown ADS1248 gain %u. Not staged.", getLoggerPrefix(), gainValue);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.isADS1248GainStaged = true;
+        mBatch.ads1248Gain = gainValue;
+        Logger_debug("%s: Staged ADS1248 gain: %s.", getLoggerPrefix(), CStringConverter_EADS1248GainValue(gainValue));
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageADS1248SamplingSpeed(EADS1248SamplingSpeed samplingSpeed)
+{
+    if (EADS1248SamplingSpeed_2000SPS < samplingSpeed)
+    {
+        Logger_warning("%s: Unknown ADS1248 sampling speed %u. Not staged.", getLoggerPrefix(), samplingSpeed);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.isADS1248SamplingSpeedStaged = true;
+        mBatch.ads1248SamplingSpeed = samplingSpeed;
+        Logger_debug("%s: Staged ADS1248 sampling speed: %s.", getLoggerPrefix(), CStringConverter_EADS1248SamplingSpeed(samplingSpeed));
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageLMP90100ControlSystemMode(ELMP90100Mode mode)
+{
+    if (!isLMP90100ModeValid(mode))
+    {
+        Logger_warning("%s: Unknown LMP90100 Control System mode %u. Not staged.", getLoggerPrefix(), mode);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.isLMP90100ControlSystemModeStaged = true;
+        mBatch.lmp90100ControlSystemMode = mode;
+        Logger_debug("%s: Staged LMP90100 Control System mode: %s.", getLoggerPrefix(), CStringConverter_ELMP90100Mode(mode));
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageLMP90100SignalsMeasurementMode(ELMP90100Mode mode)
+{
+    if (!isLMP90100ModeValid(mode))
+    {
+        Logger_warning("%s: Unknown LMP90100 Signals Measurement mode %u. Not staged.", getLoggerPrefix(), mode);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.isLMP90100SignalsMeasurementModeStaged = true;
+        mBatch.lmp90100SignalsMeasurementMode = mode;
+        Logger_debug("%s: Staged LMP90100 Signals Measurement mode: %s.", getLoggerPrefix(), CStringConverter_ELMP90100Mode(mode));
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageControlSystemType(EControlSystemType type)
+{
+    if (EControlSystemType_MFCFeedback < type)
+    {
+        Logger_warning("%s: Unknown control system type %u. Not staged.", getLoggerPrefix(), type);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.isControlSystemTypeStaged = true;
+        mBatch.controlSystemType = type;
+        Logger_debug("%s: Staged control system type: %s.", getLoggerPrefix(), CStringConverter_EControlSystemType(type));
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageControllerTunes(EPid pid, SPidTunes* tunes)
+{
+    if (CONFIGURATION_BATCH_PIDS_COUNT <= pid)
+    {
+        Logger_warning("%s: Unknown PID %u. Tunes not staged.", getLoggerPrefix(), pid);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.areTunesStaged[pid] = true;
+        CopyObject_SPidTunes(tunes, &(mBatch.tunes[pid]));
+        Logger_debug("%s: Staged %s tunes.", getLoggerPrefix(), CStringConverter_EPid(pid));
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool ConfigurationBatch_stageAlgorithmExecutionPeriod(u16 period)
+{
+    if (0 == period)
+    {
+        Logger_warning("%s: Zero algorithm execution period. Not staged.", getLoggerPrefix());
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsOpen;
+    if (result)
+    {
+        mBatch.isAlgorithmExecutionPeriodStaged = true;
+        mBatch.algorithmExecutionPeriod = period;
+        Logger_debug("%s: Staged algorithm execution period: %u ms.", getLoggerPrefix(), period);
+    }
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void clearBatch(void)
+{
+    mBatch.isADS1248ModeStaged = false;
+    mBatch.isADS1248GainStaged = false;
+    mBatch.isADS1248SamplingSpeedStaged = false;
+    mBatch.isLMP90100ControlSystemModeStaged = false;
+    mBatch.isLMP90100SignalsMeasurementModeStaged = false;
+    mBatch.isControlSystemTypeStaged = false;
+    mBatch.isAlgorithmExecutionPeriodStaged = false;
+    
+    for (u8 iter = 0; CONFIGURATION_BATCH_PIDS_COUNT > iter; ++iter)
+    {
+        mBatch.areTunesStaged[iter] = false;
+    }
+}
+
+u8 countStagedChanges(void)
+{
+    u8 count = 0;
+    
+    count += mBatch.isADS1248ModeStaged ? 1 : 0;
+    count += mBatch.isADS1248GainStaged ? 1 : 0;
+    count += mBatch.isADS1248SamplingSpeedStaged ? 1 : 0;
+    count += mBatch.isLMP90100ControlSystemModeStaged ? 1 : 0;
+    count += mBatch.isLMP90100SignalsMeasurementModeStaged ? 1 : 0;
+    count += mBatch.isControlSystemTypeStaged ? 1 : 0;
+    count += mBatch.isAlgorithmExecutionPeriodStaged ? 1 : 0;
+    
+    for (u8 iter = 0; CONFIGURATION_BATCH_PIDS_COUNT > iter; ++iter)
+    {
+        count += mBatch.areTunesStaged[iter] ? 1 : 0;
+    }
+    
+    return count;
+}
+
+bool validateBatch(void)
+{
+    bool isADS1248ConfigurationStaged = mBatch.isADS1248GainStaged || mBatch.isADS1248SamplingSpeedStaged;
+    
+    if (isADS1248ConfigurationStaged && mBatch.isADS1248ModeStaged && (EADS1248Mode_Off == mBatch.ads1248Mode) )
+    {
+        Logger_error("%s: Validation: ADS1248 gain / sampling speed staged together with turning the device off.", getLoggerPrefix());
+        return false;
+    }
+    
+    bool isFeedbackStaged = mBatch.isControlSystemTypeStaged && (EControlSystemType_OpenLoop != mBatch.controlSystemType);
+    
+    if (isFeedbackStaged && mBatch.isLMP90100ControlSystemModeStaged && (ELMP90100Mode_Off == mBatch.lmp90100ControlSystemMode) )
+    {
+        Logger_error("%s: Validation: feedback control staged together with turning LMP90100 Control System off.", getLoggerPrefix());
+        return false;
+    }
+    
+    return true;
+}
+
+void takeSnapshot(SConfigurationBatch* snapshot)
+{
+    // Same staged flags as the batch, with the values in effect now.
+    *snapshot = mBatch;
+    snapshot->ads1248Mode = ADS1248_getMode();
+    snapshot->ads1248Gain = ADS1248_getChannelGain();
+    snapshot->ads1248SamplingSpeed = ADS1248_getChannelSamplingSpeed();
+    snapshot->lmp90100ControlSystemMode = LMP90100ControlSystem_getMode();
+    snapshot->lmp90100SignalsMeasurementMode = LMP90100SignalsMeasurement_getMode();
+    snapshot->controlSystemType = HeaterTemperatureController_getSystemType();
+    snapshot->algorithmExecutionPeriod = HeaterTemperatureController_getAlgorithmExecutionPeriod();
+    
+    for (u8 iter = 0; CONFIGURATION_BATCH_PIDS_COUNT > iter; ++iter)
+    {
+        HeaterTemperatureController_getTunes((EPid) iter, &(snapshot->tunes[iter]));
+    }
+}
+
+// Every step skips values already in effect, the drivers refuse to change a mode to itself.
+
+bool applyADS1248Mode(const SConfigurationBatch* configuration, u8* appliedChangesCount)
+{
+    if (!configuration->isADS1248ModeStaged)
+    {
+        return true;
+    }
+    
+    // Turning on rewrites all registers with defaults, so SYS0 is written in the next step.
+    if ( (ADS1248_getMode() != configuration->ads1248Mode) && !ADS1248_changeMode(configuration->ads1248Mode) )
+    {
+        return false;
+    }
+    
+    ++(*appliedChangesCount);
+    return true;
+}
+
+bool applyADS1248ChannelConfiguration(const SConfigurationBatch* configuration, u8* appliedChangesCount)
+{
+    if (configuration->isADS1248GainStaged && configuration->isADS1248SamplingSpeedStaged)
+    {
+        if ( ( (ADS1248_getChannelGain() != configuration->ads1248Gain) || (ADS1248_getChannelSamplingSpeed() != configuration->ads1248SamplingSpeed) )
+             && !ADS1248_setChannelConfiguration(configuration->ads1248Gain, configuration->ads1248SamplingSpeed) )
+        {
+            return false;
+        }
+        (*appliedChangesCount) += 2;
+    }
+    else if (configuration->isADS1248GainStaged)
+    {
+        if ( (ADS1248_getChannelGain() != configuration->ads1248Gain) && !ADS1248_setChannelGain(configuration->ads1248Gain) )
+        {
+            return false;
+        }
+        ++(*appliedChangesCount);
+    }
+    else if (configuration->isADS1248SamplingSpeedStaged)
+    {
+        if ( (ADS1248_getChannelSamplingSpeed() != configuration->ads1248SamplingSpeed) && !ADS1248_setChannelSamplingSpeed(configuration->ads1248SamplingSpeed) )
+        {
+            return false;
+        }
+        ++(*appliedChangesCount);
+    }
+    
+    return true;
+}
+
+bool applyLMP90100ControlSystemMode(const SConfigurationBatch* configuration, u8* appliedChangesCount)
+{
+    if (!configuration->isLMP90100ControlSystemModeStaged)
+    {
+        return true;
+    }
+    
+    if ( (LMP90100ControlSystem_getMode() != configuration->lmp90100ControlSystemMode) && !LMP90100ControlSystem_changeMode(configuration->lmp90100ControlSystemMode) )
+    {
+        return false;
+    }
+    
+    ++(*appliedChangesCount);
+    return true;
+}
+
+bool applyLMP90100SignalsMeasurementMode(const SConfigurationBatch* configuration, u8* appliedChangesCount)
+{
+    if (!configuration->isLMP90100SignalsMeasurementModeStaged)
+    {
+        return true;
+    }
+    
+    if ( (LMP90100SignalsMeasurement_getMode() != configuration->lmp90100SignalsMeasurementMode) && !LMP90100SignalsMeasurement_changeMode(configuration->lmp90100SignalsMeasurementMode) )
+    {
+        return false;
+    }
+    
+    ++(*appliedChangesCount);
+    return true;
+}
+
+bool applyAlgorithmExecutionPeriod(const SConfigurationBatch* configuration, u8* appliedChangesCount)
+{
+    if (!configuration->isAlgorithmExecutionPeriodStaged)
+    {
+        return true;
+    }
+    
+    if ( (HeaterTemperatureController_getAlgorithmExecutionPeriod() != configuration->algorithmExecutionPeriod) && !HeaterTemperatureController_setAlgorithmExecutionPeriod(configuration->algorithmExecutionPeriod) )
+    {
+        return false;
+    }
+    
+    ++(*appliedChangesCount);
+    return true;
+}
+
+bool applyControllerTunes(const SConfigurationBatch* configuration, u8* appliedChangesCount)
+{
+    for (u8 iter = 0; CONFIGURATION_BATCH_PIDS_COUNT > iter; ++iter)
+    {
+        if (configuration->areTunesStaged[iter])
+        {
+            SPidTunes tunes = configuration->tunes[iter];
+            
+            if (!HeaterTemperatureController_setTunes((EPid) iter, &tunes))
+            {
+                return false;
+            }
+            ++(*appliedChangesCount);
+        }
+    }
+    
+    return true;
+}
+
+bool applyControlSystemType(const SConfigurationBatch* configuration, u8* appliedChangesCount)
+{
+    if (!configuration->isControlSystemTypeStaged)
+    {
+        return true;
+    }
+    
+    if ( (HeaterTemperatureController_getSystemType() != configuration->controlSystemType) && !HeaterTemperatureController_setSystemType(configuration->controlSystemType) )
+    {
+        return false;
+    }
+    
+    ++(*appliedChangesCount);
+    return true;
+}
+
+bool isLMP90100ModeValid(ELMP90100Mode mode)
+{
+    return ELMP90100Mode_On_214_65_SPS >= mode;
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "ConfigurationBatch";
+}
+
+#undef CONFIGURATION_BATCH_STEPS_COUNT
+#undef CONFIGURATION_BATCH_PIDS_COUNT
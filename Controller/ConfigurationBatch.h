@@ -0,0 +1,29 @@
+#ifndef _CONFIGURATION_BATCH_H_
+
+#define _CONFIGURATION_BATCH_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/ADS1248Types.h"
+#include "SharedDefines/LMP90100Types.h"
+#include "SharedDefines/EControlSystemType.h"
+#include "SharedDefines/EPid.h"
+#include "SharedDefines/SPidTunes.h"
+#include "stdbool.h"
+
+void ConfigurationBatch_setup(void);
+
+bool ConfigurationBatch_begin(void);
+bool ConfigurationBatch_isOpen(void);
+bool ConfigurationBatch_commit(u8* stagedChangesCount, u8* appliedChangesCount);
+bool ConfigurationBatch_abort(u8* discardedChangesCount);
+
+bool ConfigurationBatch_stageADS1248Mode(EADS1248Mode mode);
+bool ConfigurationBatch_stageADS1248Gain(EADS1248GainValue gainValue);
+bool ConfigurationBatch_stageADS1248SamplingSpeed(EADS1248SamplingSpeed samplingSpeed);
+bool ConfigurationBatch_stageLMP90100ControlSystemMode(ELMP90100Mode mode);
+bool ConfigurationBatch_stageLMP90100SignalsMeasurementMode(ELMP90100Mode mode);
+bool ConfigurationBatch_stageControlSystemType(EControlSystemType type);
+bool ConfigurationBatch_stageControllerTunes(EPid pid, SPidTunes* tunes);
+bool ConfigurationBatch_stageAlgorithmExecutionPeriod(u16 period);
+
+#endif
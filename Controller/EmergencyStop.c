@@ -0,0 +1,171 @@
+#include "Controller/EmergencyStop.h"
+#include "Controller/CommandScript.h"
+#include "Controller/HeaterTemperatureController.h"
+#include "Controller/ReferenceTemperatureController.h"
+#include "Controller/SegmentsManager.h"
+#include "Controller/SetPointTrajectory.h"
+
+#include "Devices/MCP4716.h"
+#include "Peripherals/TIM2.h"
+
+#include "Utilities/Logger/Logger.h"
+
+#include "cmsis_os.h"
+
+// Out-of-band stop path. The UART ISR shuts DRV595 down and latches it off on the spot, then signals a realtime
+// thread, which zeroes and latches the MCP4716 output as soon as the I2C bus is free. Only then are the controller,
+// the segments program and the trajectory stopped, so a blocked request handler cannot delay the outputs.
+// Neither the event queues nor the request workers are involved.
+
+#define EMERGENCY_STOP_SIGNAL 0x01
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+static osThreadId mExecutorThreadId = NULL;
+
+static volatile bool mIsActive = false;
+static volatile u32 mTriggerTimestamp = 0;
+static volatile u32 mPeltierStopTimestamp = 0;
+static volatile bool mWasReferenceStabilizationActive = false;
+static void (*mStopDoneIndCallback)(SEmergencyStopReport*) = NULL;
+
+static void emergencyStopExecutor(void const* arg);
+static void executeEmergencyStop(void);
+static const char* getLoggerPrefix(void);
+
+void EmergencyStop_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+    osThreadDef(emergencyStopThread, emergencyStopExecutor, osPriorityRealtime, 0, configMINIMAL_STACK_SIZE);
+    mExecutorThreadId = osThreadCreate(osThread(emergencyStopThread), NULL);
+}
+
+void EmergencyStop_triggerFromISR(void)
+{
+    mTriggerTimestamp = TIM2_getMicroseconds();
+    
+    bool wasReferenceStabilizationActive = ReferenceTemperatureController_shutdownImmediately();
+    mPeltierStopTimestamp = TIM2_getMicroseconds();
+    
+    // A repeated stop frame must not hide that the first one found stabilization running.
+    if (!mIsActive)
+    {
+        mWasReferenceStabilizationActive = wasReferenceStabilizationActive;
+    }
+    
+    mIsActive = true;
+    osSignalSet(mExecutorThreadId, EMERGENCY_STOP_SIGNAL);
+}
+
+bool EmergencyStop_isActive(void)
+{
+    return mIsActive;
+}
+
+bool EmergencyStop_clear(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = mIsActive;
+    if (result)
+    {
+        MCP4716_unlockOutput();
+        ReferenceTemperatureController_unlockStabilization();
+        mIsActive = false;
+        Logger_warning("%s: Emergency stop cleared. Outputs unlocked, they stay off until restarted.", getLoggerPrefix());
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void EmergencyStop_registerStopDoneIndCallback(void (*callback)(SEmergencyStopReport*))
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mStopDoneIndCallback = callback;
+    osMutexRelease(mMutexId);
+}
+
+void EmergencyStop_deregisterStopDoneIndCallback(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mStopDoneIndCallback = NULL;
+    osMutexRelease(mMutexId);
+}
+
+void emergencyStopExecutor(void const* arg)
+{
+    while (true)
+    {
+        osEvent signal = osSignalWait(EMERGENCY_STOP_SIGNAL, osWaitForever);
+        if (osEventSignal == signal.status)
+        {
+            executeEmergencyStop();
+        }
+    }
+}
+
+void executeEmergencyStop(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    SEmergencyStopReport report;
+    
+    report.triggerTimestamp = mTriggerTimestamp;
+    report.peltierStopTime = mPeltierStopTimestamp - mTriggerTimestamp;
+    report.wasReferenceStabilizationActive = mWasReferenceStabilizationActive;
+    report.heaterOutputValue = 0;
+    report.success = MCP4716_lockOutputAtZero(&(report.heaterOutputValue));
+    report.heaterStopTime = TIM2_getMicroseconds() - mTriggerTimestamp;
+    
+    // Script checks the active flag before every instruction, stopping it only cuts a pending wait short.
+    CommandScript_stop();
+    
+    report.wasTrajectoryRunning = SetPointTrajectory_isRunning();
+    if (report.wasTrajectoryRunning)
+    {
+        u32 underrunsCount;
+        SetPointTrajectory_stop(&underrunsCount);
+    }
+    
+    bool isProgramRunning = false;
+    u16 currentSegmentNumber;
+    u16 registeredSegmentsCount;
+    u32 timestamp;
+    SegmentsManager_readProgramStatusSnapshot(&isProgramRunning, &currentSegmentNumber, &registeredSegmentsCount, &timestamp);
+    report.wasSegmentsProgramRunning = isProgramRunning;
+    if (report.wasSegmentsProgramRunning)
+    {
+        SegmentsManager_stopProgram();
+    }
+    
+    report.wasControllerRunning = HeaterTemperatureController_isRunning();
+    if (report.wasControllerRunning)
+    {
+        report.success = HeaterTemperatureController_stop() && report.success;
+    }
+    
+    Logger_error
+    (
+        "%s: Emergency stop! Peltier off after %u us, heater off after %u us (Previous output: %u).",
+        getLoggerPrefix(),
+        report.peltierStopTime,
+        report.heaterStopTime,
+        report.heaterOutputValue
+    );
+    
+    if (mStopDoneIndCallback)
+    {
+        (*mStopDoneIndCallback)(&report);
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "EmergencyStop";
+}
+
+#undef EMERGENCY_STOP_SIGNAL
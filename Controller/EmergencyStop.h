@@ -0,0 +1,18 @@
+#ifndef _EMERGENCY_STOP_H_
+
+#define _EMERGENCY_STOP_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/SEmergencyStopReport.h"
+#include "stdbool.h"
+
+void EmergencyStop_setup(void);
+
+void EmergencyStop_triggerFromISR(void);
+bool EmergencyStop_isActive(void);
+bool EmergencyStop_clear(void);
+
+void EmergencyStop_registerStopDoneIndCallback(void (*callback)(SEmergencyStopReport*));
+void EmergencyStop_deregisterStopDoneIndCallback(void);
+
+#endif
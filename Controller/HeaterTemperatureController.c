@@ -2,10 +2,13 @@
 
 #include "Controller/HeaterTemperatureReader.h"
 #include "Devices/MCP4716.h"
+#include "Peripherals/TIM2.h"
 #include "FaultManagement/FaultIndication.h"
+#include "System/TelemetryScheduler.h"
 #include "Utilities/Printer/CStringConverter.h"
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/CopyObject.h"
+#include "Utilities/Snapshot.h"
 
 #include "arm_math.h"
 #include "cmsis_os.h"
@@ -14,7 +17,6 @@
 #define MAX_HEATER_POWER_F  70.0
 
 static osTimerId mControllerAlgorithmTimerId = NULL;
-static osTimerId mNewControllerDataCallbackTimerId = NULL;
 static osTimerId mTemperatureControllerTimerId = NULL;
 static osMutexDef(mMutex);
 static osMutexId mMutexId = NULL;
@@ -31,20 +33,22 @@ static float mTemperatureSetPoint = 0.0F;
 static u16 mHeaterControlValue = 0.0F;
 static float mTemperatureDeviation = 0.0F;
 static SControllerData mControllerData;
-static bool mIsControllerDataCallbackCallingEnabled = false;
+static u32 mControllerDataTimestamp = 0;
+static SFloatSnapshot mControllerDataSnapshots [EControllerDataType_ERR + 1];
 static u16 mNewControllerDataCallbackExecutionPeriod = 0U;
 static double mIntState = 0.0;
 static double mFilterState = 0.0;
 static bool mIsDerivativeElementDisabled = false;
 
-static void (*mNewControllerDataCallback)(EControllerDataType, float) = NULL;
+static void (*mNewControllerDataCallback)(EControllerDataType, float, u32) = NULL;
+static bool (*mSetPointProvider)(u32, float*) = NULL;
 
 static void controllerAlgorithm(void const* arg);
-static void newControllerDataCallback(void const* arg);
+static void newControllerDataCallback(void);
 static bool startAlgorithmTimer(void);
 static bool stopAlgorithmTimer(void);
-static bool startNewControllerDataCallbackTimer(void);
-static bool stopNewControllerDataCallbackTimer(void);
+static bool scheduleControllerDataStream(void);
+static bool descheduleControllerDataStream(void);
 static bool restartAlgorithmTimer(void);
 static double setCVInPercentScope(double cvPercent);
 static u16 convertCVPercentToOutputValue(float cvPercent);
@@ -63,8 +67,6 @@ void HeaterTemperatureController_setup(void)
     mMutexId = osMutexCreate(osMutex(mMutex));
     osTimerDef(controllerAlgorithmTimer, controllerAlgorithm);
     mControllerAlgorithmTimerId = osTimerCreate(osTimer(controllerAlgorithmTimer), osTimerPeriodic, NULL);
-    osTimerDef(newControllerDataCallbackTimer, newControllerDataCallback);
-    mNewControllerDataCallbackTimerId = osTimerCreate(osTimer(newControllerDataCallbackTimer), osTimerPeriodic, NULL);
     osTimerDef(temperatureControllerTimer, temperatureController);
     mTemperatureControllerTimerId = osTimerCreate(osTimer(temperatureControllerTimer), osTimerPeriodic, NULL);
 }
@@ -235,6 +237,29 @@ bool HeaterTemperatureController_setTunes(EPid pid, SPidTunes* tunes)
     return result;
 }
 
+u16 HeaterTemperatureController_getAlgorithmExecutionPeriod(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    u16 period = mAlgorithmExecutionPeriod;
+    osMutexRelease(mMutexId);
+    return period;
+}
+
+EControlSystemType HeaterTemperatureController_getSystemType(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    EControlSystemType type = mControlSystemType;
+    osMutexRelease(mMutexId);
+    return type;
+}
+
+void HeaterTemperatureController_getTunes(EPid pid, SPidTunes* tunes)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    CopyObject_SPidTunes( (EPid_ModelController == pid) ? &mModelPidTunes : &mProcessPidTunes, tunes);
+    osMutexRelease(mMutexId);
+}
+
 void HeaterTemperatureController_resetPidStates(EPid pid)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -365,7 +390,25 @@ bool HeaterTemperatureController_stop(void)
     return result;
 }
 
-bool HeaterTemperatureController_registerNewControllerDataCallback(void (*callback)(EControllerDataType, float), u16 period)
+bool HeaterTemperatureController_isRunning(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    bool isRunning = mIsAlgorithmRunning;
+    osMutexRelease(mMutexId);
+    return isRunning;
+}
+
+bool HeaterTemperatureController_readControllerDataSnapshot(EControllerDataType type, float* value, u32* timestamp)
+{
+    if (EControllerDataType_ERR < type)
+    {
+        return false;
+    }
+    
+    return Snapshot_readFloat(&(mControllerDataSnapshots[type]), value, timestamp);
+}
+
+bool HeaterTemperatureController_registerNewControllerDataCallback(void (*callback)(EControllerDataType, float, u32), u16 period)
 {
     osMutexWait(mMutexId, osWaitForever);
     mNewControllerDataCallback = callback;
@@ -375,7 +418,7 @@ bool HeaterTemperatureController_registerNewControllerDataCallback(void (*callba
     
     if (mIsAlgorithmRunning)
     {
-        result = startNewControllerDataCallbackTimer();
+        result = scheduleControllerDataStream();
     }
     
     osMutexRelease(mMutexId);
@@ -392,7 +435,7 @@ bool HeaterTemperatureController_deregisterNewControllerDataCallback(void)
     
     if (mIsAlgorithmRunning)
     {
-        result = stopNewControllerDataCallbackTimer();
+        result = descheduleControllerDataStream();
     }
     
     osMutexRelease(mMutexId);
@@ -401,10 +444,35 @@ bool HeaterTemperatureController_deregisterNewControllerDataCallback(void)
     return result;
 }
 
+void HeaterTemperatureController_registerSetPointProvider(bool (*provider)(u32, float*))
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mSetPointProvider = provider;
+    osMutexRelease(mMutexId);
+    Logger_debug("%s: Set point provider registered.", getLoggerPrefix());
+}
+
+void HeaterTemperatureController_deregisterSetPointProvider(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mSetPointProvider = NULL;
+    osMutexRelease(mMutexId);
+    Logger_debug("%s: Set point provider deregistered.", getLoggerPrefix());
+}
+
 void controllerAlgorithm(void const* arg)
 {
     osMutexWait(mMutexId, osWaitForever);
     
+    mControllerDataTimestamp = TIM2_getMicroseconds();
+    
+    // Provider refusing to give a set point requests safe state: heater is switched off for this period.
+    bool isSafeStateRequested = false;
+    if (mSetPointProvider)
+    {
+        isSafeStateRequested = !(*mSetPointProvider)(mControllerDataTimestamp, &mTemperatureSetPoint);
+    }
+    
     mControllerData.SP = mTemperatureSetPoint;
     mControllerData.PV = HeaterTemperatureReader_getTemperature();
     mControllerData.ERR = mControllerData.SP - mControllerData.PV;
@@ -416,6 +484,11 @@ void controllerAlgorithm(void const* arg)
     //}
     //else
     
+    if (isSafeStateRequested)
+    {
+        mControllerData.CV = 0.0F;
+    }
+    else
     {
         double u = mControllerData.ERR;
         double filterCoefficient = 0.0;
@@ -438,6 +511,11 @@ void controllerAlgorithm(void const* arg)
         mControllerData.CV = setCVInPercentScope(calculatedCV);
     }*/
     
+    Snapshot_writeFloat(&(mControllerDataSnapshots[EControllerDataType_SP]), mControllerData.SP, mControllerDataTimestamp);
+    Snapshot_writeFloat(&(mControllerDataSnapshots[EControllerDataType_CV]), (float)(mControllerData.CV), mControllerDataTimestamp);
+    Snapshot_writeFloat(&(mControllerDataSnapshots[EControllerDataType_PV]), mControllerData.PV, mControllerDataTimestamp);
+    Snapshot_writeFloat(&(mControllerDataSnapshots[EControllerDataType_ERR]), mControllerData.ERR, mControllerDataTimestamp);
+    
     if (setPowerInPercent(mControllerData.CV))
     {
         mHeaterControlValue = mControllerData.CV;
@@ -450,16 +528,16 @@ void controllerAlgorithm(void const* arg)
     osMutexRelease(mMutexId);
 }
 
-void newControllerDataCallback(void const* arg)
+void newControllerDataCallback(void)
 {
     osMutexWait(mMutexId, osWaitForever);
     
     if (mNewControllerDataCallback)
     {
-        (*mNewControllerDataCallback)(EControllerDataType_SP, mControllerData.SP);
-        (*mNewControllerDataCallback)(EControllerDataType_CV, (float)(mControllerData.CV));
-        (*mNewControllerDataCallback)(EControllerDataType_PV, mControllerData.PV);
-        (*mNewControllerDataCallback)(EControllerDataType_ERR, mControllerData.ERR);
+        (*mNewControllerDataCallback)(EControllerDataType_SP, mControllerData.SP, mControllerDataTimestamp);
+        (*mNewControllerDataCallback)(EControllerDataType_CV, (float)(mControllerData.CV), mControllerDataTimestamp);
+        (*mNewControllerDataCallback)(EControllerDataType_PV, mControllerData.PV, mControllerDataTimestamp);
+        (*mNewControllerDataCallback)(EControllerDataType_ERR, mControllerData.ERR, mControllerDataTimestamp);
     }
     
     osMutexRelease(mMutexId);
@@ -480,7 +558,7 @@ bool startAlgorithmTimer(void)
         {
             mIsAlgorithmRunning = true;
             Logger_info("%s: Forcing algorithm state to RUN done (Period: %u ms). Heater temperature is now controlled.", getLoggerPrefix(), mAlgorithmExecutionPeriod);
-            return startNewControllerDataCallbackTimer();
+            return scheduleControllerDataStream();
         }
         else
         {
@@ -507,7 +585,7 @@ bool stopAlgorithmTimer(void)
             mIsAlgorithmRunning = false;
             Logger_info("%s: Forcing algorithm state to IDLE done. Heater temperature is not controlled now.", getLoggerPrefix());
             setPower(0);
-            return stopNewControllerDataCallbackTimer();
+            return descheduleControllerDataStream();
         }
         else
         {
@@ -519,48 +597,31 @@ bool stopAlgorithmTimer(void)
     }
 }
 
-bool startNewControllerDataCallbackTimer(void)
+bool scheduleControllerDataStream(void)
 {
-    if (!mIsControllerDataCallbackCallingEnabled)
+    if (NULL == mNewControllerDataCallback)
     {
-        osStatus osResult = osTimerStart(mNewControllerDataCallbackTimerId, mNewControllerDataCallbackExecutionPeriod);
-        if (osOK != osResult)
-        {
-            Logger_error("%s: Forcing callback calling state to ENABLED failed.", getLoggerPrefix());
-            Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
-            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
-            return false;
-        }
-        else
-        {
-            mIsControllerDataCallbackCallingEnabled = true;
-            return true;
-        }
+        return true;
     }
     
-    return true;
+    bool result = TelemetryScheduler_registerStream(ETelemetryStream_ControllerData, newControllerDataCallback, mNewControllerDataCallbackExecutionPeriod);
+    if (!result)
+    {
+        Logger_error("%s: Forcing callback calling state to ENABLED failed.", getLoggerPrefix());
+    }
+    
+    return result;
 }
 
-bool stopNewControllerDataCallbackTimer(void)
+bool descheduleControllerDataStream(void)
 {
-    if (mIsControllerDataCallbackCallingEnabled)
+    bool result = TelemetryScheduler_deregisterStream(ETelemetryStream_ControllerData);
+    if (!result)
     {
-        osStatus osResult = osTimerStop(mNewControllerDataCallbackTimerId);
-        if (osOK != osResult)
-        {
-            Logger_error("%s: Forcing callback calling state to DISABLED failed.", getLoggerPrefix());
-            Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
-            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
-            return false;
-        }
-        else
-        {
-            mIsControllerDataCallbackCallingEnabled = false;
-            return true;
-        }
+        Logger_error("%s: Forcing callback calling state to DISABLED failed.", getLoggerPrefix());
     }
     
-    return true;
+    return result;
 }
 
 bool restartAlgorithmTimer(void)
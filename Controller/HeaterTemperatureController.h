@@ -18,6 +18,9 @@ bool HeaterTemperatureController_setAlgorithmExecutionPeriod(u16 period);
 bool HeaterTemperatureController_setProcessModelParameters(SProcessModelParameters* parameters);
 bool HeaterTemperatureController_setSystemType(EControlSystemType type);
 bool HeaterTemperatureController_setTunes(EPid pid, SPidTunes* tunes);
+u16 HeaterTemperatureController_getAlgorithmExecutionPeriod(void);
+EControlSystemType HeaterTemperatureController_getSystemType(void);
+void HeaterTemperatureController_getTunes(EPid pid, SPidTunes* tunes);
 void HeaterTemperatureController_resetPidStates(EPid pid);
 void HeaterTemperatureController_enableDerivativeElement(EPid pid);
 void HeaterTemperatureController_disableDerivativeElement(EPid pid);
@@ -27,11 +30,16 @@ bool HeaterTemperatureController_setPowerInPercent(float power);
 bool HeaterTemperatureController_setTemperature(float temperature);
 
 float HeaterTemperatureController_getControllerError(void);
+bool HeaterTemperatureController_readControllerDataSnapshot(EControllerDataType type, float* value, u32* timestamp);
 
 bool HeaterTemperatureController_start(void);
 bool HeaterTemperatureController_stop(void);
+bool HeaterTemperatureController_isRunning(void);
 
-bool HeaterTemperatureController_registerNewControllerDataCallback(void (*callback)(EControllerDataType, float), u16 period);
+bool HeaterTemperatureController_registerNewControllerDataCallback(void (*callback)(EControllerDataType, float, u32), u16 period);
 bool HeaterTemperatureController_deregisterNewControllerDataCallback(void);
 
+void HeaterTemperatureController_registerSetPointProvider(bool (*provider)(u32, float*));
+void HeaterTemperatureController_deregisterSetPointProvider(void);
+
 #endif
@@ -1,4 +1,5 @@
 #include "Controller/HeaterTemperatureReader.h"
+#include "Controller/SampleRecorder.h"
 
 #include "Defines/CommonDefines.h"
 
@@ -6,9 +7,11 @@
 
 #include "FaultManagement/FaultIndication.h"
 #include "System/ThreadMacros.h"
+#include "System/TelemetryScheduler.h"
 
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
+#include "Utilities/Snapshot.h"
 
 #include "arm_math.h"
 
@@ -16,15 +19,12 @@ THREAD_DEFINES(HeaterTemperatureReader, HeaterTemperatureReader)
 EVENT_HANDLER_PROTOTYPE(NewRTDValueInd)
 
 static float mTemperature = 0.0F;
-static void (*mNewTemperatureValueCallback)(float) = NULL;
-static u16 mIndCallbackPeriod = 0U;
-static osTimerId mIndCallbackTimerId = NULL;
-static bool mIsTimerStarted = false;
+static u32 mTemperatureTimestamp = 0;
+static SFloatSnapshot mTemperatureSnapshot;
+static void (*mNewTemperatureValueCallback)(float, u32) = NULL;
 
 static float convertRTDResistanceToTemperature(float sensorData);
-static void indCallback(const void* arg);
-static bool startIndCallbackTimer(void);
-static bool stopIndCallbackTimer(void);
+static void indCallback(void);
 
 THREAD(HeaterTemperatureReader)
 {
@@ -41,15 +41,15 @@ EVENT_HANDLER(NewRTDValueInd)
     
     Logger_debug("%s: New RTD value received! Value: %.4f Ohm.", getLoggerPrefix(), event->value);
     mTemperature = convertRTDResistanceToTemperature(event->value);
+    mTemperatureTimestamp = event->timestamp;
+    Snapshot_writeFloat(&mTemperatureSnapshot, mTemperature, mTemperatureTimestamp);
+    SampleRecorder_record(EUnitId_RtdPt1000, mTemperature, mTemperatureTimestamp);
     Logger_debug("%s: Temperature: %f oC.", getLoggerPrefix(), mTemperature);
 }
 
 void HeaterTemperatureReader_setup(void)
 {
     THREAD_INITIALIZE_MUTEX
-    
-    osTimerDef(indCallbackTimer, indCallback);
-    mIndCallbackTimerId = osTimerCreate(osTimer(indCallbackTimer), osTimerPeriodic, NULL);
 }
 
 void HeaterTemperatureReader_initialize(void)
@@ -70,19 +70,16 @@ float HeaterTemperatureReader_getTemperature(void)
     return temperature;
 }
 
-bool HeaterTemperatureReader_registerNewTemperatureValueCallback(void (*newTemperatureValueCallback)(float), u16 period)
+bool HeaterTemperatureReader_readTemperatureSnapshot(float* temperature, u32* timestamp)
+{
+    return Snapshot_readFloat(&mTemperatureSnapshot, temperature, timestamp);
+}
+
+bool HeaterTemperatureReader_registerNewTemperatureValueCallback(void (*newTemperatureValueCallback)(float, u32), u16 period)
 {
     osMutexWait(mMutexId, osWaitForever);
     mNewTemperatureValueCallback = newTemperatureValueCallback;
-    mIndCallbackPeriod = period;
-    
-    bool result = true;
-    
-    if (!mIsTimerStarted)
-    {
-        result = startIndCallbackTimer();
-    }
-    
+    bool result = TelemetryScheduler_registerStream(ETelemetryStream_HeaterTemperature, indCallback, period);
     osMutexRelease(mMutexId);
     Logger_debug("%s: Registered callback for new RTD temperature value.", getLoggerPrefix());
     
@@ -93,13 +90,7 @@ bool HeaterTemperatureReader_deregisterNewTemperatureValueCallback(void)
 {
     osMutexWait(mMutexId, osWaitForever);
     mNewTemperatureValueCallback = NULL;
-    
-    bool result = true;
-    if (mIsTimerStarted)
-    {
-        result = stopIndCallbackTimer();
-    }
-    
+    bool result = TelemetryScheduler_deregisterStream(ETelemetryStream_HeaterTemperature);
     osMutexRelease(mMutexId);
     Logger_debug("%s: Deregistered callback for new RTD temperature value.", getLoggerPrefix());
     
@@ -144,58 +135,14 @@ float convertRTDResistanceToTemperature(float resistance)
     return ( (z1 + sqrtVal) / (z4) );
 }
 
-void indCallback(const void* arg)
+void indCallback(void)
 {
     osMutexWait(mMutexId, osWaitForever);
     
     if (mNewTemperatureValueCallback)
     {
-        (*mNewTemperatureValueCallback)(mTemperature);
+        (*mNewTemperatureValueCallback)(mTemperature, mTemperatureTimestamp);
     }
     
     osMutexRelease(mMutexId);
 }
-
-bool startIndCallbackTimer(void)
-{
-    if (!mIsTimerStarted)
-    {
-        osStatus osResult = osTimerStart(mIndCallbackTimerId, mIndCallbackPeriod);
-        if (osOK != osResult)
-        {
-            Logger_error("%s: Forcing callback calling state to ENABLED failed.", getLoggerPrefix());
-            Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
-            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
-            return false;
-        }
-        else
-        {
-            mIsTimerStarted = true;
-            return true;
-        }
-    }
-    
-    return true;
-}
-
-bool stopIndCallbackTimer(void)
-{
-    if (mIsTimerStarted)
-    {
-        osStatus osResult = osTimerStop(mIndCallbackTimerId);
-        if (osOK != osResult)
-        {
-            Logger_error("%s: Forcing callback calling state to ENABLED failed.", getLoggerPrefix());
-            Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
-            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
-            return false;
-        }
-        else
-        {
-            mIsTimerStarted = false;
-            return true;
-        }
-    }
-    
-    return true;
-}
@@ -10,7 +10,8 @@ THREAD_PROTOTYPE(HeaterTemperatureReader)
 void HeaterTemperatureReader_setup(void);
 void HeaterTemperatureReader_initialize(void);
 float HeaterTemperatureReader_getTemperature(void);
-bool HeaterTemperatureReader_registerNewTemperatureValueCallback(void (*newTemperatureValueCallback)(float), u16 period);
+bool HeaterTemperatureReader_readTemperatureSnapshot(float* temperature, u32* timestamp);
+bool HeaterTemperatureReader_registerNewTemperatureValueCallback(void (*newTemperatureValueCallback)(float, u32), u16 period);
 bool HeaterTemperatureReader_deregisterNewTemperatureValueCallback(void);
 
 #endif
@@ -14,6 +14,7 @@ static osMutexDef(mMutex);
 static osMutexId mMutexId = NULL;
 
 static void (*mDRV595UnitFaultyCallback)(void) = NULL;
+static volatile bool mIsStabilizationLocked = false;
 
 static bool checkIfDRV595UnitNotFaulty(void);
 static void initializeGpio(void);
@@ -40,7 +41,24 @@ bool ReferenceTemperatureController_startStabilization(void)
 {
     osMutexWait(mMutexId, osWaitForever);
     Logger_debug("%s: Starting stabilization reference temperature...", getLoggerPrefix());
-    startStabilization();
+    
+    // Latch is checked with interrupts off, so an emergency stop from the UART ISR cannot land between check and start.
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    bool isLocked = mIsStabilizationLocked;
+    if (!isLocked)
+    {
+        startStabilization();
+    }
+    __set_PRIMASK(primask);
+    
+    if (isLocked)
+    {
+        Logger_error("%s: Stabilization is locked by emergency stop. Reference temperature is not stabilized.", getLoggerPrefix());
+        osMutexRelease(mMutexId);
+        return false;
+    }
+    
     //bool result = checkIfDRV595UnitNotFaulty();
     bool result = true;
     if (result)
@@ -64,6 +82,23 @@ void ReferenceTemperatureController_stopStabilization(void)
     osMutexRelease(mMutexId);
 }
 
+bool ReferenceTemperatureController_shutdownImmediately(void)
+{
+    // Called from UART ISR, so only the shutdown pin is touched: no mutex and no logging.
+    bool wasStabilizationActive = GPIO_IS_LOW_LEVEL(DRV595_SHUTDOWN_PORT, DRV595_SHUTDOWN_PIN);
+    mIsStabilizationLocked = true;
+    stopStabilization();
+    return wasStabilizationActive;
+}
+
+void ReferenceTemperatureController_unlockStabilization(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mIsStabilizationLocked = false;
+    osMutexRelease(mMutexId);
+    Logger_info("%s: Stabilization unlocked.", getLoggerPrefix());
+}
+
 void ReferenceTemperatureController_registerDRV595UnitFaultyCallback(void (*callback)(void))
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -8,6 +8,8 @@ void ReferenceTemperatureController_setup(void);
 void ReferenceTemperatureController_initialize(void);
 bool ReferenceTemperatureController_startStabilization(void);
 void ReferenceTemperatureController_stopStabilization(void);
+bool ReferenceTemperatureController_shutdownImmediately(void);
+void ReferenceTemperatureController_unlockStabilization(void);
 void ReferenceTemperatureController_registerDRV595UnitFaultyCallback(void (*callback)(void));
 void ReferenceTemperatureController_deregisterDRV595UnitFaultyCallback(void);
 
@@ -1,4 +1,5 @@
 #include "Controller/ReferenceTemperatureReader.h"
+#include "Controller/SampleRecorder.h"
 
 #include "Defines/CommonDefines.h"
 
@@ -8,6 +9,7 @@
 
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
+#include "Utilities/Snapshot.h"
 
 #include "arm_math.h"
 
@@ -15,13 +17,15 @@ THREAD_DEFINES(ReferenceTemperatureReader, ReferenceTemperatureReader)
 EVENT_HANDLER_PROTOTYPE(NewRTDValueInd)
 
 static float mRtdTemperature = 0.0F;
+static u32 mRtdTemperatureTimestamp = 0;
+static SFloatSnapshot mRtdTemperatureSnapshot;
 static float mRTDPolynomialCoefficients [3] =
     {
         -242.02,    /*R0*/
         2.2228,     /*R1*/
         2.5859E-3   /*R2*/
     };
-static void (*mDataReadyCallback)(float) = NULL;
+static void (*mDataReadyCallback)(float, u32) = NULL;
 
 static float convertRTDResistanceToTemperature(float resistance);
     
@@ -40,12 +44,15 @@ EVENT_HANDLER(NewRTDValueInd)
     
     Logger_debug("%s: New RTD value received: %.4f Ohm.", getLoggerPrefix(), event->value);
     mRtdTemperature = convertRTDResistanceToTemperature(event->value);
+    mRtdTemperatureTimestamp = event->timestamp;
+    Snapshot_writeFloat(&mRtdTemperatureSnapshot, mRtdTemperature, mRtdTemperatureTimestamp);
+    SampleRecorder_record(EUnitId_Rtd2Pt100, mRtdTemperature, mRtdTemperatureTimestamp);
     Logger_debug("%s: RTD temperature: %.4f oC.", getLoggerPrefix(), mRtdTemperature);
     
     if (mDataReadyCallback)
     {
         Logger_debug("%s: Callback for data ready registered. Processing with stored data...", getLoggerPrefix());
-        (*mDataReadyCallback)(mRtdTemperature);
+        (*mDataReadyCallback)(mRtdTemperature, mRtdTemperatureTimestamp);
     }
     else
     {
@@ -77,7 +84,12 @@ float ReferenceTemperatureReader_getTemperature(void)
     return rtdTemperature;
 }
 
-void ReferenceTemperatureReader_registerDataReadyCallback(void (*dataReadyCallback)(float))
+bool ReferenceTemperatureReader_readTemperatureSnapshot(float* temperature, u32* timestamp)
+{
+    return Snapshot_readFloat(&mRtdTemperatureSnapshot, temperature, timestamp);
+}
+
+void ReferenceTemperatureReader_registerDataReadyCallback(void (*dataReadyCallback)(float, u32))
 {
     osMutexWait(mMutexId, osWaitForever);
     mDataReadyCallback = dataReadyCallback;
@@ -3,13 +3,15 @@
 #define _REFERENCE_TEMPERATURE_READER_H_
 
 #include "System/ThreadMacros.h"
+#include "Defines/CommonDefines.h"
 
 THREAD_PROTOTYPE(ReferenceTemperatureReader)
 
 void ReferenceTemperatureReader_setup(void);
 void ReferenceTemperatureReader_initialize(void);
 float ReferenceTemperatureReader_getTemperature(void);
-void ReferenceTemperatureReader_registerDataReadyCallback(void (*dataReadyCallback)(float));
+bool ReferenceTemperatureReader_readTemperatureSnapshot(float* temperature, u32* timestamp);
+void ReferenceTemperatureReader_registerDataReadyCallback(void (*dataReadyCallback)(float, u32));
 void ReferenceTemperatureReader_deregisterDataReadyCallback(void);
 
 #endif
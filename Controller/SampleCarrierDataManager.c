@@ -1,4 +1,5 @@
 #include "Controller/SampleCarrierDataManager.h"
+#include "Controller/SampleRecorder.h"
 
 #include "Defines/CommonDefines.h"
 
@@ -9,6 +10,7 @@
 
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
+#include "Utilities/Snapshot.h"
 
 #include "arm_math.h"
 
@@ -16,7 +18,18 @@ THREAD_DEFINES(SampleCarrierDataManager, SampleCarrierDataManager)
 EVENT_HANDLER_PROTOTYPE(NewRTDValueInd)
 EVENT_HANDLER_PROTOTYPE(NewThermocoupleVoltageValueInd)
 
+#define SAMPLE_CARRIER_SNAPSHOTS_COUNT ( EUnitId_Thermocouple4 - EUnitId_RtdPt1000 + 1 )
+#define THERMOCOUPLE_OUTPUT_SCALE 10E6
+
+// In raw code mode the ADS1248 and RTD codes are forwarded untouched and Master converts them with the
+// descriptor sent on entering the mode and again whenever the thermocouple gain changes. The descriptor
+// is sent by this thread right before the first sample it describes, on the never dropping Responses
+// lane, which is served ahead of the samples. Every raw sample carries the configuration id, so samples
+// still queued under the previous descriptor are told apart. Snapshots and the sample recorder hold
+// converted values, they are not updated meanwhile.
+
 static SSampleCarrierData mSampleCarrierData;
+static SFloatSnapshot mSampleCarrierSnapshots [SAMPLE_CARRIER_SNAPSHOTS_COUNT];
 
 static SRTDPolynomialCoefficients mRTDPolynomialCoefficients =
     {
@@ -28,17 +41,32 @@ static SRTDPolynomialCoefficients mRTDPolynomialCoefficients =
         1.5243E-10  /*R5*/
     };
 static bool mThermocouplesDataReceived [THERMOCOUPLES_COUNT];
+static const float mRTDTemperatureCoefficients [RTD_TEMPERATURE_COEFFICIENTS_COUNT] =
+    {
+        -3.9083E-3,
+        17.58480889E-6,
+        -23.10E-9,
+        -1.155E-6
+    };
 static bool mRTDDataReceived = false;
 static void (*mDataReadyCallback)(SSampleCarrierData*) = NULL;
+static ESampleStreamFormat mStreamFormat = ESampleStreamFormat_Converted;
+static SSampleCarrierConversionDescriptor mConversionDescriptor;
+static bool mIsConversionDescriptorPending = false;
+static void (*mRawDataReadyCallback)(EUnitId, u32, u8, u32) = NULL;
+static void (*mConversionDescriptorCallback)(SSampleCarrierConversionDescriptor*) = NULL;
 
 static void processIfSampleCarrierDataIsReady(void);
 //static bool isSampleCarrierDataReady(void);
-static void storeReceivedThermocoupleData(EUnitId thermocouple, double data);
-static void storeReceivedRTDData(double data);
+static void storeReceivedThermocoupleData(EUnitId thermocouple, double data, u32 timestamp);
+static void storeReceivedRTDData(double data, u32 timestamp);
 static void copySampleCarrierData(SSampleCarrierData* source, SSampleCarrierData* destination);
+static void publishSampleCarrierSnapshot(void);
 static void cleanUpDataReceivedVariables(void);
 static double convertRTDResistanceToTemperature(double resistance);
 static double convertThermocoupleVoltageValueToMicrovolts(double valueInVolts);
+static void publishConversionDescriptor(void);
+static void notifyRawDataReady(EUnitId unitId, u32 code, u32 timestamp);
 
 THREAD(SampleCarrierDataManager)
 {
@@ -54,24 +82,44 @@ EVENT_HANDLER(NewRTDValueInd)
 {
     EVENT_MESSAGE(NewRTDValueInd)
     
-    Logger_debug("%s: Received new RTD (Pt100) value: %.4f Ohm.", getLoggerPrefix(), event->value);
-    
-    double rtdTemperature = convertRTDResistanceToTemperature(event->value);
-    Logger_debug("%s: RTD temperature: %.4f oC. Storing data.", getLoggerPrefix(), rtdTemperature);
-    storeReceivedRTDData(rtdTemperature);
-    processIfSampleCarrierDataIsReady();
+    if (ESampleStreamFormat_RawCode == mStreamFormat)
+    {
+        notifyRawDataReady(EUnitId_Rtd1Pt100, event->code, event->timestamp);
+    }
+    else
+    {
+        Logger_debug("%s: Received new RTD (Pt100) value: %.4f Ohm.", getLoggerPrefix(), event->value);
+        
+        double rtdTemperature = convertRTDResistanceToTemperature(event->value);
+        Logger_debug("%s: RTD temperature: %.4f oC. Storing data.", getLoggerPrefix(), rtdTemperature);
+        storeReceivedRTDData(rtdTemperature, event->timestamp);
+        processIfSampleCarrierDataIsReady();
+    }
 }
 
 EVENT_HANDLER(NewThermocoupleVoltageValueInd)
 {
     EVENT_MESSAGE(NewThermocoupleVoltageValueInd)
     
-    Logger_debug("%s: Received new %s value: %.6f V.", getLoggerPrefix(), CStringConverter_EUnitId(event->thermocouple), event->value);
-    
-    double thermocoupleMicroVoltValue = convertThermocoupleVoltageValueToMicrovolts(event->value);
-    Logger_debug("%s: %s value: %.5f uV. Storing data.", getLoggerPrefix(), CStringConverter_EUnitId(event->thermocouple), thermocoupleMicroVoltValue);
-    storeReceivedThermocoupleData(event->thermocouple, thermocoupleMicroVoltValue);
-    processIfSampleCarrierDataIsReady();
+    if (ESampleStreamFormat_RawCode == mStreamFormat)
+    {
+        if (event->gain != mConversionDescriptor.thermocoupleGain)
+        {
+            mConversionDescriptor.thermocoupleGain = event->gain;
+            mIsConversionDescriptorPending = true;
+        }
+        
+        notifyRawDataReady(event->thermocouple, event->code, event->timestamp);
+    }
+    else
+    {
+        Logger_debug("%s: Received new %s value: %.6f V.", getLoggerPrefix(), CStringConverter_EUnitId(event->thermocouple), event->value);
+        
+        double thermocoupleMicroVoltValue = convertThermocoupleVoltageValueToMicrovolts(event->value);
+        Logger_debug("%s: %s value: %.5f uV. Storing data.", getLoggerPrefix(), CStringConverter_EUnitId(event->thermocouple), thermocoupleMicroVoltValue);
+        storeReceivedThermocoupleData(event->thermocouple, thermocoupleMicroVoltValue, event->timestamp);
+        processIfSampleCarrierDataIsReady();
+    }
 }
 
 void SampleCarrierDataManager_setup(void)
@@ -101,6 +149,16 @@ void SampleCarrierDataManager_getData(SSampleCarrierData* data)
     osMutexRelease(mMutexId);
 }
 
+bool SampleCarrierDataManager_readSnapshot(EUnitId unitId, float* value, u32* timestamp)
+{
+    if ( (EUnitId_RtdPt1000 > unitId) || (EUnitId_Thermocouple4 < unitId) )
+    {
+        return false;
+    }
+    
+    return Snapshot_readFloat(&(mSampleCarrierSnapshots[unitId - EUnitId_RtdPt1000]), value, timestamp);
+}
+
 void SampleCarrierManager_setRTDPolynomialCoefficients(SRTDPolynomialCoefficients* coefficients)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -127,6 +185,90 @@ void SampleCarrierDataManager_deregisterDataReadyCallback(void)
     osMutexRelease(mMutexId);
 }
 
+bool SampleCarrierDataManager_setStreamFormat(ESampleStreamFormat format)
+{
+    if (ESampleStreamFormat_Count <= format)
+    {
+        Logger_warning("%s: Unknown stream format %u.", getLoggerPrefix(), format);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (format != mStreamFormat)
+    {
+        mStreamFormat = format;
+        ADS1248_setVoltageConversionEnabled(ESampleStreamFormat_Converted == format);
+        
+        if (ESampleStreamFormat_RawCode == format)
+        {
+            mConversionDescriptor.thermocoupleReferenceVoltage = (float) ADS1248_REFERENCE_VOLTAGE;
+            mConversionDescriptor.thermocoupleGain = ADS1248_getChannelGainValue();
+            mConversionDescriptor.thermocouplePositiveFullScaleCode = ADS1248_POSITIVE_FULL_SCALE_CODE;
+            mConversionDescriptor.thermocoupleOutputScale = (float) THERMOCOUPLE_OUTPUT_SCALE;
+            mConversionDescriptor.isThermocoupleReferenceClamped = true;
+            LMP90100SignalsMeasurement_getRTD1ConversionParameters
+            (
+                &(mConversionDescriptor.rtdReferenceResistance),
+                &(mConversionDescriptor.rtdGain),
+                &(mConversionDescriptor.rtdComparatorResistance)
+            );
+            mConversionDescriptor.rtdFullScaleCode = LMP90100_FULL_SCALE_CODE;
+            for (u8 iter = 0; RTD_TEMPERATURE_COEFFICIENTS_COUNT > iter; ++iter)
+            {
+                mConversionDescriptor.rtdTemperatureCoefficients[iter] = mRTDTemperatureCoefficients[iter];
+            }
+        }
+        
+        // Sent by the sample thread right before the first raw sample, not from the requesting worker.
+        mIsConversionDescriptorPending = ( ESampleStreamFormat_RawCode == format );
+        
+        Logger_info("%s: Stream format changed to %s.", getLoggerPrefix(), CStringConverter_ESampleStreamFormat(format));
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return true;
+}
+
+ESampleStreamFormat SampleCarrierDataManager_getStreamFormat(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    ESampleStreamFormat format = mStreamFormat;
+    osMutexRelease(mMutexId);
+    return format;
+}
+
+void SampleCarrierDataManager_registerRawDataReadyCallback(void (*rawDataReadyCallback)(EUnitId, u32, u8, u32))
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mRawDataReadyCallback = rawDataReadyCallback;
+    Logger_debug("%s: Raw data ready callback registered.", getLoggerPrefix());
+    osMutexRelease(mMutexId);
+}
+
+void SampleCarrierDataManager_deregisterRawDataReadyCallback(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mRawDataReadyCallback = NULL;
+    Logger_debug("%s: Raw data ready callback deregistered.", getLoggerPrefix());
+    osMutexRelease(mMutexId);
+}
+
+void SampleCarrierDataManager_registerConversionDescriptorCallback(void (*conversionDescriptorCallback)(SSampleCarrierConversionDescriptor*))
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mConversionDescriptorCallback = conversionDescriptorCallback;
+    osMutexRelease(mMutexId);
+}
+
+void SampleCarrierDataManager_deregisterConversionDescriptorCallback(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mConversionDescriptorCallback = NULL;
+    osMutexRelease(mMutexId);
+}
+
 void processIfSampleCarrierDataIsReady(void)
 {
     //if (isSampleCarrierDataReady())
@@ -167,7 +309,7 @@ bool isSampleCarrierDataReady(void)
     return true;
 }*/
 
-void storeReceivedThermocoupleData(EUnitId thermocouple, double data)
+void storeReceivedThermocoupleData(EUnitId thermocouple, double data, u32 timestamp)
 {
     /*
     switch (thermocouple)
@@ -212,14 +354,18 @@ void storeReceivedThermocoupleData(EUnitId thermocouple, double data)
     }*/
     mSampleCarrierData.unitId = thermocouple;
     mSampleCarrierData.value = data;
+    mSampleCarrierData.timestamp = timestamp;
+    publishSampleCarrierSnapshot();
 }
 
-void storeReceivedRTDData(double data)
+void storeReceivedRTDData(double data, u32 timestamp)
 {
     //mSampleCarrierData.rtdTemperatureValue = data;
     mSampleCarrierData.unitId = EUnitId_Rtd1Pt100;
     mSampleCarrierData.value = data;
+    mSampleCarrierData.timestamp = timestamp;
     mRTDDataReceived = true;
+    publishSampleCarrierSnapshot();
 }
 
 void copySampleCarrierData(SSampleCarrierData* source, SSampleCarrierData* destination)
@@ -233,6 +379,16 @@ void copySampleCarrierData(SSampleCarrierData* source, SSampleCarrierData* desti
     destination->refThermocoupleValue = source->refThermocoupleValue;*/
     destination->unitId = source->unitId;
     destination->value = source->value;
+    destination->timestamp = source->timestamp;
+}
+
+void publishSampleCarrierSnapshot(void)
+{
+    if ( (EUnitId_RtdPt1000 <= mSampleCarrierData.unitId) && (EUnitId_Thermocouple4 >= mSampleCarrierData.unitId) )
+    {
+        Snapshot_writeFloat(&(mSampleCarrierSnapshots[mSampleCarrierData.unitId - EUnitId_RtdPt1000]), mSampleCarrierData.value, mSampleCarrierData.timestamp);
+        SampleRecorder_record(mSampleCarrierData.unitId, mSampleCarrierData.value, mSampleCarrierData.timestamp);
+    }
 }
 
 void cleanUpDataReceivedVariables(void)
@@ -259,10 +415,10 @@ double convertRTDResistanceToTemperature(double resistance)
     //arm_sqrt_f32(R0 * R0 * + 3.9083E-3 * 3.9083E-3 - 4 * R0 * -5.775E-7 * (R0 - resistance), &sqrtVal);
     //return ((-R0 * 3.9083E-3 + sqrtVal) / (2 * R0 * -5.775E-7));
     
-    const float z1 = -3.9083E-3;
-    const float z2 = 17.58480889E-6;
-    const float z3 = -23.10E-9;
-    const float z4 = -1.155E-6;
+    const float z1 = mRTDTemperatureCoefficients[0];
+    const float z2 = mRTDTemperatureCoefficients[1];
+    const float z3 = mRTDTemperatureCoefficients[2];
+    const float z4 = mRTDTemperatureCoefficients[3];
     
     float sqrtVal = 0.0F;
     arm_sqrt_f32(z2 + z3 * resistance, &sqrtVal);
@@ -270,5 +426,40 @@ double convertRTDResistanceToTemperature(double resistance)
 }
 double convertThermocoupleVoltageValueToMicrovolts(double valueInVolts)
 {
-    return (valueInVolts * 10E6);
+    return (valueInVolts * THERMOCOUPLE_OUTPUT_SCALE);
 }
+
+void publishConversionDescriptor(void)
+{
+    mIsConversionDescriptorPending = false;
+    ++(mConversionDescriptor.configurationId);
+    
+    Logger_info
+    (
+        "%s: Conversion descriptor %u published (Thermocouple gain: %.0f).",
+        getLoggerPrefix(),
+        mConversionDescriptor.configurationId,
+        mConversionDescriptor.thermocoupleGain
+    );
+    
+    if (mConversionDescriptorCallback)
+    {
+        (*mConversionDescriptorCallback)(&mConversionDescriptor);
+    }
+}
+
+void notifyRawDataReady(EUnitId unitId, u32 code, u32 timestamp)
+{
+    if (mIsConversionDescriptorPending)
+    {
+        publishConversionDescriptor();
+    }
+    
+    if (mRawDataReadyCallback)
+    {
+        (*mRawDataReadyCallback)(unitId, code, mConversionDescriptor.configurationId, timestamp);
+    }
+}
+
+#undef SAMPLE_CARRIER_SNAPSHOTS_COUNT
+#undef THERMOCOUPLE_OUTPUT_SCALE
@@ -6,14 +6,24 @@
 #include "SharedDefines/EUnitId.h"
 #include "SharedDefines/SSampleCarrierData.h"
 #include "SharedDefines/SRTDPolynomialCoefficients.h"
+#include "SharedDefines/ESampleStreamFormat.h"
+#include "SharedDefines/SSampleCarrierConversionDescriptor.h"
 
 THREAD_PROTOTYPE(SampleCarrierDataManager)
 
 void SampleCarrierDataManager_setup(void);
 void SampleCarrierDataManager_initialize(void);
 void SampleCarrierDataManager_getData(SSampleCarrierData* data);
+bool SampleCarrierDataManager_readSnapshot(EUnitId unitId, float* value, u32* timestamp);
 void SampleCarrierManager_setRTDPolynomialCoefficients(SRTDPolynomialCoefficients* coefficients);
 void SampleCarrierDataManager_registerDataReadyCallback(void (*dataReadyCallback)(SSampleCarrierData*));
 void SampleCarrierDataManager_deregisterDataReadyCallback(void);
 
+bool SampleCarrierDataManager_setStreamFormat(ESampleStreamFormat format);
+ESampleStreamFormat SampleCarrierDataManager_getStreamFormat(void);
+void SampleCarrierDataManager_registerRawDataReadyCallback(void (*rawDataReadyCallback)(EUnitId, u32, u8, u32));
+void SampleCarrierDataManager_deregisterRawDataReadyCallback(void);
+void SampleCarrierDataManager_registerConversionDescriptorCallback(void (*conversionDescriptorCallback)(SSampleCarrierConversionDescriptor*));
+void SampleCarrierDataManager_deregisterConversionDescriptorCallback(void);
+
 #endif
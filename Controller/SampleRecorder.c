@@ -0,0 +1,166 @@
+#include "Controller/SampleRecorder.h"
+
+#include "Utilities/Logger/Logger.h"
+
+#include "cmsis_os.h"
+
+// RAM share of the recorder. 24 KB of 96 KB SRAM by default, can be overridden by build flag.
+#ifndef SAMPLE_RECORDER_BUFFER_SIZE
+#define SAMPLE_RECORDER_BUFFER_SIZE ( 24U * 1024U )
+#endif
+
+typedef struct _SRecordedSample
+{
+    u32 timestamp;
+    float value;
+    u8 unitId;
+} SRecordedSample;
+
+#define SAMPLE_RECORDER_MAX_SAMPLES_COUNT ( SAMPLE_RECORDER_BUFFER_SIZE / sizeof(SRecordedSample) )
+
+// Capacity and counts are reported to Master as u16, a larger buffer is only used up to that limit.
+#define SAMPLE_RECORDER_CAPACITY_LIMIT ( ( 0xFFFFU < SAMPLE_RECORDER_MAX_SAMPLES_COUNT ) ? 0xFFFFU : SAMPLE_RECORDER_MAX_SAMPLES_COUNT )
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+
+static SRecordedSample mSamples [SAMPLE_RECORDER_MAX_SAMPLES_COUNT];
+static u32 mCapacity = SAMPLE_RECORDER_CAPACITY_LIMIT;
+static u32 mOldestSampleIndex = 0;
+static u32 mRecordedSamplesCount = 0;
+static u32 mOverwrittenSamplesCount = 0;
+static volatile bool mIsRecording = false;
+
+static const char* getLoggerPrefix(void);
+
+void SampleRecorder_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+}
+
+bool SampleRecorder_start(u16 capacity, u16* appliedCapacity)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if ( (0 == capacity) || (SAMPLE_RECORDER_CAPACITY_LIMIT < capacity) )
+    {
+        capacity = (u16) SAMPLE_RECORDER_CAPACITY_LIMIT;
+    }
+    
+    mCapacity = capacity;
+    mOldestSampleIndex = 0;
+    mRecordedSamplesCount = 0;
+    mOverwrittenSamplesCount = 0;
+    mIsRecording = true;
+    *appliedCapacity = capacity;
+    
+    osMutexRelease(mMutexId);
+    
+    Logger_info("%s: Recording started (Capacity: %u samples).", getLoggerPrefix(), capacity);
+    
+    return true;
+}
+
+bool SampleRecorder_stop(u16* recordedSamplesCount, u32* overwrittenSamplesCount)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = mIsRecording;
+    mIsRecording = false;
+    *recordedSamplesCount = (u16) mRecordedSamplesCount;
+    *overwrittenSamplesCount = mOverwrittenSamplesCount;
+    
+    osMutexRelease(mMutexId);
+    
+    if (result)
+    {
+        Logger_info("%s: Recording stopped (Recorded: %u samples, overwritten: %u samples).", getLoggerPrefix(), *recordedSamplesCount, *overwrittenSamplesCount);
+    }
+    else
+    {
+        Logger_warning("%s: Recording is not running. Stop request skipped.", getLoggerPrefix());
+    }
+    
+    return result;
+}
+
+bool SampleRecorder_isRecording(void)
+{
+    return mIsRecording;
+}
+
+u16 SampleRecorder_getRecordedSamplesCount(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    u16 recordedSamplesCount = (u16) mRecordedSamplesCount;
+    osMutexRelease(mMutexId);
+    return recordedSamplesCount;
+}
+
+void SampleRecorder_record(EUnitId unitId, float value, u32 timestamp)
+{
+    if (!mIsRecording)
+    {
+        return;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mIsRecording)
+    {
+        u32 index;
+        if (mCapacity == mRecordedSamplesCount)
+        {
+            index = mOldestSampleIndex;
+            mOldestSampleIndex = ( mCapacity == (mOldestSampleIndex + 1) ) ? 0 : (mOldestSampleIndex + 1);
+            ++mOverwrittenSamplesCount;
+        }
+        else
+        {
+            index = ( (mOldestSampleIndex + mRecordedSamplesCount) % mCapacity );
+            ++mRecordedSamplesCount;
+        }
+        
+        mSamples[index].timestamp = timestamp;
+        mSamples[index].value = value;
+        mSamples[index].unitId = unitId;
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+u8 SampleRecorder_read(u16 firstSampleIndex, u8 maxSamplesCount, u8* unitIds, float* values, u32* timestamps)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    u8 samplesCount = 0;
+    
+    if (mIsRecording)
+    {
+        Logger_warning("%s: Reading samples is not possible during recording.", getLoggerPrefix());
+    }
+    else
+    {
+        while ( (maxSamplesCount > samplesCount) && (mRecordedSamplesCount > ( (u32) firstSampleIndex + samplesCount )) )
+        {
+            const SRecordedSample* sample = &(mSamples[(mOldestSampleIndex + firstSampleIndex + samplesCount) % mCapacity]);
+            unitIds[samplesCount] = sample->unitId;
+            values[samplesCount] = sample->value;
+            timestamps[samplesCount] = sample->timestamp;
+            ++samplesCount;
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return samplesCount;
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "SampleRecorder";
+}
+
+#undef SAMPLE_RECORDER_CAPACITY_LIMIT
+#undef SAMPLE_RECORDER_MAX_SAMPLES_COUNT
+#undef SAMPLE_RECORDER_BUFFER_SIZE
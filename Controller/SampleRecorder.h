@@ -0,0 +1,19 @@
+#ifndef _SAMPLE_RECORDER_H_
+
+#define _SAMPLE_RECORDER_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/EUnitId.h"
+#include "stdbool.h"
+
+void SampleRecorder_setup(void);
+
+bool SampleRecorder_start(u16 capacity, u16* appliedCapacity);
+bool SampleRecorder_stop(u16* recordedSamplesCount, u32* overwrittenSamplesCount);
+bool SampleRecorder_isRecording(void);
+u16 SampleRecorder_getRecordedSamplesCount(void);
+
+void SampleRecorder_record(EUnitId unitId, float value, u32 timestamp);
+u8 SampleRecorder_read(u16 firstSampleIndex, u8 maxSamplesCount, u8* unitIds, float* values, u32* timestamps);
+
+#endif
@@ -1,15 +1,19 @@
 #include "Controller/SegmentsManager.h"
 
 #include "Controller/HeaterTemperatureController.h"
+#include "Controller/SetPointTrajectory.h"
 #include "FaultManagement/FaultIndication.h"
+#include "Peripherals/TIM2.h"
 #include "System/KernelManager.h"
 #include "Utilities/Printer/CStringConverter.h"
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/CopyObject.h"
+#include "Utilities/Snapshot.h"
 
 #include "cmsis_os.h"
 
-#define MAX_REGISTERED_SEGMENTS_COUNT 10
+#define MAX_REGISTERED_SEGMENTS_COUNT 64
+#define SEGMENTS_BANKS_COUNT 2
 
 typedef struct _SLocalSegmentData
 {
@@ -32,8 +36,12 @@ static osMutexDef(mMutex);
 static osMutexId mMutexId = NULL;
 static EThreadId mThreadId = EThreadId_StaticSegmentProgramExecutor;
 
-static SLocalSegmentData mRegisteredSegments [MAX_REGISTERED_SEGMENTS_COUNT];
+static SLocalSegmentData mSegmentsBanks [SEGMENTS_BANKS_COUNT][MAX_REGISTERED_SEGMENTS_COUNT];
+static SLocalSegmentData* mRegisteredSegments = mSegmentsBanks[0];
+static SLocalSegmentData* mUploadedSegments = mSegmentsBanks[1];
 static u16 mNumberOfRegisteredSegments = 0;
+static u16 mNumberOfUploadedSegments = 0;
+static bool mIsProgramUploadStarted = false;
 static u16 mNumberOfRealizedSegments = 0;
 static SLocalSegmentData* mFirstSegmentInChain = NULL;
 static SLocalSegmentData* mLastSegmentInChain = NULL;
@@ -43,6 +51,16 @@ static bool mIsProgramRunning = false;
 static bool mIsSegmentWaitingForFinishing = false;
 static float mActualSetTemperature = 0.0F;
 
+typedef struct _SProgramStatusSnapshot
+{
+    SSnapshot header;
+    volatile bool isProgramRunning;
+    volatile u16 currentSegmentNumber;
+    volatile u16 registeredSegmentsCount;
+} SProgramStatusSnapshot;
+
+static SProgramStatusSnapshot mProgramStatusSnapshot;
+
 static void dynamicSegmentProgramExecutor(void const* arg);
 static void staticSegmentProgramExecutor(void const* arg);
 static void dynamicSegmentSetter(void);
@@ -56,6 +74,8 @@ static void sendProgramDoneInd(void);
 
 static SLocalSegmentData* getRegisteredSegment(u16 number);
 static SLocalSegmentData* getPreviousSegment(SLocalSegmentData* segment);
+static void clearSegmentsBank(SLocalSegmentData* bank);
+static void publishProgramStatus(void);
 static bool startProgram(void);
 static bool stopProgram(void);
 static const char* getLoggerPrefix(void);
@@ -74,11 +94,9 @@ void SegmentsManager_initialize(void)
 {
     osMutexWait(mMutexId, osWaitForever);
     
-    for (u8 iter = 0; MAX_REGISTERED_SEGMENTS_COUNT > iter; ++iter)
+    for (u8 iter = 0; SEGMENTS_BANKS_COUNT > iter; ++iter)
     {
-        mRegisteredSegments[iter].isActive = false;
-        mRegisteredSegments[iter].isInProgress = false;
-        mRegisteredSegments[iter].nextSegmentInChain = NULL;
+        clearSegmentsBank(mSegmentsBanks[iter]);
     }
     
     osMutexRelease(mMutexId);
@@ -164,6 +182,7 @@ bool SegmentsManager_registerNewSegment(SSegmentData* data)
         mLastSegmentInChain->nextSegmentInChain = NULL;
         CopyObject_SSegmentData(data, &(mLastSegmentInChain->data));
         ++mNumberOfRegisteredSegments;
+        publishProgramStatus();
         
         Logger_info("%s: Segment %u registered (%s). Applied configuration:", getLoggerPrefix(), mLastSegmentInChain->data.number, CStringConverter_ESegmentType(mLastSegmentInChain->data.type));
         if (ESegmentType_Static == mLastSegmentInChain->data.type)
@@ -214,6 +233,7 @@ bool SegmentsManager_deregisterSegment(u16 number)
             }
             
             deregisteredSegment->nextSegmentInChain = NULL;
+            publishProgramStatus();
             
             Logger_info("%s: Deregistered segment %u from program.", getLoggerPrefix(), number);
             
@@ -226,6 +246,29 @@ bool SegmentsManager_deregisterSegment(u16 number)
     return result;
 }
 
+bool SegmentsManager_readProgramStatusSnapshot(bool* isProgramRunning, u16* currentSegmentNumber, u16* registeredSegmentsCount, u32* timestamp)
+{
+    for (u8 attempt = 0; SNAPSHOT_MAX_READ_ATTEMPTS > attempt; ++attempt)
+    {
+        u32 sequence = Snapshot_beginRead(&(mProgramStatusSnapshot.header));
+        bool running = mProgramStatusSnapshot.isProgramRunning;
+        u16 segmentNumber = mProgramStatusSnapshot.currentSegmentNumber;
+        u16 segmentsCount = mProgramStatusSnapshot.registeredSegmentsCount;
+        u32 publishTime = mProgramStatusSnapshot.header.timestamp;
+        
+        if (Snapshot_endRead(&(mProgramStatusSnapshot.header), sequence))
+        {
+            *isProgramRunning = running;
+            *currentSegmentNumber = segmentNumber;
+            *registeredSegmentsCount = segmentsCount;
+            *timestamp = publishTime;
+            return (0 != sequence);
+        }
+    }
+    
+    return false;
+}
+
 u16 SegmentsManager_getNumberOfRegisteredSegments(void)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -234,6 +277,124 @@ u16 SegmentsManager_getNumberOfRegisteredSegments(void)
     return numberOfRegisteredSegments;
 }
 
+bool SegmentsManager_startProgramUpload(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    clearSegmentsBank(mUploadedSegments);
+    mNumberOfUploadedSegments = 0;
+    mIsProgramUploadStarted = true;
+    
+    Logger_debug("%s: Program upload started.", getLoggerPrefix());
+    
+    osMutexRelease(mMutexId);
+    
+    return true;
+}
+
+bool SegmentsManager_uploadSegment(SSegmentData* data)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = false;
+    
+    if (!mIsProgramUploadStarted)
+    {
+        Logger_error("%s: Uploading segment %u is not possible. Program upload not started.", getLoggerPrefix(), data->number);
+    }
+    else if (MAX_REGISTERED_SEGMENTS_COUNT == mNumberOfUploadedSegments)
+    {
+        Logger_error("%s: Uploading segment %u is not possible. Max number of allocated segments reached.", getLoggerPrefix(), data->number);
+    }
+    else if ( (0 != mNumberOfUploadedSegments) && (mUploadedSegments[mNumberOfUploadedSegments - 1].data.number >= data->number) )
+    {
+        Logger_error("%s: Uploading segment %u is not possible. Segments numbers must be increasing.", getLoggerPrefix(), data->number);
+    }
+    else if ( (ESegmentType_Static != data->type) && (ESegmentType_Dynamic != data->type) )
+    {
+        Logger_error("%s: Uploading segment %u is not possible. Unknown segment type.", getLoggerPrefix(), data->number);
+    }
+    else
+    {
+        SLocalSegmentData* segment = &(mUploadedSegments[mNumberOfUploadedSegments]);
+        
+        segment->isActive = true;
+        segment->isInProgress = false;
+        segment->nextSegmentInChain = NULL;
+        CopyObject_SSegmentData(data, &(segment->data));
+        
+        if (0 != mNumberOfUploadedSegments)
+        {
+            mUploadedSegments[mNumberOfUploadedSegments - 1].nextSegmentInChain = segment;
+        }
+        
+        ++mNumberOfUploadedSegments;
+        result = true;
+    }
+    
+    if (!result)
+    {
+        mIsProgramUploadStarted = false;
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+bool SegmentsManager_commitProgramUpload(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = false;
+    
+    if (!mIsProgramUploadStarted)
+    {
+        Logger_error("%s: Committing uploaded program is not possible. Program upload not started or failed.", getLoggerPrefix());
+    }
+    else if (mIsProgramRunning)
+    {
+        Logger_error("%s: Committing uploaded program is not possible. Program is running.", getLoggerPrefix());
+    }
+    else
+    {
+        SLocalSegmentData* previousSegments = mRegisteredSegments;
+        mRegisteredSegments = mUploadedSegments;
+        mUploadedSegments = previousSegments;
+        
+        mNumberOfRegisteredSegments = mNumberOfUploadedSegments;
+        mFirstSegmentInChain = ( 0 != mNumberOfRegisteredSegments ) ? &(mRegisteredSegments[0]) : NULL;
+        mLastSegmentInChain = ( 0 != mNumberOfRegisteredSegments ) ? &(mRegisteredSegments[mNumberOfRegisteredSegments - 1]) : NULL;
+        
+        publishProgramStatus();
+        Logger_info("%s: Uploaded program with %u segments applied.", getLoggerPrefix(), mNumberOfRegisteredSegments);
+        
+        result = true;
+    }
+    
+    mIsProgramUploadStarted = false;
+    mNumberOfUploadedSegments = 0;
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void SegmentsManager_abortProgramUpload(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mIsProgramUploadStarted)
+    {
+        Logger_warning("%s: Program upload aborted after %u segments.", getLoggerPrefix(), mNumberOfUploadedSegments);
+    }
+    
+    mIsProgramUploadStarted = false;
+    mNumberOfUploadedSegments = 0;
+    
+    osMutexRelease(mMutexId);
+}
+
 void SegmentsManager_registerSegmentStartedIndCallback(void (*callback)(u8, u8))
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -276,6 +437,12 @@ void SegmentsManager_deregisterSegmentsProgramDoneIndCallback(void)
 
 bool SegmentsManager_startProgram(void)
 {
+    if (SetPointTrajectory_isRunning())
+    {
+        Logger_warning("%s: Set point trajectory is running. Segments program not started.", getLoggerPrefix());
+        return false;
+    }
+    
     osMutexWait(mMutexId, osWaitForever);
     bool result = startProgram();
     osMutexRelease(mMutexId);
@@ -308,6 +475,7 @@ void SegmentsManager_clearProgram(void)
         mRegisteredSegments[iter].isActive = false;
     }
     
+    publishProgramStatus();
     Logger_info("%s: Segment program is cleared!", getLoggerPrefix());
     
     osMutexRelease(mMutexId);
@@ -451,6 +619,7 @@ void segmentStartedActionExecutor(void)
         mFirstSegmentInChain->data.settingTimeInterval
     );
     mFirstSegmentInChain->isInProgress = true;
+    publishProgramStatus();
 }
 
 void segmentDoneActionExecutor(void)
@@ -482,6 +651,7 @@ void segmentDoneActionExecutor(void)
     mFirstSegmentInChain->isInProgress = false;
     mFirstSegmentInChain->isActive = false;
     mFirstSegmentInChain = mFirstSegmentInChain->nextSegmentInChain;
+    publishProgramStatus();
     
     if (NULL != mFirstSegmentInChain)
     {
@@ -519,6 +689,7 @@ void segmentDoneActionExecutor(void)
     {
         Logger_info("%s: All segments executed. Program is finished!", getLoggerPrefix());
         mIsProgramRunning = false;
+        publishProgramStatus();
         sendProgramDoneInd();
         HeaterTemperatureController_setSystemType(EControlSystemType_OpenLoop);
         HeaterTemperatureController_setPowerInPercent(0.0F);
@@ -555,6 +726,17 @@ SLocalSegmentData* getRegisteredSegment(u16 number)
     return NULL;
 }
 
+void clearSegmentsBank(SLocalSegmentData* bank)
+{
+    for (u8 iter = 0; MAX_REGISTERED_SEGMENTS_COUNT > iter; ++iter)
+    {
+        bank[iter].isActive = false;
+        bank[iter].isInProgress = false;
+        bank[iter].nextSegmentInChain = NULL;
+        bank[iter].data.number = 0;
+    }
+}
+
 SLocalSegmentData* getPreviousSegment(SLocalSegmentData* segment)
 {
     for (u8 iter = 0; MAX_REGISTERED_SEGMENTS_COUNT > iter; ++iter)
@@ -568,6 +750,15 @@ SLocalSegmentData* getPreviousSegment(SLocalSegmentData* segment)
     return NULL;
 }
 
+void publishProgramStatus(void)
+{
+    Snapshot_beginWrite(&(mProgramStatusSnapshot.header));
+    mProgramStatusSnapshot.isProgramRunning = mIsProgramRunning;
+    mProgramStatusSnapshot.currentSegmentNumber = ( NULL != mFirstSegmentInChain ) ? mFirstSegmentInChain->data.number : 0;
+    mProgramStatusSnapshot.registeredSegmentsCount = mNumberOfRegisteredSegments;
+    Snapshot_endWrite(&(mProgramStatusSnapshot.header), TIM2_getMicroseconds());
+}
+
 bool startProgram(void)
 {
     Logger_info("%s: Starting segments program.", getLoggerPrefix());
@@ -604,6 +795,7 @@ bool startProgram(void)
         }
         
         mIsProgramRunning = true;
+        publishProgramStatus();
         HeaterTemperatureController_setSystemType(EControlSystemType_SimpleFeedback);
         if (!HeaterTemperatureController_start())
         {
@@ -649,6 +841,7 @@ bool stopProgram(void)
     {
         mIsProgramRunning = false;
         mFirstSegmentInChain->isInProgress = false;
+        publishProgramStatus();
         if (!HeaterTemperatureController_stop())
         {
             Logger_error("%s: Failure during stopping heater temperature controller. Segments program not stopped.", getLoggerPrefix());
@@ -684,3 +877,4 @@ const char* getLoggerPrefix(void)
 }
 
 #undef MAX_REGISTERED_SEGMENTS_COUNT
+#undef SEGMENTS_BANKS_COUNT
@@ -16,6 +16,12 @@ bool SegmentsManager_modifyRegisteredSegment(SSegmentData* data);
 bool SegmentsManager_registerNewSegment(SSegmentData* data);
 bool SegmentsManager_deregisterSegment(u16 number);
 u16 SegmentsManager_getNumberOfRegisteredSegments(void);
+bool SegmentsManager_readProgramStatusSnapshot(bool* isProgramRunning, u16* currentSegmentNumber, u16* registeredSegmentsCount, u32* timestamp);
+
+bool SegmentsManager_startProgramUpload(void);
+bool SegmentsManager_uploadSegment(SSegmentData* data);
+bool SegmentsManager_commitProgramUpload(void);
+void SegmentsManager_abortProgramUpload(void);
 
 void SegmentsManager_registerSegmentStartedIndCallback(void (*callback)(u8, u8));
 void SegmentsManager_deregisterSegmentStartedIndCallback(void);
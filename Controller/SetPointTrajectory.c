@@ -0,0 +1,273 @@
+#include "Controller/SetPointTrajectory.h"
+#include "Controller/HeaterTemperatureController.h"
+#include "Controller/SegmentsManager.h"
+
+#include "Utilities/Logger/Logger.h"
+
+#include "cmsis_os.h"
+
+// Jitter buffer of (time, temperature) points streamed by Master. Point times are milliseconds from
+// the trajectory start. Playback starts when the buffer spans the prebuffer time (or the whole
+// trajectory is received); from then the set point is interpolated at every control period.
+// Set point provider runs under the controller mutex, so controller API is never called with the
+// trajectory mutex taken.
+
+#define SET_POINT_TRAJECTORY_BUFFER_SIZE 64
+
+typedef struct _STrajectoryPoint
+{
+    u32 time;
+    float temperature;
+} STrajectoryPoint;
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+
+static STrajectoryPoint mPoints [SET_POINT_TRAJECTORY_BUFFER_SIZE];
+static u16 mFirstPoint = 0;
+static u16 mPointsCount = 0;
+static u32 mNextPointIndex = 0;
+static bool mIsLastPointReceived = false;
+static ETrajectoryUnderrunPolicy mUnderrunPolicy = ETrajectoryUnderrunPolicy_GoSafe;
+static u32 mPrebufferTime = 0;
+static volatile bool mIsRunning = false;
+static bool mIsPlaying = false;
+static u64 mElapsedTime = 0;
+static u32 mPreviousTimestamp = 0;
+static bool mIsUnderrun = false;
+static u32 mUnderrunsCount = 0;
+
+static bool getSetPoint(u32 timestamp, float* setPoint);
+static STrajectoryPoint* getPoint(u16 index);
+static const char* getLoggerPrefix(void);
+
+void SetPointTrajectory_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+}
+
+bool SetPointTrajectory_start(ETrajectoryUnderrunPolicy underrunPolicy, u32 prebufferTime)
+{
+    bool isProgramRunning = false;
+    u16 currentSegmentNumber;
+    u16 registeredSegmentsCount;
+    u32 timestamp;
+    
+    SegmentsManager_readProgramStatusSnapshot(&isProgramRunning, &currentSegmentNumber, &registeredSegmentsCount, &timestamp);
+    
+    if (isProgramRunning)
+    {
+        Logger_warning("%s: Segments program is running. Trajectory not started.", getLoggerPrefix());
+        return false;
+    }
+    
+    if ( (ETrajectoryUnderrunPolicy_HoldLastValue != underrunPolicy) && (ETrajectoryUnderrunPolicy_GoSafe != underrunPolicy) )
+    {
+        Logger_warning("%s: Unknown underrun policy %u. Trajectory not started.", getLoggerPrefix(), underrunPolicy);
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mIsRunning)
+    {
+        osMutexRelease(mMutexId);
+        Logger_warning("%s: Trajectory is already running. New start request skipped.", getLoggerPrefix());
+        return false;
+    }
+    
+    mFirstPoint = 0;
+    mPointsCount = 0;
+    mNextPointIndex = 0;
+    mIsLastPointReceived = false;
+    mUnderrunPolicy = underrunPolicy;
+    mPrebufferTime = prebufferTime;
+    mIsPlaying = false;
+    mElapsedTime = 0;
+    mIsUnderrun = false;
+    mUnderrunsCount = 0;
+    mIsRunning = true;
+    
+    osMutexRelease(mMutexId);
+    
+    HeaterTemperatureController_registerSetPointProvider(getSetPoint);
+    HeaterTemperatureController_setSystemType(EControlSystemType_SimpleFeedback);
+    
+    if (!HeaterTemperatureController_start())
+    {
+        Logger_error("%s: Failure during starting heater temperature controller. Trajectory not started.", getLoggerPrefix());
+        HeaterTemperatureController_deregisterSetPointProvider();
+        HeaterTemperatureController_setSystemType(EControlSystemType_OpenLoop);
+        mIsRunning = false;
+        return false;
+    }
+    
+    HeaterTemperatureController_resetPidStates(EPid_ProcessController);
+    
+    Logger_info("%s: Trajectory started (Underrun policy: %u, prebuffer: %u ms).", getLoggerPrefix(), underrunPolicy, prebufferTime);
+    
+    return true;
+}
+
+bool SetPointTrajectory_stop(u32* underrunsCount)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = mIsRunning;
+    mIsRunning = false;
+    *underrunsCount = mUnderrunsCount;
+    osMutexRelease(mMutexId);
+    
+    if (!result)
+    {
+        Logger_warning("%s: Trajectory is not running. Stop request skipped.", getLoggerPrefix());
+        return false;
+    }
+    
+    HeaterTemperatureController_deregisterSetPointProvider();
+    result = HeaterTemperatureController_stop();
+    HeaterTemperatureController_setSystemType(EControlSystemType_OpenLoop);
+    
+    Logger_info("%s: Trajectory stopped (Underruns: %u).", getLoggerPrefix(), *underrunsCount);
+    
+    return result;
+}
+
+bool SetPointTrajectory_isRunning(void)
+{
+    return mIsRunning;
+}
+
+bool SetPointTrajectory_appendPoints(u32 firstPointIndex, u8 pointsCount, const u32* times, const float* temperatures, bool isLastChunk)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if ( !mIsRunning || (mNextPointIndex < firstPointIndex) )
+    {
+        osMutexRelease(mMutexId);
+        Logger_warning("%s: Unexpected trajectory chunk starting at point %u (expected %u).", getLoggerPrefix(), firstPointIndex, mNextPointIndex);
+        return false;
+    }
+    
+    bool result = true;
+    
+    // Points already buffered (chunk retransmitted by Master) are skipped.
+    for (u32 iter = mNextPointIndex - firstPointIndex; pointsCount > iter; ++iter)
+    {
+        if (SET_POINT_TRAJECTORY_BUFFER_SIZE <= mPointsCount)
+        {
+            break;
+        }
+        
+        if ( (0 < mPointsCount) && (getPoint(mPointsCount - 1)->time >= times[iter]) )
+        {
+            Logger_warning("%s: Trajectory point %u is not later than the previous one.", getLoggerPrefix(), firstPointIndex + iter);
+            result = false;
+            break;
+        }
+        
+        STrajectoryPoint* point = getPoint(mPointsCount);
+        point->time = times[iter];
+        point->temperature = temperatures[iter];
+        ++mPointsCount;
+        ++mNextPointIndex;
+    }
+    
+    if ( isLastChunk && (firstPointIndex + pointsCount == mNextPointIndex) )
+    {
+        mIsLastPointReceived = true;
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void SetPointTrajectory_getBufferStatus(u32* nextPointIndex, u16* bufferedPointsCount, u16* freePointsCount)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    *nextPointIndex = mNextPointIndex;
+    *bufferedPointsCount = mPointsCount;
+    *freePointsCount = SET_POINT_TRAJECTORY_BUFFER_SIZE - mPointsCount;
+    osMutexRelease(mMutexId);
+}
+
+bool getSetPoint(u32 timestamp, float* setPoint)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (0 == mPointsCount)
+    {
+        osMutexRelease(mMutexId);
+        return false;
+    }
+    
+    if (!mIsPlaying)
+    {
+        if ( mIsLastPointReceived || (mPrebufferTime <= getPoint(mPointsCount - 1)->time - getPoint(0)->time) )
+        {
+            mIsPlaying = true;
+            mElapsedTime = ( (u64) getPoint(0)->time ) * 1000U;
+            mPreviousTimestamp = timestamp;
+            Logger_debug("%s: Playback started with %u points buffered.", getLoggerPrefix(), mPointsCount);
+        }
+        
+        *setPoint = getPoint(0)->temperature;
+        osMutexRelease(mMutexId);
+        return true;
+    }
+    
+    mElapsedTime += (u32) ( timestamp - mPreviousTimestamp );
+    mPreviousTimestamp = timestamp;
+    
+    while ( (2 <= mPointsCount) && ( ( (u64) getPoint(1)->time ) * 1000U <= mElapsedTime ) )
+    {
+        mFirstPoint = (mFirstPoint + 1) % SET_POINT_TRAJECTORY_BUFFER_SIZE;
+        --mPointsCount;
+    }
+    
+    STrajectoryPoint* first = getPoint(0);
+    u64 firstPointTime = ( (u64) first->time ) * 1000U;
+    bool result = true;
+    
+    if (2 <= mPointsCount)
+    {
+        STrajectoryPoint* second = getPoint(1);
+        u64 secondPointTime = ( (u64) second->time ) * 1000U;
+        float fraction = (firstPointTime < mElapsedTime) ? (float) ( mElapsedTime - firstPointTime ) / (float) ( secondPointTime - firstPointTime ) : 0.0F;
+        
+        *setPoint = first->temperature + fraction * (second->temperature - first->temperature);
+        mIsUnderrun = false;
+    }
+    else if ( mIsLastPointReceived || (firstPointTime >= mElapsedTime) )
+    {
+        *setPoint = first->temperature;
+    }
+    else
+    {
+        if (!mIsUnderrun)
+        {
+            mIsUnderrun = true;
+            ++mUnderrunsCount;
+            Logger_warning("%s: Trajectory buffer underrun.", getLoggerPrefix());
+        }
+        
+        *setPoint = first->temperature;
+        result = ( ETrajectoryUnderrunPolicy_HoldLastValue == mUnderrunPolicy );
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+STrajectoryPoint* getPoint(u16 index)
+{
+    return &(mPoints[(mFirstPoint + index) % SET_POINT_TRAJECTORY_BUFFER_SIZE]);
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "SetPointTrajectory";
+}
+
+#undef SET_POINT_TRAJECTORY_BUFFER_SIZE
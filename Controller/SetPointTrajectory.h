@@ -0,0 +1,18 @@
+#ifndef _SET_POINT_TRAJECTORY_H_
+
+#define _SET_POINT_TRAJECTORY_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/ETrajectoryUnderrunPolicy.h"
+#include "stdbool.h"
+
+void SetPointTrajectory_setup(void);
+
+bool SetPointTrajectory_start(ETrajectoryUnderrunPolicy underrunPolicy, u32 prebufferTime);
+bool SetPointTrajectory_stop(u32* underrunsCount);
+bool SetPointTrajectory_isRunning(void);
+
+bool SetPointTrajectory_appendPoints(u32 firstPointIndex, u8 pointsCount, const u32* times, const float* temperatures, bool isLastChunk);
+void SetPointTrajectory_getBufferStatus(u32* nextPointIndex, u16* bufferedPointsCount, u16* freePointsCount);
+
+#endif
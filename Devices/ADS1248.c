@@ -4,6 +4,7 @@
 
 #include "Peripherals/EXTI.h"
 #include "Peripherals/SPI3.h"
+#include "Peripherals/TIM2.h"
 
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
@@ -49,6 +50,8 @@ static EADS1248Mode mActualDeviceMode = EADS1248Mode_Off;
 static EADS1248CallibrationType mActiveCallibration = EADS1248CallibrationType_Idle;
 static void (*mCallibrationDoneNotifyCallback)(EADS1248CallibrationType, bool) = NULL;
 static bool mIsDeviceTurnedOff = false;
+static volatile u32 mDataReadyTimestamp = 0;
+static bool mIsVoltageConversionEnabled = true;
 
 static ChannelData mChannelsData [USED_CHANNELS_COUNT] =
     {
@@ -75,7 +78,7 @@ static TByte getCallibrationCommmand(EADS1248CallibrationType callibrationType);
 static ChannelData* getChannelData(EUnitId thermocouple);
 static double convertAdcDataToVoltage(EUnitId thermocouple, u32 adcData);
 static void storeReadData(EUnitId thermocouple, double adcData);
-static void notifyObserverAboutNewADCValue(EUnitId thermocouple);
+static void notifyObserverAboutNewADCValue(EUnitId thermocouple, u32 adcData);
 static double getStoredThermocoupleVoltageValue(EUnitId thermocouple);
 
 static bool startCallibration(EADS1248CallibrationType callibrationType, void (*callibrationDoneNotifyCallback)(EADS1248CallibrationType, bool));
@@ -166,10 +169,16 @@ EVENT_HANDLER(DeviceDataReadyInd)
         wrongDataCounter = 0;
         
         Logger_debug("%s: Read ADC value: %u.", getLoggerPrefix(), readData);
-        double voltageValue = convertAdcDataToVoltage(readThermocouple, readData);
-        Logger_debug("%s: Actual %s value: %.6f V.", getLoggerPrefix(), CStringConverter_EUnitId(readThermocouple), voltageValue);
-        storeReadData(readThermocouple, voltageValue);
-        notifyObserverAboutNewADCValue(readThermocouple);
+        
+        // Raw codes are converted by Master, the stored voltage is left as it was.
+        if (mIsVoltageConversionEnabled)
+        {
+            double voltageValue = convertAdcDataToVoltage(readThermocouple, readData);
+            Logger_debug("%s: Actual %s value: %.6f V.", getLoggerPrefix(), CStringConverter_EUnitId(readThermocouple), voltageValue);
+            storeReadData(readThermocouple, voltageValue);
+        }
+        
+        notifyObserverAboutNewADCValue(readThermocouple, readData);
     }
 }
 
@@ -270,6 +279,14 @@ bool ADS1248_changeMode(EADS1248Mode newMode)
     return status;
 }
 
+EADS1248Mode ADS1248_getMode(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    EADS1248Mode mode = mActualDeviceMode;
+    osMutexRelease(mMutexId);
+    return mode;
+}
+
 bool ADS1248_startCallibration(EADS1248CallibrationType callibrationType, void (*callibrationDoneNotifyCallback)(EADS1248CallibrationType, bool))
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -361,6 +378,66 @@ bool ADS1248_setChannelSamplingSpeed(EADS1248SamplingSpeed samplingSpeed)
     return result;
 }
 
+bool ADS1248_setChannelConfiguration(EADS1248GainValue gainValue, EADS1248SamplingSpeed samplingSpeed)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    Logger_debug("%s: Setting new channels configuration: %s, %s.", getLoggerPrefix(), CStringConverter_EADS1248GainValue(gainValue), CStringConverter_EADS1248SamplingSpeed(samplingSpeed));
+    
+    // Gain and sampling speed share SYS0, so both are changed with a single register write.
+    double gain;
+    TByte sys0RegisterContent = getSys0RegisterContent(gainValue, samplingSpeed, &gain);
+    bool result = writeDataToRegisterAndValidateIt(ADS1248_REGISTER_SYS0, sys0RegisterContent);
+    
+    if (result)
+    {
+        Logger_info("%s: Set new channels configuration: %s, %s with success.", getLoggerPrefix(), CStringConverter_EADS1248GainValue(gainValue), CStringConverter_EADS1248SamplingSpeed(samplingSpeed));
+        mGainValue = gain;
+        mGain = gainValue;
+        mSamplingSpeed = samplingSpeed;
+    }
+    else
+    {
+        Logger_error("%s: Setting new channels configuration: %s, %s failed.", getLoggerPrefix(), CStringConverter_EADS1248GainValue(gainValue), CStringConverter_EADS1248SamplingSpeed(samplingSpeed));
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+float ADS1248_getChannelGainValue(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    float gain = (float) mGainValue;
+    osMutexRelease(mMutexId);
+    return gain;
+}
+
+EADS1248GainValue ADS1248_getChannelGain(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    EADS1248GainValue gain = mGain;
+    osMutexRelease(mMutexId);
+    return gain;
+}
+
+EADS1248SamplingSpeed ADS1248_getChannelSamplingSpeed(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    EADS1248SamplingSpeed samplingSpeed = mSamplingSpeed;
+    osMutexRelease(mMutexId);
+    return samplingSpeed;
+}
+
+void ADS1248_setVoltageConversionEnabled(bool isEnabled)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mIsVoltageConversionEnabled = isEnabled;
+    Logger_debug("%s: Voltage conversion %s.", getLoggerPrefix(), isEnabled ? "enabled" : "disabled");
+    osMutexRelease(mMutexId);
+}
+
 void ADS1248_registerNewValueObserver(EThreadId threadId)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -581,6 +658,7 @@ void callibrationDoneCallback(void)
 
 void dataReadyCallback(void)
 {
+    mDataReadyTimestamp = TIM2_getMicroseconds();
     CREATE_EVENT_ISR(DeviceDataReadyInd, mThreadId);
     SEND_EVENT();
 }
@@ -1045,7 +1123,7 @@ ChannelData* getChannelData(EUnitId thermocouple)
 double convertAdcDataToVoltage(EUnitId thermocouple, u32 adcData)
 {
     double sign = 0.0F;
-    if (0x7FFFFF < adcData)
+    if (ADS1248_POSITIVE_FULL_SCALE_CODE < adcData)
     {
         // Negative value of read voltage
         if (EUnitId_ThermocoupleReference == thermocouple)
@@ -1055,7 +1133,7 @@ double convertAdcDataToVoltage(EUnitId thermocouple, u32 adcData)
         }
         else
         {
-            adcData = ((~adcData) & 0x7FFFFF);
+            adcData = ((~adcData) & ADS1248_POSITIVE_FULL_SCALE_CODE);
             sign = -1.0;
         }
     }
@@ -1067,7 +1145,7 @@ double convertAdcDataToVoltage(EUnitId thermocouple, u32 adcData)
     
     // Positive value of read voltage
     double doubleAdcData = (double) adcData;
-    return ( sign * ( ( ( (doubleAdcData * 2.048) ) / mGainValue) / 8388607.0 ) );
+    return ( sign * ( ( ( (doubleAdcData * ADS1248_REFERENCE_VOLTAGE) ) / mGainValue) / (double) ADS1248_POSITIVE_FULL_SCALE_CODE ) );
 }
 
 void storeReadData(EUnitId thermocouple, double adcData)
@@ -1082,7 +1160,7 @@ void storeReadData(EUnitId thermocouple, double adcData)
     }
 }
 
-void notifyObserverAboutNewADCValue(EUnitId thermocouple)
+void notifyObserverAboutNewADCValue(EUnitId thermocouple, u32 adcData)
 {
     if (EThreadId_Unknown != mObserverThreadId)
     {
@@ -1091,6 +1169,9 @@ void notifyObserverAboutNewADCValue(EUnitId thermocouple)
         
         eventMessage->thermocouple = thermocouple;
         eventMessage->value = getStoredThermocoupleVoltageValue(thermocouple);
+        eventMessage->code = adcData;
+        eventMessage->gain = (float) mGainValue;
+        eventMessage->timestamp = mDataReadyTimestamp;
         
         Logger_debug
         (
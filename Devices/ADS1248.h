@@ -15,6 +15,7 @@ bool ADS1248_initialize(void);
 bool ADS1248_isInitialized(void);
 
 bool ADS1248_changeMode(EADS1248Mode newMode);
+EADS1248Mode ADS1248_getMode(void);
 bool ADS1248_startCallibration(EADS1248CallibrationType callibrationType, void (*callibrationDoneNotifyCallback)(EADS1248CallibrationType, bool));
 bool ADS1248_startReading(void);
 bool ADS1248_stopReading(void);
@@ -22,6 +23,11 @@ bool ADS1248_isReadingStarted(void);
 bool ADS1248_getThermocoupleVoltageValue(EUnitId thermocouple, double* value);
 bool ADS1248_setChannelGain(EADS1248GainValue gainValue);
 bool ADS1248_setChannelSamplingSpeed(EADS1248SamplingSpeed samplingSpeed);
+bool ADS1248_setChannelConfiguration(EADS1248GainValue gainValue, EADS1248SamplingSpeed samplingSpeed);
+float ADS1248_getChannelGainValue(void);
+EADS1248GainValue ADS1248_getChannelGain(void);
+EADS1248SamplingSpeed ADS1248_getChannelSamplingSpeed(void);
+void ADS1248_setVoltageConversionEnabled(bool isEnabled);
 
 void ADS1248_registerNewValueObserver(EThreadId threadId);
 void ADS1248_deregisterNewValueObserver(void);
@@ -3,6 +3,7 @@
 
 #include "Peripherals/EXTI.h"
 #include "Peripherals/SPI2.h"
+#include "Peripherals/TIM2.h"
 
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
@@ -33,6 +34,8 @@ static const float mComparatorResistanceValue = 1000.0F; // 1 kOhm
 //static const float mReferenceResistanceValue = 3212.0F; // 100 Ohm
 static const float mReferenceResistanceValue = 1487.0F; // 1.5 kOhm
 static float mActualRTDValue = 0.0F;
+static u32 mActualRTDCode = 0;
+static volatile u32 mDataReadyTimestamp = 0;
 static ELMP90100Mode mActualDeviceMode = ELMP90100Mode_Off;
 
 static void initializeGpio(void);
@@ -91,6 +94,7 @@ EVENT_HANDLER(DeviceDataReadyInd)
         wrongDataCounter = 0;
         
         Logger_debug("%s: Read ADC value: %u.", getLoggerPrefix(), readData);
+        mActualRTDCode = readData;
         mActualRTDValue = convertAdcDataToRTDValue(readData);
         Logger_debug("%s: Actual RTD value: %.4f Ohm.", getLoggerPrefix(), mActualRTDValue);
         notifyObserverAboutNewRTDValue();
@@ -186,6 +190,14 @@ bool LMP90100ControlSystem_changeMode(ELMP90100Mode newMode)
     return status;
 }
 
+ELMP90100Mode LMP90100ControlSystem_getMode(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    ELMP90100Mode mode = mActualDeviceMode;
+    osMutexRelease(mMutexId);
+    return mode;
+}
+
 void LMP90100ControlSystem_registerNewValueObserver(EThreadId threadId)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -411,7 +423,7 @@ bool isAdcDataReady(void)
 float convertAdcDataToRTDValue(u32 adcData)
 {
     const float floatAdcData = (float) adcData;
-    return ( ( 4.0F * mReferenceResistanceValue * floatAdcData ) / ( 16777216.0F * mGainValue ) + mComparatorResistanceValue );
+    return ( ( 4.0F * mReferenceResistanceValue * floatAdcData ) / ( (float) LMP90100_FULL_SCALE_CODE * mGainValue ) + mComparatorResistanceValue );
 }
 
 void notifyObserverAboutNewRTDValue(void)
@@ -422,6 +434,8 @@ void notifyObserverAboutNewRTDValue(void)
         CREATE_EVENT_MESSAGE(NewRTDValueInd);
         
         eventMessage->value = mActualRTDValue;
+        eventMessage->code = mActualRTDCode;
+        eventMessage->timestamp = mDataReadyTimestamp;
         Logger_debug
         (
             "%s: Sending notification %s to %s about new RTD value: %.4f Ohm.",
@@ -437,6 +451,7 @@ void notifyObserverAboutNewRTDValue(void)
 
 void dataReadyCallback(void)
 {
+    mDataReadyTimestamp = TIM2_getMicroseconds();
     CREATE_EVENT_ISR(DeviceDataReadyInd, mThreadId);
     SEND_EVENT();
 }
@@ -15,6 +15,7 @@ bool LMP90100ControlSystem_initialize(void);
 bool LMP90100ControlSystem_isInitialized(void);
 
 bool LMP90100ControlSystem_changeMode(ELMP90100Mode newMode);
+ELMP90100Mode LMP90100ControlSystem_getMode(void);
 
 void LMP90100ControlSystem_registerNewValueObserver(EThreadId threadId);
 void LMP90100ControlSystem_deregisterNewValueObserver(void);
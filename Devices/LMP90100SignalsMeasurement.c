@@ -3,6 +3,7 @@
 
 #include "Peripherals/EXTI.h"
 #include "Peripherals/SPI3.h"
+#include "Peripherals/TIM2.h"
 
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
@@ -43,6 +44,9 @@ static const float mRTD1ReferenceResistanceValue = 1500.0F; // 1.5 kOhm
 static const float mRTD2ReferenceResistanceValue = 1500.0F; // 1.5 kOhm
 static float mActualRTD1Value = 0.0F;
 static float mActualRTD2Value = 0.0F;
+static u32 mActualRTD1Code = 0;
+static u32 mActualRTD2Code = 0;
+static volatile u32 mDataReadyTimestamp = 0;
 static ELMP90100Mode mActualDeviceMode = ELMP90100Mode_Off;
 
 static void initializeGpio(void);
@@ -197,6 +201,23 @@ bool LMP90100SignalsMeasurement_changeMode(ELMP90100Mode newMode)
     return status;
 }
 
+ELMP90100Mode LMP90100SignalsMeasurement_getMode(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    ELMP90100Mode mode = mActualDeviceMode;
+    osMutexRelease(mMutexId);
+    return mode;
+}
+
+void LMP90100SignalsMeasurement_getRTD1ConversionParameters(float* referenceResistance, float* gain, float* comparatorResistance)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    *referenceResistance = mRTD1ReferenceResistanceValue;
+    *gain = mRTD1GainValue;
+    *comparatorResistance = mRTD1ComparatorResistanceValue;
+    osMutexRelease(mMutexId);
+}
+
 void LMP90100SignalsMeasurement_registerNewValueObserver(ELMP90100Rtd rtd, EThreadId threadId)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -467,6 +488,7 @@ void processReadAdcData(u32 adcData, EReadChannel readChannel)
     {
         case EReadChannel_Channel0 :
         {
+            mActualRTD1Code = adcData;
             mActualRTD1Value = convertAdcDataToRTD1Value(adcData);
             Logger_debug("%s: New RTD1 value read: %.4f Ohm.", getLoggerPrefix(), mActualRTD1Value);
             notifyObserverAboutNewRTD1Value();
@@ -481,6 +503,7 @@ void processReadAdcData(u32 adcData, EReadChannel readChannel)
         
         case EReadChannel_Channel2 :
         {
+            mActualRTD2Code = adcDataChannel1;
             mActualRTD2Value = convertAdcDataToRTD2Value(adcDataChannel1, adcData);
             Logger_debug("%s: New RTD2 value read: %.4f Ohm.", getLoggerPrefix(), mActualRTD2Value);
             notifyObserverAboutNewRTD2Value();
@@ -495,7 +518,7 @@ void processReadAdcData(u32 adcData, EReadChannel readChannel)
 float convertAdcDataToRTD1Value(u32 adcData)
 {
     const float floatAdcData = (float) adcData;
-    return ( ( 4.0F * mRTD1ReferenceResistanceValue * floatAdcData ) / ( 16777216.0F * mRTD1GainValue ) + mRTD1ComparatorResistanceValue );
+    return ( ( 4.0F * mRTD1ReferenceResistanceValue * floatAdcData ) / ( (float) LMP90100_FULL_SCALE_CODE * mRTD1GainValue ) + mRTD1ComparatorResistanceValue );
 }
 
 float convertAdcDataToRTD2Value(u32 adcDataVin2Vin3, u32 adcDataVin4Vin5)
@@ -513,6 +536,8 @@ void notifyObserverAboutNewRTD1Value(void)
         CREATE_EVENT_MESSAGE(NewRTDValueInd);
         
         eventMessage->value = mActualRTD1Value;
+        eventMessage->code = mActualRTD1Code;
+        eventMessage->timestamp = mDataReadyTimestamp;
         Logger_debug
         (
             "%s: Sending notification %s to %s about new RTD1 value: %.4f Ohm.",
@@ -534,6 +559,8 @@ void notifyObserverAboutNewRTD2Value(void)
         CREATE_EVENT_MESSAGE(NewRTDValueInd);
         
         eventMessage->value = mActualRTD2Value;
+        eventMessage->code = mActualRTD2Code;
+        eventMessage->timestamp = mDataReadyTimestamp;
         Logger_debug
         (
             "%s: Sending notification %s to %s about new RTD2 value: %.4f Ohm.",
@@ -549,6 +576,7 @@ void notifyObserverAboutNewRTD2Value(void)
 
 void dataReadyCallback(void)
 {
+    mDataReadyTimestamp = TIM2_getMicroseconds();
     CREATE_EVENT_ISR(DeviceDataReadyInd, mThreadId);
     SEND_EVENT();
 }
@@ -15,6 +15,8 @@ bool LMP90100SignalsMeasurement_initialize(void);
 bool LMP90100SignalsMeasurement_isInitialized(void);
 
 bool LMP90100SignalsMeasurement_changeMode(ELMP90100Mode newMode);
+ELMP90100Mode LMP90100SignalsMeasurement_getMode(void);
+void LMP90100SignalsMeasurement_getRTD1ConversionParameters(float* referenceResistance, float* gain, float* comparatorResistance);
 
 void LMP90100SignalsMeasurement_registerNewValueObserver(ELMP90100Rtd rtd, EThreadId threadId);
 void LMP90100SignalsMeasurement_deregisterNewValueObserver(ELMP90100Rtd rtd);
@@ -4,9 +4,11 @@
 #include "Defines/CommonMacros.h"
 
 #include "Peripherals/I2C1.h"
+#include "Peripherals/TIM2.h"
 
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
+#include "Utilities/Snapshot.h"
 
 #include "FaultManagement/FaultIndication.h"
 
@@ -17,8 +19,11 @@ static osMutexDef(mMutex);
 static osMutexId mMutexId = NULL;
 
 static u16 mActualValue = 0;
+static SFloatSnapshot mOutputVoltageSnapshot;
 static u8 mGain = 0;
+static bool mIsOutputLocked = false;
 
+static bool writeOutputVoltage(u16 value);
 static bool isDeviceReady(u8 maxCheckAttempts, TTimeMs intervalBetweenAttempts);
 static bool configureRegisters(void);
 static bool validateMainRegister(TByte transmittedRegister, TByte receivedRegister);
@@ -63,28 +68,14 @@ bool MCP4716_setOutputVoltage(u16 value)
     
     bool result = true;
     
-    if (value != mActualValue)
+    if ( mIsOutputLocked && (0 != value) )
     {
-        TByte data [2] = 
-        {
-            MCP4716_POWER_DOWN_NORMAL_OPERATION,
-            0x00
-        };
-        
-        data[0] |= (TByte) ( ( value >> 6 ) & 0x0F );
-        data[1] |= (TByte)( ( value << 2 ) & 0xFC );
-        
-        if (I2C1_transmit(MCP4716_DEVICE_ADDRESS, data, 2, 100))
-        {
-            Logger_debug("%s: Output voltage %.2f V (Val. %u).", getLoggerPrefix(), convertOutputVoltageToRealData(value), value);
-            mActualValue = value;
-        }
-        else
-        {
-            Logger_error("%s: Failure in transmitting I2C data during setting output voltage!", getLoggerPrefix());
-            FaultIndication_start(EFaultId_Communication, EUnitId_Nucleo, EUnitId_MCP4716);
-            result = false;
-        }
+        Logger_warning("%s: Output is locked at zero. Output voltage (Val. %u) not set.", getLoggerPrefix(), value);
+        result = false;
+    }
+    else if (value != mActualValue)
+    {
+        result = writeOutputVoltage(value);
     }
     
     osMutexRelease(mMutexId);
@@ -92,6 +83,28 @@ bool MCP4716_setOutputVoltage(u16 value)
     return result;
 }
 
+bool MCP4716_lockOutputAtZero(u16* previousValue)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    // Latch first, so nothing waiting for the mutex can drive the output again after it is zeroed.
+    mIsOutputLocked = true;
+    *previousValue = mActualValue;
+    bool result = writeOutputVoltage(0);
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void MCP4716_unlockOutput(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mIsOutputLocked = false;
+    osMutexRelease(mMutexId);
+    Logger_info("%s: Output unlocked.", getLoggerPrefix());
+}
+
 u16 MCP4716_getOutputVoltage(void)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -100,6 +113,11 @@ u16 MCP4716_getOutputVoltage(void)
     return value;
 }
 
+bool MCP4716_readOutputVoltageSnapshot(float* voltage, u32* timestamp)
+{
+    return Snapshot_readFloat(&mOutputVoltageSnapshot, voltage, timestamp);
+}
+
 bool MCP4716_readOutputVoltage(u16* value)
 {
     osMutexWait(mMutexId, osWaitForever);
@@ -116,6 +134,8 @@ bool MCP4716_readOutputVoltage(u16* value)
     }
     else
     {
+        // The register is read back when the transfer completes, the snapshot is stamped with that time.
+        u32 readTimestamp = TIM2_getMicroseconds();
         u16 outputVoltage = 0x00;
         outputVoltage |= ( ( ( (u16) (data[1]) ) << 2 ) & 0x3FC);
         outputVoltage |= ( ( ( (u16) (data[2]) ) >> 6 ) & 0x03);
@@ -123,6 +143,7 @@ bool MCP4716_readOutputVoltage(u16* value)
         Logger_debug("%s: Output voltage (raw value): %u.", getLoggerPrefix(), outputVoltage);
         
         mActualValue = outputVoltage;
+        Snapshot_writeFloat(&mOutputVoltageSnapshot, convertOutputVoltageToRealData(outputVoltage), readTimestamp);
         *value = outputVoltage;
     }
     
@@ -142,6 +163,31 @@ float MCP4716_convertOutputVoltageToRealData(u16 outputVoltage)
     return value;
 }
 
+bool writeOutputVoltage(u16 value)
+{
+    TByte data [2] = 
+    {
+        MCP4716_POWER_DOWN_NORMAL_OPERATION,
+        0x00
+    };
+    
+    data[0] |= (TByte) ( ( value >> 6 ) & 0x0F );
+    data[1] |= (TByte)( ( value << 2 ) & 0xFC );
+    
+    if (!I2C1_transmit(MCP4716_DEVICE_ADDRESS, data, 2, 100))
+    {
+        Logger_error("%s: Failure in transmitting I2C data during setting output voltage!", getLoggerPrefix());
+        FaultIndication_start(EFaultId_Communication, EUnitId_Nucleo, EUnitId_MCP4716);
+        return false;
+    }
+    
+    u32 writeTimestamp = TIM2_getMicroseconds();
+    Logger_debug("%s: Output voltage %.2f V (Val. %u).", getLoggerPrefix(), convertOutputVoltageToRealData(value), value);
+    mActualValue = value;
+    Snapshot_writeFloat(&mOutputVoltageSnapshot, convertOutputVoltageToRealData(value), writeTimestamp);
+    return true;
+}
+
 bool isDeviceReady(u8 maxCheckAttempts, TTimeMs intervalBetweenAttempts)
 {
     Logger_debug("%s: Checking if device is ready...", getLoggerPrefix());
@@ -10,6 +10,10 @@ bool MCP4716_initialize(void);
 bool MCP4716_setOutputVoltage(u16 value);
 u16 MCP4716_getOutputVoltage(void);
 bool MCP4716_readOutputVoltage(u16* value);
+bool MCP4716_readOutputVoltageSnapshot(float* voltage, u32* timestamp);
+
+bool MCP4716_lockOutputAtZero(u16* previousValue);
+void MCP4716_unlockOutput(void);
 
 float MCP4716_convertOutputVoltageToRealData(u16 outputVoltage);
 
@@ -0,0 +1,201 @@
+#include "MasterCommunication/BulkTransfer.h"
+#include "MasterCommunication/MasterUartGateway.h"
+#include "MasterCommunication/MasterDataMemoryManager.h"
+
+#include "SharedDefines/MessagesDefines.h"
+
+#include "Utilities/Logger/Logger.h"
+#include "Utilities/Printer/CStringConverter.h"
+
+#include "cmsis_os.h"
+
+// Generic chunking layer for transfers larger than one frame. The source is read straight into
+// BulkChunkInd messages carrying the offset and the total size, Master reassembles them and may
+// resume an interrupted transfer from the last offset it received. The BulkChunkInd memory pool
+// bounds the chunks in flight, the next chunk is produced once a previous one was transmitted.
+
+#define BULK_TRANSFER_SIGNAL 0x01
+#define BULK_TRANSFER_RETRY_PERIOD_MS 10
+
+typedef struct _SBulkTransferSource
+{
+    u32 (*getSize)(void);
+    u16 (*read)(u32 offset, TByte* buffer, u16 size);
+} SBulkTransferSource;
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+static osThreadId mProducerThreadId = NULL;
+
+static SBulkTransferSource mSources [EBulkTransferSource_Count];
+static bool mIsTransferActive = false;
+static EBulkTransferSource mSource = EBulkTransferSource_Recording;
+static u8 mTransferId = 0;
+static TRequestContext mContext;
+static u32 mTotalSize = 0;
+static u32 mOffset = 0;
+
+static void bulkTransferProducer(void const* arg);
+static void produceChunks(void);
+static const char* getLoggerPrefix(void);
+
+void BulkTransfer_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+    osThreadDef(bulkTransferThread, bulkTransferProducer, osPriorityBelowNormal, 0, configNORMAL_STACK_SIZE);
+    mProducerThreadId = osThreadCreate(osThread(bulkTransferThread), NULL);
+}
+
+void BulkTransfer_registerSource(EBulkTransferSource source, u32 (*getSize)(void), u16 (*read)(u32 offset, TByte* buffer, u16 size))
+{
+    if (EBulkTransferSource_Count <= source)
+    {
+        return;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    mSources[source].getSize = getSize;
+    mSources[source].read = read;
+    osMutexRelease(mMutexId);
+}
+
+void BulkTransfer_deregisterSource(EBulkTransferSource source)
+{
+    if (EBulkTransferSource_Count <= source)
+    {
+        return;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    mSources[source].getSize = NULL;
+    mSources[source].read = NULL;
+    
+    if ( mIsTransferActive && (source == mSource) )
+    {
+        mIsTransferActive = false;
+        Logger_warning("%s: Source %s deregistered. Transfer %u aborted.", getLoggerPrefix(), CStringConverter_EBulkTransferSource(source), mTransferId);
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+bool BulkTransfer_start(EBulkTransferSource source, u32 offset, const TRequestContext* context, u8* transferId, u32* totalSize)
+{
+    // Chunks of a broadcast request would all be suppressed.
+    if (context->isBroadcast)
+    {
+        Logger_warning("%s: Transfer of %s cannot be requested by broadcast.", getLoggerPrefix(), CStringConverter_EBulkTransferSource(source));
+        return false;
+    }
+    
+    if ( (EBulkTransferSource_Count <= source) || (EFramingMode_Cobs != MasterUartGateway_getFramingMode()) )
+    {
+        Logger_warning("%s: Transfer of %s requires %s framing mode.", getLoggerPrefix(), CStringConverter_EBulkTransferSource(source), CStringConverter_EFramingMode(EFramingMode_Cobs));
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if ( (NULL == mSources[source].getSize) || (NULL == mSources[source].read) )
+    {
+        Logger_warning("%s: Source %s is not available.", getLoggerPrefix(), CStringConverter_EBulkTransferSource(source));
+        osMutexRelease(mMutexId);
+        return false;
+    }
+    
+    u32 size = (*mSources[source].getSize)();
+    if (size < offset)
+    {
+        Logger_warning("%s: Offset %u is beyond %s size of %u bytes.", getLoggerPrefix(), offset, CStringConverter_EBulkTransferSource(source), size);
+        osMutexRelease(mMutexId);
+        return false;
+    }
+    
+    if (mIsTransferActive)
+    {
+        Logger_warning("%s: Transfer %u replaced at offset %u.", getLoggerPrefix(), mTransferId, mOffset);
+    }
+    
+    mSource = source;
+    mContext = *context;
+    mTotalSize = size;
+    mOffset = offset;
+    mIsTransferActive = ( offset < size );
+    
+    *transferId = ++mTransferId;
+    *totalSize = size;
+    
+    Logger_info("%s: Transfer %u of %s started (%u bytes from offset %u).", getLoggerPrefix(), mTransferId, CStringConverter_EBulkTransferSource(source), size, offset);
+    
+    osMutexRelease(mMutexId);
+    
+    osSignalSet(mProducerThreadId, BULK_TRANSFER_SIGNAL);
+    
+    return true;
+}
+
+void BulkTransfer_handleChunkTransmitted(void)
+{
+    osSignalSet(mProducerThreadId, BULK_TRANSFER_SIGNAL);
+}
+
+void bulkTransferProducer(void const* arg)
+{
+    while (true)
+    {
+        // Chunk memory is released only after the transmitted indication, so the pool is polled as well.
+        osSignalWait(BULK_TRANSFER_SIGNAL, BULK_TRANSFER_RETRY_PERIOD_MS);
+        produceChunks();
+    }
+}
+
+void produceChunks(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    while (mIsTransferActive)
+    {
+        TBulkChunkInd* chunk = MasterDataMemoryManager_allocate(EMessageId_BulkChunkInd);
+        if (NULL == chunk)
+        {
+            break;
+        }
+        
+        u32 leftBytes = mTotalSize - mOffset;
+        u16 size = ( BULK_CHUNK_DATA_SIZE < leftBytes ) ? BULK_CHUNK_DATA_SIZE : (u16) leftBytes;
+        
+        chunk->transferId = mTransferId;
+        chunk->totalSize = mTotalSize;
+        chunk->offset = mOffset;
+        chunk->length = (*mSources[mSource].read)(mOffset, chunk->data, size);
+        
+        if (0 == chunk->length)
+        {
+            Logger_error("%s: Reading %s at offset %u failed. Transfer %u aborted.", getLoggerPrefix(), CStringConverter_EBulkTransferSource(mSource), mOffset, mTransferId);
+            MasterDataMemoryManager_free(EMessageId_BulkChunkInd, chunk);
+            mIsTransferActive = false;
+            break;
+        }
+        
+        mOffset += chunk->length;
+        mIsTransferActive = ( mTotalSize > mOffset );
+        
+        MasterUartGateway_sendResponse(EMessageId_BulkChunkInd, chunk, &mContext);
+        
+        if (!mIsTransferActive)
+        {
+            Logger_info("%s: Transfer %u of %s done (%u bytes).", getLoggerPrefix(), mTransferId, CStringConverter_EBulkTransferSource(mSource), mTotalSize);
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "BulkTransfer";
+}
+
+#undef BULK_TRANSFER_SIGNAL
+#undef BULK_TRANSFER_RETRY_PERIOD_MS
@@ -0,0 +1,18 @@
+#ifndef _BULK_TRANSFER_H_
+
+#define _BULK_TRANSFER_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/EBulkTransferSource.h"
+#include "SharedDefines/TRequestContext.h"
+#include "stdbool.h"
+
+void BulkTransfer_setup(void);
+
+void BulkTransfer_registerSource(EBulkTransferSource source, u32 (*getSize)(void), u16 (*read)(u32 offset, TByte* buffer, u16 size));
+void BulkTransfer_deregisterSource(EBulkTransferSource source);
+
+bool BulkTransfer_start(EBulkTransferSource source, u32 offset, const TRequestContext* context, u8* transferId, u32* totalSize);
+void BulkTransfer_handleChunkTransmitted(void);
+
+#endif
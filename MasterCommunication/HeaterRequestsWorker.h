@@ -0,0 +1,12 @@
+#ifndef _HEATER_REQUESTS_WORKER_H_
+
+#define _HEATER_REQUESTS_WORKER_H_
+
+#include "Defines/CommonDefines.h"
+#include "System/ThreadMacros.h"
+
+THREAD_PROTOTYPE(HeaterRequestsWorker)
+
+void HeaterRequestsWorker_setup(void);
+
+#endif
@@ -0,0 +1,145 @@
+#include "MasterCommunication/LinkStatistics.h"
+
+#include "Peripherals/UART1.h"
+#include "Utilities/Logger/Logger.h"
+
+#include "stm32f4xx_hal.h"
+
+#include "cmsis_os.h"
+#include "string.h"
+
+// Counters are shared by several writers: the UART RX ISR (frame decoding, foreign frames), the receiver
+// thread, the gateway and the transmitter thread. A read-modify-write interrupted by the ISR would lose
+// an update, and reset would race with all of them, so counters are changed with interrupts masked for
+// the few instructions it takes. UART level counters are kept by UART1 and merged on read. TX queue and
+// latency statistics are updated from threads only and are guarded by the mutex.
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+
+static volatile u32 mCounters [ELinkCounter_Count];
+static u16 mTxQueueHighWaterMark = 0;
+static u64 mTxLatencySum = 0;
+static u32 mTxLatencyCount = 0;
+static u32 mMaxTxLatency = 0;
+
+static const char* getLoggerPrefix(void);
+
+void LinkStatistics_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+    memset((void*) mCounters, 0, sizeof(mCounters));
+}
+
+void LinkStatistics_increment(ELinkCounter counter)
+{
+    if (ELinkCounter_Count > counter)
+    {
+        u32 primask = __get_PRIMASK();
+        __disable_irq();
+        ++(mCounters[counter]);
+        __set_PRIMASK(primask);
+    }
+}
+
+void LinkStatistics_add(ELinkCounter counter, u32 value)
+{
+    if (ELinkCounter_Count > counter)
+    {
+        u32 primask = __get_PRIMASK();
+        __disable_irq();
+        mCounters[counter] += value;
+        __set_PRIMASK(primask);
+    }
+}
+
+void LinkStatistics_updateTxQueueLength(u16 length)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mTxQueueHighWaterMark < length)
+    {
+        mTxQueueHighWaterMark = length;
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+void LinkStatistics_registerTxLatency(u32 latency)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    mTxLatencySum += latency;
+    ++mTxLatencyCount;
+    
+    if (mMaxTxLatency < latency)
+    {
+        mMaxTxLatency = latency;
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+void LinkStatistics_read(u32* counters, u16* txQueueHighWaterMark, u32* meanTxLatency, u32* maxTxLatency)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    
+    for (u8 iter = 0; ELinkCounter_Count > iter; ++iter)
+    {
+        counters[iter] = mCounters[iter];
+    }
+    
+    __set_PRIMASK(primask);
+    
+    SUartStatistics uartStatistics;
+    UART1_getStatistics(&uartStatistics);
+    
+    counters[ELinkCounter_BytesReceived] = uartStatistics.bytesReceived;
+    counters[ELinkCounter_BytesTransmitted] = uartStatistics.bytesTransmitted;
+    counters[ELinkCounter_ParityErrors] = uartStatistics.parityErrors;
+    counters[ELinkCounter_NoiseErrors] = uartStatistics.noiseErrors;
+    counters[ELinkCounter_FramingErrors] = uartStatistics.framingErrors;
+    counters[ELinkCounter_OverrunErrors] = uartStatistics.overrunErrors;
+    counters[ELinkCounter_DmaErrors] = uartStatistics.dmaErrors;
+    counters[ELinkCounter_ReceiverRestarts] = uartStatistics.receiverRestarts;
+    
+    *txQueueHighWaterMark = mTxQueueHighWaterMark;
+    *meanTxLatency = (0 != mTxLatencyCount) ? (u32) ( mTxLatencySum / mTxLatencyCount ) : 0;
+    *maxTxLatency = mMaxTxLatency;
+    
+    osMutexRelease(mMutexId);
+}
+
+void LinkStatistics_reset(void)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    
+    for (u8 iter = 0; ELinkCounter_Count > iter; ++iter)
+    {
+        mCounters[iter] = 0;
+    }
+    
+    __set_PRIMASK(primask);
+    
+    UART1_resetStatistics();
+    
+    mTxQueueHighWaterMark = 0;
+    mTxLatencySum = 0;
+    mTxLatencyCount = 0;
+    mMaxTxLatency = 0;
+    
+    Logger_info("%s: Statistics reset.", getLoggerPrefix());
+    
+    osMutexRelease(mMutexId);
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "LinkStatistics";
+}
@@ -0,0 +1,19 @@
+#ifndef _LINK_STATISTICS_H_
+
+#define _LINK_STATISTICS_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/ELinkCounter.h"
+#include "stdbool.h"
+
+void LinkStatistics_setup(void);
+
+void LinkStatistics_increment(ELinkCounter counter);
+void LinkStatistics_add(ELinkCounter counter, u32 value);
+void LinkStatistics_updateTxQueueLength(u16 length);
+void LinkStatistics_registerTxLatency(u32 latency);
+
+void LinkStatistics_read(u32* counters, u16* txQueueHighWaterMark, u32* meanTxLatency, u32* maxTxLatency);
+void LinkStatistics_reset(void);
+
+#endif
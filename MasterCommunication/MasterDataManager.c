@@ -1,12 +1,16 @@
 #include "MasterCommunication/MasterDataManager.h"
 #include "MasterCommunication/MasterDataMemoryManager.h"
 #include "MasterCommunication/MasterUartGateway.h"
+#include "MasterCommunication/TimeSynchronizer.h"
+#include "MasterCommunication/LinkStatistics.h"
+#include "MasterCommunication/BulkTransfer.h"
 
 #include "FaultManagement/FaultIndication.h"
 
 #include "SharedDefines/MessagesDefines.h"
 #include "SharedDefines/EMessageId.h"
 #include "SharedDefines/TMessage.h"
+#include "SharedDefines/TRequestContext.h"
 #include "SharedDefines/SFaultIndication.h"
 #include "SharedDefines/SSampleCarrierData.h"
 #include "SharedDefines/EUnitId.h"
@@ -23,71 +27,129 @@
 #include "Devices/LMP90100SignalsMeasurement.h"
 #include "Devices/MCP4716.h"
 
+#include "Peripherals/TIM2.h"
+
 #include "Controller/HeaterTemperatureController.h"
 #include "Controller/HeaterTemperatureReader.h"
 #include "Controller/ReferenceTemperatureController.h"
 #include "Controller/ReferenceTemperatureReader.h"
 #include "Controller/SampleCarrierDataManager.h"
 #include "Controller/SegmentsManager.h"
+#include "Controller/SampleRecorder.h"
+#include "Controller/SetPointTrajectory.h"
+#include "Controller/ConfigurationBatch.h"
+#include "Controller/EmergencyStop.h"
+#include "Controller/CommandScript.h"
 
 #include "Utilities/Printer/CStringConverter.h"
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/CopyObject.h"
+#include "Utilities/StreamFilter.h"
 
 #include "cmsis_os.h"
+#include "string.h"
 
 THREAD_DEFINES(MasterDataManager, MasterDataManager)
 EVENT_HANDLER_PROTOTYPE(DataFromMasterReceivedInd)
 
-#define HANDLE_REQUEST(request)         case EMessageId_##request :                                 \
-                                        {                                                           \
-                                            handle##request ( (T##request *) message->data);        \
-                                            break;                                                  \
-                                        }                                                           \
+typedef void (*TRequestHandler)(void* request, const TRequestContext* context);
+
+#define REQUEST_HANDLER_FromMaster(request)     static void handle##request(T##request* request, const TRequestContext* context);               \
+                                                static void dispatch##request(void* request, const TRequestContext* context)                    \
+                                                {                                                                                               \
+                                                    handle##request( (T##request*) request, context);                                           \
+                                                }
+#define REQUEST_HANDLER_ToMaster(request)
+#define REQUEST_HANDLER_Link(request)
+#define REQUEST_HANDLER(request, id, size, dir, lane)           REQUEST_HANDLER_##dir(request)
+
+#define REQUEST_DISPATCH_FromMaster(request)    [EMessageId_##request] = dispatch##request,
+#define REQUEST_DISPATCH_ToMaster(request)
+#define REQUEST_DISPATCH_Link(request)
+#define REQUEST_DISPATCH(request, id, size, dir, lane)          REQUEST_DISPATCH_##dir(request)
+
+#define RAW_MESSAGE_IGNORED(message, id, dir, lane)
 
 static void handleMasterData(TMessage* message);
+static bool isRequestStaged(EMessageId messageId);
+static EThreadId getRequestExecutor(EMessageId messageId, bool isStaged);
 
 // Requests from Master
-static void handlePollingRequest(TPollingRequest* request);
-static void handleResetUnitRequest(TResetUnitRequest* request);
-static void handleSetHeaterPowerRequest(TSetHeaterPowerRequest* request);
-static void handleCallibreADS1248Request(TCallibreADS1248Request* request);
-static void handleSetChannelGainADS1248Request(TSetChannelGainADS1248Request* request);
-static void handleSetChannelSamplingSpeedADS1248Request(TSetChannelSamplingSpeedADS1248Request* request);
-static void handleStartRegisteringDataRequest(TStartRegisteringDataRequest* request);
-static void handleStopRegisteringDataRequest(TStopRegisteringDataRequest* request);
-static void handleSetNewDeviceModeADS1248Request(TSetNewDeviceModeADS1248Request* request);
-static void handleSetNewDeviceModeLMP90100ControlSystemRequest(TSetNewDeviceModeLMP90100ControlSystemRequest* request);
-static void handleSetNewDeviceModeLMP90100SignalsMeasurementRequest(TSetNewDeviceModeLMP90100SignalsMeasurementRequest* request);
-static void handleSetControlSystemTypeRequest(TSetControlSystemTypeRequest* request);
-static void handleSetControllerTunesRequest(TSetControllerTunesRequest* request);
-static void handleSetProcessModelParametersRequest(TSetProcessModelParametersRequest* request);
-static void handleSetControllingAlgorithmExecutionPeriodRequest(TSetControllingAlgorithmExecutionPeriodRequest* request);
-static void handleRegisterNewSegmentToProgramRequest(TRegisterNewSegmentToProgramRequest* request);
-static void handleDeregisterSegmentFromProgramRequest(TDeregisterSegmentFromProgramRequest* request);
-static void handleStartSegmentProgramRequest(TStartSegmentProgramRequest* request);
-static void handleStopSegmentProgramRequest(TStopSegmentProgramRequest* request);
-static void handleStartReferenceTemperatureStabilizationRequest(TStartReferenceTemperatureStabilizationRequest* request);
-static void handleStopReferenceTemperatureStabilizationRequest(TStopReferenceTemperatureStabilizationRequest* request);
-static void handleSetRTDPolynomialCoefficientsRequest(TSetRTDPolynomialCoefficientsRequest* request);
-static void handleSetHeaterTemperatureInFeedbackModeRequest(TSetHeaterTemperatureInFeedbackModeRequest* request);
-
-static void handleUnexpectedMessage(u8 messageId);
+MESSAGES_REGISTRY(REQUEST_HANDLER, RAW_MESSAGE_IGNORED)
+
+static const TRequestHandler mRequestHandlers [EMessageId_Limit] =
+{
+    MESSAGES_REGISTRY(REQUEST_DISPATCH, RAW_MESSAGE_IGNORED)
+};
+
+static void handleUnexpectedMessage(u8 messageId, const TRequestContext* context);
+static void rejectBusyRequest(TMessage* message, const TRequestContext* context, EThreadId executor);
+
+// Configuration batch state as seen by the dispatcher, in the order requests arrive
+static volatile bool mIsConfigurationBatchDispatched = false;
 
 // Indications to Master callbacks
 static void logIndCallback(TLogInd* logInd);
 static void faultIndCallback(SFaultIndication* faultIndication);
 static void sampleCarrierDataIndCallback(SSampleCarrierData* sampleCarrierData);
-static void heaterTemperatureIndCallback(float temperature);
-static void referenceTemperatureIndCallback(float temperature);
+static void sampleCarrierRawDataIndCallback(EUnitId unitId, u32 code, u8 configurationId, u32 timestamp);
+static void sampleCarrierConversionDescriptorInd(SSampleCarrierConversionDescriptor* descriptor);
+static void heaterTemperatureIndCallback(float temperature, u32 timestamp);
+static void referenceTemperatureIndCallback(float temperature, u32 timestamp);
 //static void controllerDataIndCallback(SControllerData* controllerData);
-static void controllerDataIndCallback(EControllerDataType type, float value);
+static void controllerDataIndCallback(EControllerDataType type, float value, u32 timestamp);
 static void segmentStartedInd(u16 segmentNumber, u8 leftRegisteredSegments);
 static void segmentsProgramDoneInd(u16 realizedSegmentsCount, u16 lastSegmentDoneNumber);
 static void unitReadyIndCallback(EUnitId unitId, bool status);
+static void emergencyStopDoneInd(SEmergencyStopReport* report);
+static void commandScriptMarkerInd(u16 marker, u16 pc, u32 timestamp);
+static void commandScriptDoneInd(ECommandScriptStatus status, u16 pc, u32 executionTime);
+
+// Telemetry streams filtering
+#define SAMPLE_CARRIER_STREAMS_COUNT ( EUnitId_Thermocouple4 - EUnitId_RtdPt1000 + 1 )
+#define CONTROLLER_DATA_STREAMS_COUNT ( EControllerDataType_ERR + 1 )
+
+static osMutexDef(mStreamFiltersMutex);
+static osMutexId mStreamFiltersMutexId = NULL;
+static SStreamFilter mHeaterTemperatureFilter;
+static SStreamFilter mReferenceTemperatureFilter;
+static SStreamFilter mControllerDataFilters [CONTROLLER_DATA_STREAMS_COUNT];
+static SStreamFilter mSampleCarrierDataFilters [SAMPLE_CARRIER_STREAMS_COUNT];
+static u16 mHeaterTemperatureSequenceNumber = 0;
+static u16 mReferenceTemperatureSequenceNumber = 0;
+static u16 mControllerDataSequenceNumbers [CONTROLLER_DATA_STREAMS_COUNT];
+static u16 mSampleCarrierDataSequenceNumbers [SAMPLE_CARRIER_STREAMS_COUNT];
+
+static SStreamFilter* getStreamFilter(ERegisteringDataType dataType, u8 channel);
+static bool configureStreamFilters(ERegisteringDataType dataType, u8 channel, EStreamFilterType filterType, u16 decimationFactor);
+static bool filterStreamSample(ERegisteringDataType dataType, u8 channel, float input, float* output);
+
+// Bulk segments program upload
+static u8 mExpectedProgramChunkIndex = 0;
+
+// Command script upload
+static u8 mExpectedScriptChunkIndex = 0;
+
+// State snapshot
+static void markSnapshotValue(TSnapshotResponse* response, u8 validBit, bool isValid, float* value, u32* timestamp);
+
+// Time synchronization
+static u32 mRequestReceiveTimestamp = 0;
+
+// Recording readout as bulk transfer source
+#define RECORDING_BULK_SAMPLE_SIZE 9
+
+static u8 mRecordingBulkUnitIds [READ_RECORDING_CHUNK_SIZE];
+static float mRecordingBulkValues [READ_RECORDING_CHUNK_SIZE];
+static u32 mRecordingBulkTimestamps [READ_RECORDING_CHUNK_SIZE];
+
+static u32 getRecordingBulkSize(void);
+static u16 readRecordingBulk(u32 offset, TByte* buffer, u16 size);
 
 // Delayed responses to Master
 
+static TRequestContext mCallibreADS1248Context;
+
 static void callibreADS1248ResponseCallback(EADS1248CallibrationType type, bool success);
 
 /****************************************************************************************************************************************************/
@@ -111,6 +173,7 @@ EVENT_HANDLER(DataFromMasterReceivedInd)
 void MasterDataManager_setup(void)
 {
     THREAD_INITIALIZE_MUTEX
+    mStreamFiltersMutexId = osMutexCreate(osMutex(mStreamFiltersMutex));
 }
 
 void MasterDataManager_initialize(void)
@@ -122,6 +185,11 @@ void MasterDataManager_initialize(void)
     //Logger_registerMasterMessageLogIndCallback(logIndCallback);
     SegmentsManager_registerSegmentsProgramDoneIndCallback(segmentsProgramDoneInd);
     SegmentsManager_registerSegmentStartedIndCallback(segmentStartedInd);
+    EmergencyStop_registerStopDoneIndCallback(emergencyStopDoneInd);
+    CommandScript_registerMarkerIndCallback(commandScriptMarkerInd);
+    CommandScript_registerScriptDoneIndCallback(commandScriptDoneInd);
+    SampleCarrierDataManager_registerConversionDescriptorCallback(sampleCarrierConversionDescriptorInd);
+    BulkTransfer_registerSource(EBulkTransferSource_Recording, getRecordingBulkSize, readRecordingBulk);
     
     Logger_info("%s: Initialized!", getLoggerPrefix());
     osMutexRelease(mMutexId);
@@ -131,92 +199,227 @@ void handleMasterData(TMessage* message)
 {
     Logger_debugSystem("%s: Handling Master message: %s.", getLoggerPrefix(), CStringConverter_EMessageId(message->id));
     
-    switch(message->id)
-    {
-        HANDLE_REQUEST(PollingRequest)
-        HANDLE_REQUEST(ResetUnitRequest)
-        HANDLE_REQUEST(SetHeaterPowerRequest)
-        HANDLE_REQUEST(CallibreADS1248Request)
-        HANDLE_REQUEST(SetChannelGainADS1248Request)
-        HANDLE_REQUEST(SetChannelSamplingSpeedADS1248Request)
-        HANDLE_REQUEST(StartRegisteringDataRequest)
-        HANDLE_REQUEST(StopRegisteringDataRequest)
-        HANDLE_REQUEST(SetNewDeviceModeADS1248Request)
-        HANDLE_REQUEST(SetNewDeviceModeLMP90100ControlSystemRequest)
-        HANDLE_REQUEST(SetNewDeviceModeLMP90100SignalsMeasurementRequest)
-        HANDLE_REQUEST(SetControlSystemTypeRequest)
-        HANDLE_REQUEST(SetControllerTunesRequest)
-        HANDLE_REQUEST(SetProcessModelParametersRequest)
-        HANDLE_REQUEST(SetControllingAlgorithmExecutionPeriodRequest)
-        HANDLE_REQUEST(RegisterNewSegmentToProgramRequest)
-        HANDLE_REQUEST(DeregisterSegmentFromProgramRequest)
-        HANDLE_REQUEST(StartSegmentProgramRequest)
-        HANDLE_REQUEST(StopSegmentProgramRequest)
-        HANDLE_REQUEST(StartReferenceTemperatureStabilizationRequest)
-        HANDLE_REQUEST(StopReferenceTemperatureStabilizationRequest)
-        HANDLE_REQUEST(SetRTDPolynomialCoefficientsRequest)
-        HANDLE_REQUEST(SetHeaterTemperatureInFeedbackModeRequest)
-        
-        default :
-            handleUnexpectedMessage(message->id);
-            break;
+    mRequestReceiveTimestamp = message->timestamp;
+    
+    TRequestContext context;
+    context.transactionId = message->transactionId;
+    context.isBroadcast = message->isBroadcast;
+    context.isStaged = isRequestStaged(message->id);
+    
+    EThreadId executor = getRequestExecutor(message->id, context.isStaged);
+    if (mThreadId == executor)
+    {
+        MasterDataManager_executeRequest(message, &context);
+        return;
+    }
+    
+    // Requests touching slow peripherals are queued to the subsystem worker, which sends the response when done.
+    TEvent* event = Event_calloc(executor, EEventId_DataFromMasterReceivedInd);
+    if ( (NULL == event) || (NULL == event->data) )
+    {
+        Event_free(executor, event);
+        rejectBusyRequest(message, &context, executor);
+        return;
+    }
+    
+    event->sender = mThreadId;
+    CopyObject_TMessage(message, &(((TEventMessageDataFromMasterReceivedInd*) ( event->data ))->message));
+    ((TEventMessageDataFromMasterReceivedInd*) ( event->data ))->context = context;
+    
+    if (osOK != Event_send(executor, event))
+    {
+        Event_free(executor, event);
+        rejectBusyRequest(message, &context, executor);
+    }
+}
+
+void rejectBusyRequest(TMessage* message, const TRequestContext* context, EThreadId executor)
+{
+    Logger_error("%s: Queue of %s is full, request %s (transaction %u) rejected.", getLoggerPrefix(), CStringConverter_EThreadId(executor), CStringConverter_EMessageId(message->id), message->transactionId);
+    
+    // No batch is opened, so requests following a rejected begin are routed as immediate again.
+    if (EMessageId_BeginConfigurationBatchRequest == message->id)
+    {
+        mIsConfigurationBatchDispatched = false;
+    }
+    
+    MasterUartGateway_indicateBusyRequest(message->id, context);
+    
+    MasterDataMemoryManager_free(message->id, message->data);
+    MasterUartGateway_returnRxCredit(message->id);
+}
+
+void MasterDataManager_executeRequest(TMessage* message, const TRequestContext* context)
+{
+    if ( (EMessageId_Limit > message->id) && (NULL != mRequestHandlers[message->id]) )
+    {
+        mRequestHandlers[message->id](message->data, context);
+    }
+    else
+    {
+        handleUnexpectedMessage(message->id, context);
     }
     
     Logger_debugSystem("%s: Request from Master proceeded and message %s will be freed.", getLoggerPrefix(), CStringConverter_EMessageId(message->id));
     MasterDataMemoryManager_free(message->id, message->data);
+    
+    // Master may send the next request only when a worker is free to take it, not as soon as the frame is decoded.
+    MasterUartGateway_returnRxCredit(message->id);
+}
+
+bool isRequestStaged(EMessageId messageId)
+{
+    // Staged or immediate is decided once, here, and travels with the request. The batch counts as closed as
+    // soon as its commit or abort is dispatched, although the worker executes them later.
+    switch (messageId)
+    {
+        case EMessageId_BeginConfigurationBatchRequest :
+            mIsConfigurationBatchDispatched = true;
+            return false;
+        
+        case EMessageId_CommitConfigurationBatchRequest :
+        case EMessageId_AbortConfigurationBatchRequest :
+            mIsConfigurationBatchDispatched = false;
+            return false;
+        
+        case EMessageId_SetChannelGainADS1248Request :
+        case EMessageId_SetChannelSamplingSpeedADS1248Request :
+        case EMessageId_SetNewDeviceModeADS1248Request :
+        case EMessageId_SetNewDeviceModeLMP90100ControlSystemRequest :
+        case EMessageId_SetNewDeviceModeLMP90100SignalsMeasurementRequest :
+        case EMessageId_SetControlSystemTypeRequest :
+        case EMessageId_SetControllerTunesRequest :
+        case EMessageId_SetControllingAlgorithmExecutionPeriodRequest :
+            return mIsConfigurationBatchDispatched;
+        
+        default :
+            return false;
+    }
+}
+
+EThreadId getRequestExecutor(EMessageId messageId, bool isStaged)
+{
+    // Staged requests and the batch begin and end share one worker queue, so the commit is executed
+    // only after every request staged before it, and a new batch only after the previous commit.
+    if (isStaged)
+    {
+        return EThreadId_MeasurementRequestsWorker;
+    }
+    
+    switch (messageId)
+    {
+        case EMessageId_CallibreADS1248Request :
+        case EMessageId_SetChannelGainADS1248Request :
+        case EMessageId_SetChannelSamplingSpeedADS1248Request :
+        case EMessageId_StartRegisteringDataRequest :
+        case EMessageId_StopRegisteringDataRequest :
+        case EMessageId_SetSampleStreamFormatRequest :
+        case EMessageId_SetNewDeviceModeADS1248Request :
+        case EMessageId_SetNewDeviceModeLMP90100ControlSystemRequest :
+        case EMessageId_SetNewDeviceModeLMP90100SignalsMeasurementRequest :
+        case EMessageId_BeginConfigurationBatchRequest :
+        case EMessageId_CommitConfigurationBatchRequest :
+        case EMessageId_AbortConfigurationBatchRequest :
+            return EThreadId_MeasurementRequestsWorker;
+        
+        case EMessageId_SetHeaterPowerRequest :
+        case EMessageId_SetControlSystemTypeRequest :
+        case EMessageId_SetControllerTunesRequest :
+        case EMessageId_SetProcessModelParametersRequest :
+        case EMessageId_SetControllingAlgorithmExecutionPeriodRequest :
+        case EMessageId_RegisterNewSegmentToProgramRequest :
+        case EMessageId_DeregisterSegmentFromProgramRequest :
+        case EMessageId_StartSegmentProgramRequest :
+        case EMessageId_StopSegmentProgramRequest :
+        case EMessageId_StartReferenceTemperatureStabilizationRequest :
+        case EMessageId_StopReferenceTemperatureStabilizationRequest :
+        case EMessageId_SetRTDPolynomialCoefficientsRequest :
+        case EMessageId_SetHeaterTemperatureInFeedbackModeRequest :
+        case EMessageId_LoadSegmentsProgramRequest :
+        case EMessageId_StartTrajectoryRequest :
+        case EMessageId_TrajectoryChunkRequest :
+        case EMessageId_StopTrajectoryRequest :
+        case EMessageId_LoadCommandScriptRequest :
+        case EMessageId_StartCommandScriptRequest :
+        case EMessageId_StopCommandScriptRequest :
+            return EThreadId_HeaterRequestsWorker;
+        
+        default :
+            return EThreadId_MasterDataManager;
+    }
 }
 
 // Requests from Master
-void handlePollingRequest(TPollingRequest* request)
+void handlePollingRequest(TPollingRequest* request, const TRequestContext* context)
 {
     TPollingResponse* response = MasterDataMemoryManager_allocate(EMessageId_PollingResponse);
     response->success = true;
-    MasterUartGateway_sendMessage(EMessageId_PollingResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_PollingResponse, response, context);
 }
 
-void handleResetUnitRequest(TResetUnitRequest* request)
+void handleResetUnitRequest(TResetUnitRequest* request, const TRequestContext* context)
 {
     TResetUnitResponse* response = MasterDataMemoryManager_allocate(EMessageId_ResetUnitResponse);
     response->success = false;
     response->unitId = request->unitId;
-    MasterUartGateway_sendMessage(EMessageId_ResetUnitResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_ResetUnitResponse, response, context);
 }
 
-void handleSetHeaterPowerRequest(TSetHeaterPowerRequest* request)
+void handleSetHeaterPowerRequest(TSetHeaterPowerRequest* request, const TRequestContext* context)
 {
     TSetHeaterPowerResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetHeaterPowerResponse);
     response->power = request->power;
     response->success = HeaterTemperatureController_setPowerInPercent(request->power);
-    MasterUartGateway_sendMessage(EMessageId_SetHeaterPowerResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetHeaterPowerResponse, response, context);
 }
 
-void handleCallibreADS1248Request(TCallibreADS1248Request* request)
+void handleCallibreADS1248Request(TCallibreADS1248Request* request, const TRequestContext* context)
 {
+    TRequestContext previousContext = mCallibreADS1248Context;
+    mCallibreADS1248Context = *context;
+    
     if (!ADS1248_startCallibration(request->callibrationType, callibreADS1248ResponseCallback))
     {
+        mCallibreADS1248Context = previousContext;
+        
         TCallibreADS1248Response* response = MasterDataMemoryManager_allocate(EMessageId_CallibreADS1248Response);
         response->callibrationType = request->callibrationType;
         response->success = false;
+        MasterUartGateway_sendResponse(EMessageId_CallibreADS1248Response, response, context);
     }
 }
 
-void handleSetChannelGainADS1248Request(TSetChannelGainADS1248Request* request)
+void handleSetChannelGainADS1248Request(TSetChannelGainADS1248Request* request, const TRequestContext* context)
 {
     TSetChannelGainADS1248Response* response = MasterDataMemoryManager_allocate(EMessageId_SetChannelGainADS1248Response);
     response->value = request->value;
-    response->success = ADS1248_setChannelGain(request->value);
-    MasterUartGateway_sendMessage(EMessageId_SetChannelGainADS1248Response, response);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageADS1248Gain(request->value);
+    }
+    else
+    {
+        response->success = ADS1248_setChannelGain(request->value);
+    }
+    MasterUartGateway_sendResponse(EMessageId_SetChannelGainADS1248Response, response, context);
 }
 
-void handleSetChannelSamplingSpeedADS1248Request(TSetChannelSamplingSpeedADS1248Request* request)
+void handleSetChannelSamplingSpeedADS1248Request(TSetChannelSamplingSpeedADS1248Request* request, const TRequestContext* context)
 {
     TSetChannelSamplingSpeedADS1248Response* response = MasterDataMemoryManager_allocate(EMessageId_SetChannelSamplingSpeedADS1248Response);
     response->value = request->value;
-    response->success = ADS1248_setChannelSamplingSpeed(request->value);
-    MasterUartGateway_sendMessage(EMessageId_SetChannelSamplingSpeedADS1248Response, response);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageADS1248SamplingSpeed(request->value);
+    }
+    else
+    {
+        response->success = ADS1248_setChannelSamplingSpeed(request->value);
+    }
+    MasterUartGateway_sendResponse(EMessageId_SetChannelSamplingSpeedADS1248Response, response, context);
 }
 
-void handleStartRegisteringDataRequest(TStartRegisteringDataRequest* request)
+void handleStartRegisteringDataRequest(TStartRegisteringDataRequest* request, const TRequestContext* context)
 {
     TStartRegisteringDataResponse* response = MasterDataMemoryManager_allocate(EMessageId_StartRegisteringDataResponse);
     
@@ -253,6 +456,7 @@ void handleStartRegisteringDataRequest(TStartRegisteringDataRequest* request)
             if (response->success)
             {
                 SampleCarrierDataManager_registerDataReadyCallback(sampleCarrierDataIndCallback);
+                SampleCarrierDataManager_registerRawDataReadyCallback(sampleCarrierRawDataIndCallback);
             }
             
             break;
@@ -264,14 +468,15 @@ void handleStartRegisteringDataRequest(TStartRegisteringDataRequest* request)
             HeaterTemperatureReader_registerNewTemperatureValueCallback(heaterTemperatureIndCallback, 1000U);
             ReferenceTemperatureReader_registerDataReadyCallback(referenceTemperatureIndCallback);
             SampleCarrierDataManager_registerDataReadyCallback(sampleCarrierDataIndCallback);
+            SampleCarrierDataManager_registerRawDataReadyCallback(sampleCarrierRawDataIndCallback);
             break;
         }
     }
     
-    MasterUartGateway_sendMessage(EMessageId_StartRegisteringDataResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_StartRegisteringDataResponse, response, context);
 }
 
-void handleStopRegisteringDataRequest(TStopRegisteringDataRequest* request)
+void handleStopRegisteringDataRequest(TStopRegisteringDataRequest* request, const TRequestContext* context)
 {
     TStopRegisteringDataResponse* response = MasterDataMemoryManager_allocate(EMessageId_StopRegisteringDataResponse);
     
@@ -301,6 +506,7 @@ void handleStopRegisteringDataRequest(TStopRegisteringDataRequest* request)
         case ERegisteringDataType_SampleCarrierData :
         {
             SampleCarrierDataManager_deregisterDataReadyCallback();
+            SampleCarrierDataManager_deregisterRawDataReadyCallback();
             break;
         }
         
@@ -310,92 +516,198 @@ void handleStopRegisteringDataRequest(TStopRegisteringDataRequest* request)
             HeaterTemperatureReader_deregisterNewTemperatureValueCallback();
             ReferenceTemperatureReader_deregisterDataReadyCallback();
             SampleCarrierDataManager_deregisterDataReadyCallback();
+            SampleCarrierDataManager_deregisterRawDataReadyCallback();
             break;
         }
     }
     
-    MasterUartGateway_sendMessage(EMessageId_StopRegisteringDataResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_StopRegisteringDataResponse, response, context);
 }
 
-void handleSetNewDeviceModeADS1248Request(TSetNewDeviceModeADS1248Request* request)
+void handleSetSampleStreamFormatRequest(TSetSampleStreamFormatRequest* request, const TRequestContext* context)
+{
+    TSetSampleStreamFormatResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetSampleStreamFormatResponse);
+    response->success = SampleCarrierDataManager_setStreamFormat(request->format);
+    response->format = SampleCarrierDataManager_getStreamFormat();
+    MasterUartGateway_sendResponse(EMessageId_SetSampleStreamFormatResponse, response, context);
+}
+
+void handleSetNewDeviceModeADS1248Request(TSetNewDeviceModeADS1248Request* request, const TRequestContext* context)
 {
     TSetNewDeviceModeADS1248Response* response = MasterDataMemoryManager_allocate(EMessageId_SetNewDeviceModeADS1248Response);
     
     response->mode = request->mode;
-    response->success = ADS1248_changeMode(request->mode);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageADS1248Mode(request->mode);
+    }
+    else
+    {
+        response->success = ADS1248_changeMode(request->mode);
+    }
     
-    MasterUartGateway_sendMessage(EMessageId_SetNewDeviceModeADS1248Response, response);
+    MasterUartGateway_sendResponse(EMessageId_SetNewDeviceModeADS1248Response, response, context);
 }
 
-void handleSetNewDeviceModeLMP90100ControlSystemRequest(TSetNewDeviceModeLMP90100ControlSystemRequest* request)
+void handleSetNewDeviceModeLMP90100ControlSystemRequest(TSetNewDeviceModeLMP90100ControlSystemRequest* request, const TRequestContext* context)
 {
     TSetNewDeviceModeLMP90100ControlSystemResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetNewDeviceModeLMP90100ControlSystemResponse);
     
     response->mode = request->mode;
-    response->success = LMP90100ControlSystem_changeMode(request->mode);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageLMP90100ControlSystemMode(request->mode);
+    }
+    else
+    {
+        response->success = LMP90100ControlSystem_changeMode(request->mode);
+    }
     
-    MasterUartGateway_sendMessage(EMessageId_SetNewDeviceModeLMP90100ControlSystemResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetNewDeviceModeLMP90100ControlSystemResponse, response, context);
 }
 
-void handleSetNewDeviceModeLMP90100SignalsMeasurementRequest(TSetNewDeviceModeLMP90100SignalsMeasurementRequest* request)
+void handleSetNewDeviceModeLMP90100SignalsMeasurementRequest(TSetNewDeviceModeLMP90100SignalsMeasurementRequest* request, const TRequestContext* context)
 {
     TSetNewDeviceModeLMP90100SignalsMeasurementResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetNewDeviceModeLMP90100SignalsMeasurementResponse);
     
     response->mode = request->mode;
-    response->success = LMP90100SignalsMeasurement_changeMode(request->mode);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageLMP90100SignalsMeasurementMode(request->mode);
+    }
+    else
+    {
+        response->success = LMP90100SignalsMeasurement_changeMode(request->mode);
+    }
     
-    MasterUartGateway_sendMessage(EMessageId_SetNewDeviceModeLMP90100SignalsMeasurementResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetNewDeviceModeLMP90100SignalsMeasurementResponse, response, context);
 }
 
-void handleSetControlSystemTypeRequest(TSetControlSystemTypeRequest* request)
+void handleSetControlSystemTypeRequest(TSetControlSystemTypeRequest* request, const TRequestContext* context)
 {
     TSetControlSystemTypeResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetControlSystemTypeResponse);
     
     response->type = request->type;
-    response->success = HeaterTemperatureController_setSystemType(request->type);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageControlSystemType(request->type);
+    }
+    else
+    {
+        response->success = HeaterTemperatureController_setSystemType(request->type);
+    }
     
-    MasterUartGateway_sendMessage(EMessageId_SetControlSystemTypeResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetControlSystemTypeResponse, response, context);
 }
 
-void handleSetControllerTunesRequest(TSetControllerTunesRequest* request)
+void handleSetControllerTunesRequest(TSetControllerTunesRequest* request, const TRequestContext* context)
 {
     TSetControllerTunesResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetControllerTunesResponse);
     response->pid = request->pid;
-    response->success = HeaterTemperatureController_setTunes(request->pid, &(request->tunes));
-    MasterUartGateway_sendMessage(EMessageId_SetControllerTunesResponse, response);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageControllerTunes(request->pid, &(request->tunes));
+    }
+    else
+    {
+        response->success = HeaterTemperatureController_setTunes(request->pid, &(request->tunes));
+    }
+    MasterUartGateway_sendResponse(EMessageId_SetControllerTunesResponse, response, context);
 }
 
-void handleSetProcessModelParametersRequest(TSetProcessModelParametersRequest* request)
+void handleSetProcessModelParametersRequest(TSetProcessModelParametersRequest* request, const TRequestContext* context)
 {
     TSetProcessModelParametersResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetProcessModelParametersResponse);
     
     response->parameters = request->parameters;
     response->success = HeaterTemperatureController_setProcessModelParameters(&(request->parameters));
     
-    MasterUartGateway_sendMessage(EMessageId_SetProcessModelParametersResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetProcessModelParametersResponse, response, context);
 }
 
-void handleSetControllingAlgorithmExecutionPeriodRequest(TSetControllingAlgorithmExecutionPeriodRequest* request)
+void handleSetControllingAlgorithmExecutionPeriodRequest(TSetControllingAlgorithmExecutionPeriodRequest* request, const TRequestContext* context)
 {
     TSetControllingAlgorithmExecutionPeriodResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetControllingAlgorithmExecutionPeriodResponse);
     
     response->value = request->value;
-    response->success = HeaterTemperatureController_setAlgorithmExecutionPeriod(request->value);
+    if (context->isStaged)
+    {
+        response->success = ConfigurationBatch_stageAlgorithmExecutionPeriod(request->value);
+    }
+    else
+    {
+        response->success = HeaterTemperatureController_setAlgorithmExecutionPeriod(request->value);
+    }
     
-    MasterUartGateway_sendMessage(EMessageId_SetControllingAlgorithmExecutionPeriodResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetControllingAlgorithmExecutionPeriodResponse, response, context);
 }
 
-void handleRegisterNewSegmentToProgramRequest(TRegisterNewSegmentToProgramRequest* request)
+void handleRegisterNewSegmentToProgramRequest(TRegisterNewSegmentToProgramRequest* request, const TRequestContext* context)
 {
     TRegisterNewSegmentToProgramResponse* response = MasterDataMemoryManager_allocate(EMessageId_RegisterNewSegmentToProgramResponse);
     
     response->segmentNumber = request->segment.number;
     response->success = SegmentsManager_registerNewSegment(&(request->segment));
     
-    MasterUartGateway_sendMessage(EMessageId_RegisterNewSegmentToProgramResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_RegisterNewSegmentToProgramResponse, response, context);
 }
 
-void handleDeregisterSegmentFromProgramRequest(TDeregisterSegmentFromProgramRequest* request)
+void handleLoadSegmentsProgramRequest(TLoadSegmentsProgramRequest* request, const TRequestContext* context)
+{
+    TLoadSegmentsProgramResponse* response = MasterDataMemoryManager_allocate(EMessageId_LoadSegmentsProgramResponse);
+    
+    response->chunkIndex = request->chunkIndex;
+    response->success = true;
+    
+    if (0 == request->chunkIndex)
+    {
+        mExpectedProgramChunkIndex = 0;
+        SegmentsManager_startProgramUpload();
+    }
+    
+    if ( (mExpectedProgramChunkIndex != request->chunkIndex) || (request->chunkIndex >= request->chunksCount) )
+    {
+        Logger_error("%s: Unexpected segments program chunk %u/%u (expected %u).", getLoggerPrefix(), request->chunkIndex, request->chunksCount, mExpectedProgramChunkIndex);
+        response->success = false;
+    }
+    
+    for (u8 iter = 0; response->success && (request->segmentsCount > iter); ++iter)
+    {
+        SSegmentData segment;
+        segment.number = request->numbers[iter];
+        segment.type = (ESegmentType) ( request->types[iter] );
+        segment.startTemperature = request->startTemperatures[iter];
+        segment.stopTemperature = request->stopTemperatures[iter];
+        segment.settingTimeInterval = request->settingTimeIntervals[iter];
+        segment.temperatureStep = request->temperatureSteps[iter];
+        
+        response->success = SegmentsManager_uploadSegment(&segment);
+    }
+    
+    response->isProgramApplied = false;
+    
+    if (!response->success)
+    {
+        SegmentsManager_abortProgramUpload();
+        mExpectedProgramChunkIndex = 0;
+    }
+    else if (request->chunksCount == request->chunkIndex + 1)
+    {
+        response->success = SegmentsManager_commitProgramUpload();
+        response->isProgramApplied = response->success;
+        mExpectedProgramChunkIndex = 0;
+    }
+    else
+    {
+        ++mExpectedProgramChunkIndex;
+    }
+    
+    response->loadedSegmentsCount = SegmentsManager_getNumberOfRegisteredSegments();
+    
+    MasterUartGateway_sendResponse(EMessageId_LoadSegmentsProgramResponse, response, context);
+}
+
+void handleDeregisterSegmentFromProgramRequest(TDeregisterSegmentFromProgramRequest* request, const TRequestContext* context)
 {
     TDeregisterSegmentFromProgramResponse* response = MasterDataMemoryManager_allocate(EMessageId_DeregisterSegmentFromProgramResponse);
     
@@ -403,10 +715,10 @@ void handleDeregisterSegmentFromProgramRequest(TDeregisterSegmentFromProgramRequ
     response->success = SegmentsManager_deregisterSegment(request->segmentNumber);
     response->numberOfRegisteredSegments = SegmentsManager_getNumberOfRegisteredSegments();
     
-    MasterUartGateway_sendMessage(EMessageId_DeregisterSegmentFromProgramResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_DeregisterSegmentFromProgramResponse, response, context);
 }
 
-void handleStartSegmentProgramRequest(TStartSegmentProgramRequest* request)
+void handleStartSegmentProgramRequest(TStartSegmentProgramRequest* request, const TRequestContext* context)
 {
     TStartSegmentProgramResponse* response = MasterDataMemoryManager_allocate(EMessageId_StartSegmentProgramResponse);
     
@@ -419,10 +731,10 @@ void handleStartSegmentProgramRequest(TStartSegmentProgramRequest* request)
         response->success = SegmentsManager_startProgram();
     }
     
-    MasterUartGateway_sendMessage(EMessageId_StartSegmentProgramResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_StartSegmentProgramResponse, response, context);
 }
 
-void handleStopSegmentProgramRequest(TStopSegmentProgramRequest* request)
+void handleStopSegmentProgramRequest(TStopSegmentProgramRequest* request, const TRequestContext* context)
 {
     TStopSegmentProgramResponse* response = MasterDataMemoryManager_allocate(EMessageId_StopSegmentProgramResponse);
     
@@ -432,20 +744,20 @@ void handleStopSegmentProgramRequest(TStopSegmentProgramRequest* request)
         response->success = SegmentsManager_stopProgram();
     }
     
-    MasterUartGateway_sendMessage(EMessageId_StopSegmentProgramResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_StopSegmentProgramResponse, response, context);
 }
 
-void handleStartReferenceTemperatureStabilizationRequest(TStartReferenceTemperatureStabilizationRequest* request)
+void handleStartReferenceTemperatureStabilizationRequest(TStartReferenceTemperatureStabilizationRequest* request, const TRequestContext* context)
 {
     TStartReferenceTemperatureStabilizationResponse* response =
         MasterDataMemoryManager_allocate(EMessageId_StartReferenceTemperatureStabilizationResponse);
     
+    // Refused by the controller itself while emergency stop latch is set.
     response->success = ReferenceTemperatureController_startStabilization();
-    
-    MasterUartGateway_sendMessage(EMessageId_StartReferenceTemperatureStabilizationResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_StartReferenceTemperatureStabilizationResponse, response, context);
 }
 
-void handleStopReferenceTemperatureStabilizationRequest(TStopReferenceTemperatureStabilizationRequest* request)
+void handleStopReferenceTemperatureStabilizationRequest(TStopReferenceTemperatureStabilizationRequest* request, const TRequestContext* context)
 {
     TStopReferenceTemperatureStabilizationResponse* response =
         MasterDataMemoryManager_allocate(EMessageId_StopReferenceTemperatureStabilizationResponse);
@@ -453,20 +765,20 @@ void handleStopReferenceTemperatureStabilizationRequest(TStopReferenceTemperatur
     ReferenceTemperatureController_stopStabilization();
     response->success = true;
     
-    MasterUartGateway_sendMessage(EMessageId_StopReferenceTemperatureStabilizationResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_StopReferenceTemperatureStabilizationResponse, response, context);
 }
 
-void handleSetRTDPolynomialCoefficientsRequest(TSetRTDPolynomialCoefficientsRequest* request)
+void handleSetRTDPolynomialCoefficientsRequest(TSetRTDPolynomialCoefficientsRequest* request, const TRequestContext* context)
 {
     TSetRTDPolynomialCoefficientsResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetRTDPolynomialCoefficientsResponse);
     
     SampleCarrierManager_setRTDPolynomialCoefficients(&(request->coefficients));
     response->success = true;
     
-    MasterUartGateway_sendMessage(EMessageId_SetRTDPolynomialCoefficientsResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetRTDPolynomialCoefficientsResponse, response, context);
 }
 
-void handleSetHeaterTemperatureInFeedbackModeRequest(TSetHeaterTemperatureInFeedbackModeRequest* request)
+void handleSetHeaterTemperatureInFeedbackModeRequest(TSetHeaterTemperatureInFeedbackModeRequest* request, const TRequestContext* context)
 {
     TSetHeaterTemperatureInFeedbackModeResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetHeaterTemperatureInFeedbackModeResponse);
     
@@ -475,14 +787,420 @@ void handleSetHeaterTemperatureInFeedbackModeRequest(TSetHeaterTemperatureInFeed
     HeaterTemperatureController_enableDerivativeElement(EPid_ProcessController);
     response->success = HeaterTemperatureController_setTemperature(request->temperature);
     
-    MasterUartGateway_sendMessage(EMessageId_SetHeaterTemperatureInFeedbackModeResponse, response);
+    MasterUartGateway_sendResponse(EMessageId_SetHeaterTemperatureInFeedbackModeResponse, response, context);
 }
 
-void handleUnexpectedMessage(u8 messageId)
+void handleSetFramingModeRequest(TSetFramingModeRequest* request, const TRequestContext* context)
+{
+    TSetFramingModeResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetFramingModeResponse);
+    
+    response->mode = request->mode;
+    response->success = MasterUartGateway_changeFramingMode(request->mode);
+    
+    MasterUartGateway_sendResponse(EMessageId_SetFramingModeResponse, response, context);
+}
+
+void handleSetBaudRateRequest(TSetBaudRateRequest* request, const TRequestContext* context)
+{
+    TSetBaudRateResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetBaudRateResponse);
+    
+    response->baudRate = request->baudRate;
+    response->success = MasterUartGateway_changeBaudRate(request->baudRate);
+    
+    MasterUartGateway_sendResponse(EMessageId_SetBaudRateResponse, response, context);
+}
+
+void handleSetStreamFilterRequest(TSetStreamFilterRequest* request, const TRequestContext* context)
+{
+    TSetStreamFilterResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetStreamFilterResponse);
+    
+    response->dataType = request->dataType;
+    response->channel = request->channel;
+    response->success = configureStreamFilters(request->dataType, request->channel, request->filterType, request->decimationFactor);
+    
+    Logger_info
+    (
+        "%s: %s filter with decimation factor %u for %s stream (channel %u) %s.",
+        getLoggerPrefix(),
+        CStringConverter_EStreamFilterType(request->filterType),
+        request->decimationFactor,
+        CStringConverter_ERegisteringDataType(request->dataType),
+        request->channel,
+        response->success ? "configured" : "rejected"
+    );
+    
+    MasterUartGateway_sendResponse(EMessageId_SetStreamFilterResponse, response, context);
+}
+
+void handleSetReliableDeliveryRequest(TSetReliableDeliveryRequest* request, const TRequestContext* context)
+{
+    TSetReliableDeliveryResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetReliableDeliveryResponse);
+    
+    response->enabled = request->enabled;
+    response->success = MasterUartGateway_changeReliableDelivery(request->enabled);
+    
+    MasterUartGateway_sendResponse(EMessageId_SetReliableDeliveryResponse, response, context);
+}
+
+void handleSetFlowControlRequest(TSetFlowControlRequest* request, const TRequestContext* context)
+{
+    TSetFlowControlResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetFlowControlResponse);
+    
+    response->enabled = request->enabled;
+    response->rxCredits = 0;
+    response->success = MasterUartGateway_changeFlowControl(request->enabled, request->initialCredits, &(response->rxCredits));
+    
+    MasterUartGateway_sendResponse(EMessageId_SetFlowControlResponse, response, context);
+}
+
+void handleSnapshotRequest(TSnapshotRequest* request, const TRequestContext* context)
+{
+    TSnapshotResponse* response = MasterDataMemoryManager_allocate(EMessageId_SnapshotResponse);
+    
+    // Every field comes from a wait-free snapshot published by its producer, so no subsystem mutex is taken here.
+    // A value which has never been published or could not be read consistently has its bit in validValuesMask cleared,
+    // its value and timestamp zeroed. Timestamps are in the same master converted microsecond timebase as the streams.
+    response->validValuesMask = 0;
+    
+    bool isValid = HeaterTemperatureReader_readTemperatureSnapshot(&(response->heaterTemperature), &(response->heaterTemperatureTimestamp));
+    markSnapshotValue(response, SNAPSHOT_VALID_HEATER_TEMPERATURE_BIT, isValid, &(response->heaterTemperature), &(response->heaterTemperatureTimestamp));
+    
+    isValid = ReferenceTemperatureReader_readTemperatureSnapshot(&(response->referenceTemperature), &(response->referenceTemperatureTimestamp));
+    markSnapshotValue(response, SNAPSHOT_VALID_REFERENCE_TEMPERATURE_BIT, isValid, &(response->referenceTemperature), &(response->referenceTemperatureTimestamp));
+    
+    for (u8 iter = 0; SNAPSHOT_CONTROLLER_DATA_COUNT > iter; ++iter)
+    {
+        isValid = HeaterTemperatureController_readControllerDataSnapshot((EControllerDataType) iter, &(response->controllerData[iter]), &(response->controllerDataTimestamps[iter]));
+        markSnapshotValue(response, SNAPSHOT_VALID_CONTROLLER_DATA_FIRST_BIT + iter, isValid, &(response->controllerData[iter]), &(response->controllerDataTimestamps[iter]));
+    }
+    
+    isValid = MCP4716_readOutputVoltageSnapshot(&(response->dacOutputVoltage), &(response->dacOutputVoltageTimestamp));
+    markSnapshotValue(response, SNAPSHOT_VALID_DAC_OUTPUT_VOLTAGE_BIT, isValid, &(response->dacOutputVoltage), &(response->dacOutputVoltageTimestamp));
+    
+    for (u8 iter = 0; SNAPSHOT_SAMPLE_CARRIER_UNITS_COUNT > iter; ++iter)
+    {
+        isValid = SampleCarrierDataManager_readSnapshot((EUnitId) (EUnitId_RtdPt1000 + iter), &(response->sampleCarrierValues[iter]), &(response->sampleCarrierTimestamps[iter]));
+        markSnapshotValue(response, SNAPSHOT_VALID_SAMPLE_CARRIER_FIRST_BIT + iter, isValid, &(response->sampleCarrierValues[iter]), &(response->sampleCarrierTimestamps[iter]));
+    }
+    
+    if (SegmentsManager_readProgramStatusSnapshot(&(response->isProgramRunning), &(response->currentSegmentNumber), &(response->registeredSegmentsCount), &(response->programStatusTimestamp)))
+    {
+        response->validValuesMask |= ( 1U << SNAPSHOT_VALID_PROGRAM_STATUS_BIT );
+        response->programStatusTimestamp = TimeSynchronizer_convertTimestamp(response->programStatusTimestamp);
+    }
+    else
+    {
+        response->isProgramRunning = false;
+        response->currentSegmentNumber = 0;
+        response->registeredSegmentsCount = 0;
+        response->programStatusTimestamp = 0;
+    }
+    
+    response->assemblyTimestamp = TimeSynchronizer_convertTimestamp(TIM2_getMicroseconds());
+    
+    MasterUartGateway_sendResponse(EMessageId_SnapshotResponse, response, context);
+}
+
+void handleStartRecordingRequest(TStartRecordingRequest* request, const TRequestContext* context)
+{
+    TStartRecordingResponse* response = MasterDataMemoryManager_allocate(EMessageId_StartRecordingResponse);
+    response->success = SampleRecorder_start(request->capacity, &(response->capacity));
+    MasterUartGateway_sendResponse(EMessageId_StartRecordingResponse, response, context);
+}
+
+void handleStopRecordingRequest(TStopRecordingRequest* request, const TRequestContext* context)
+{
+    TStopRecordingResponse* response = MasterDataMemoryManager_allocate(EMessageId_StopRecordingResponse);
+    response->success = SampleRecorder_stop(&(response->recordedSamplesCount), &(response->overwrittenSamplesCount));
+    MasterUartGateway_sendResponse(EMessageId_StopRecordingResponse, response, context);
+}
+
+void handleReadRecordingRequest(TReadRecordingRequest* request, const TRequestContext* context)
+{
+    // Burst readout: up to READ_RECORDING_MAX_CHUNKS_COUNT consecutive chunks are queued at once,
+    // the last chunk is the one with samplesCount lower than READ_RECORDING_CHUNK_SIZE.
+    const u16 recordedSamplesCount = SampleRecorder_getRecordedSamplesCount();
+    const u8 chunksCount = ( (0 == request->chunksCount) || (READ_RECORDING_MAX_CHUNKS_COUNT < request->chunksCount) ) ? READ_RECORDING_MAX_CHUNKS_COUNT : request->chunksCount;
+    u16 sampleIndex = request->firstSampleIndex;
+    
+    for (u8 chunk = 0; chunksCount > chunk; ++chunk)
+    {
+        TReadRecordingResponse* response = MasterDataMemoryManager_allocate(EMessageId_ReadRecordingResponse);
+        if (NULL == response)
+        {
+            break;
+        }
+        
+        response->firstSampleIndex = sampleIndex;
+        response->recordedSamplesCount = recordedSamplesCount;
+        response->samplesCount = SampleRecorder_read(sampleIndex, READ_RECORDING_CHUNK_SIZE, response->unitIds, response->values, response->timestamps);
+        sampleIndex += response->samplesCount;
+        
+        for (u8 iter = 0; response->samplesCount > iter; ++iter)
+        {
+            response->timestamps[iter] = TimeSynchronizer_convertTimestamp(response->timestamps[iter]);
+        }
+        
+        const bool isLastChunk = ( READ_RECORDING_CHUNK_SIZE > response->samplesCount );
+        MasterUartGateway_sendResponse(EMessageId_ReadRecordingResponse, response, context);
+        
+        if (isLastChunk)
+        {
+            break;
+        }
+    }
+}
+
+void handleStartBulkTransferRequest(TStartBulkTransferRequest* request, const TRequestContext* context)
+{
+    TStartBulkTransferResponse* response = MasterDataMemoryManager_allocate(EMessageId_StartBulkTransferResponse);
+    
+    response->source = request->source;
+    response->transferId = 0;
+    response->totalSize = 0;
+    response->success = BulkTransfer_start(request->source, request->offset, context, &(response->transferId), &(response->totalSize));
+    
+    MasterUartGateway_sendResponse(EMessageId_StartBulkTransferResponse, response, context);
+}
+
+void handleLoadCommandScriptRequest(TLoadCommandScriptRequest* request, const TRequestContext* context)
+{
+    TLoadCommandScriptResponse* response = MasterDataMemoryManager_allocate(EMessageId_LoadCommandScriptResponse);
+    
+    response->chunkIndex = request->chunkIndex;
+    response->success = true;
+    
+    if (0 == request->chunkIndex)
+    {
+        mExpectedScriptChunkIndex = 0;
+        CommandScript_startUpload();
+    }
+    
+    if ( (mExpectedScriptChunkIndex != request->chunkIndex) || (request->chunkIndex >= request->chunksCount) )
+    {
+        Logger_error("%s: Unexpected command script chunk %u/%u (expected %u).", getLoggerPrefix(), request->chunkIndex, request->chunksCount, mExpectedScriptChunkIndex);
+        response->success = false;
+    }
+    else
+    {
+        response->success = CommandScript_uploadChunk(request->code, request->length);
+    }
+    
+    response->isScriptApplied = false;
+    
+    if (!response->success)
+    {
+        CommandScript_abortUpload();
+        mExpectedScriptChunkIndex = 0;
+    }
+    else if (request->chunksCount == request->chunkIndex + 1)
+    {
+        response->success = CommandScript_commitUpload();
+        response->isScriptApplied = response->success;
+        mExpectedScriptChunkIndex = 0;
+    }
+    else
+    {
+        ++mExpectedScriptChunkIndex;
+    }
+    
+    response->loadedLength = CommandScript_getLoadedLength();
+    
+    MasterUartGateway_sendResponse(EMessageId_LoadCommandScriptResponse, response, context);
+}
+
+void handleStartCommandScriptRequest(TStartCommandScriptRequest* request, const TRequestContext* context)
+{
+    TStartCommandScriptResponse* response = MasterDataMemoryManager_allocate(EMessageId_StartCommandScriptResponse);
+    response->success = CommandScript_start();
+    MasterUartGateway_sendResponse(EMessageId_StartCommandScriptResponse, response, context);
+}
+
+void handleStopCommandScriptRequest(TStopCommandScriptRequest* request, const TRequestContext* context)
+{
+    TStopCommandScriptResponse* response = MasterDataMemoryManager_allocate(EMessageId_StopCommandScriptResponse);
+    response->success = CommandScript_stop();
+    MasterUartGateway_sendResponse(EMessageId_StopCommandScriptResponse, response, context);
+}
+
+void markSnapshotValue(TSnapshotResponse* response, u8 validBit, bool isValid, float* value, u32* timestamp)
+{
+    if (isValid)
+    {
+        response->validValuesMask |= ( 1U << validBit );
+        *timestamp = TimeSynchronizer_convertTimestamp(*timestamp);
+    }
+    else
+    {
+        *value = 0.0f;
+        *timestamp = 0;
+    }
+}
+
+u32 getRecordingBulkSize(void)
+{
+    return ( (u32) SampleRecorder_getRecordedSamplesCount() ) * RECORDING_BULK_SAMPLE_SIZE;
+}
+
+u16 readRecordingBulk(u32 offset, TByte* buffer, u16 size)
+{
+    // Each sample is packed as unit id (u8), value (f32) and timestamp in Master time (u32), little-endian.
+    if (0 != ( offset % RECORDING_BULK_SAMPLE_SIZE ))
+    {
+        return 0;
+    }
+    
+    u16 sampleIndex = (u16) ( offset / RECORDING_BULK_SAMPLE_SIZE );
+    u16 samplesLeft = size / RECORDING_BULK_SAMPLE_SIZE;
+    u16 length = 0;
+    
+    while (0 < samplesLeft)
+    {
+        u8 samplesCount = SampleRecorder_read(sampleIndex, ( READ_RECORDING_CHUNK_SIZE < samplesLeft ) ? READ_RECORDING_CHUNK_SIZE : (u8) samplesLeft, mRecordingBulkUnitIds, mRecordingBulkValues, mRecordingBulkTimestamps);
+        if (0 == samplesCount)
+        {
+            break;
+        }
+        
+        for (u8 iter = 0; samplesCount > iter; ++iter)
+        {
+            u32 value;
+            memcpy(&value, &(mRecordingBulkValues[iter]), sizeof(value));
+            u32 timestamp = TimeSynchronizer_convertTimestamp(mRecordingBulkTimestamps[iter]);
+            
+            buffer[length++] = mRecordingBulkUnitIds[iter];
+            for (u8 byte = 0; sizeof(u32) > byte; ++byte)
+            {
+                buffer[length++] = (TByte) ( ( value >> (8 * byte) ) & 0xFF );
+            }
+            for (u8 byte = 0; sizeof(u32) > byte; ++byte)
+            {
+                buffer[length++] = (TByte) ( ( timestamp >> (8 * byte) ) & 0xFF );
+            }
+        }
+        
+        sampleIndex += samplesCount;
+        samplesLeft -= samplesCount;
+    }
+    
+    return length;
+}
+
+void handleTimeSyncRequest(TTimeSyncRequest* request, const TRequestContext* context)
+{
+    TTimeSyncResponse* response = MasterDataMemoryManager_allocate(EMessageId_TimeSyncResponse);
+    
+    response->masterTransmitTimestamp = request->masterTransmitTimestamp;
+    response->deviceReceiveTimestamp = mRequestReceiveTimestamp;
+    response->previousDeviceTransmitTimestamp = TimeSynchronizer_handleExchange(request->masterTransmitTimestamp, request->previousMasterReceiveTimestamp, mRequestReceiveTimestamp);
+    response->isSynchronized = TimeSynchronizer_getEstimate(&(response->offset), &(response->skewPpm));
+    TimeSynchronizer_setMasterTimeReporting(request->isMasterTimeReportingEnabled);
+    
+    MasterUartGateway_sendResponse(EMessageId_TimeSyncResponse, response, context);
+}
+
+void handleSetUnitAddressRequest(TSetUnitAddressRequest* request, const TRequestContext* context)
+{
+    TSetUnitAddressResponse* response = MasterDataMemoryManager_allocate(EMessageId_SetUnitAddressResponse);
+    
+    response->success = MasterUartGateway_changeUnitAddress(request->address);
+    response->address = MasterUartGateway_getUnitAddress();
+    
+    MasterUartGateway_sendResponse(EMessageId_SetUnitAddressResponse, response, context);
+}
+
+void handleLinkStatisticsRequest(TLinkStatisticsRequest* request, const TRequestContext* context)
+{
+    TLinkStatisticsResponse* response = MasterDataMemoryManager_allocate(EMessageId_LinkStatisticsResponse);
+    
+    LinkStatistics_read(response->counters, &(response->txQueueHighWaterMark), &(response->meanTxLatency), &(response->maxTxLatency));
+    
+    if (request->reset)
+    {
+        LinkStatistics_reset();
+    }
+    
+    response->isReset = request->reset;
+    
+    MasterUartGateway_sendResponse(EMessageId_LinkStatisticsResponse, response, context);
+}
+
+void handleStartTrajectoryRequest(TStartTrajectoryRequest* request, const TRequestContext* context)
+{
+    TStartTrajectoryResponse* response = MasterDataMemoryManager_allocate(EMessageId_StartTrajectoryResponse);
+    
+    response->success = SetPointTrajectory_start(request->underrunPolicy, request->prebufferTime);
+    
+    MasterUartGateway_sendResponse(EMessageId_StartTrajectoryResponse, response, context);
+}
+
+void handleTrajectoryChunkRequest(TTrajectoryChunkRequest* request, const TRequestContext* context)
+{
+    TTrajectoryChunkResponse* response = MasterDataMemoryManager_allocate(EMessageId_TrajectoryChunkResponse);
+    
+    response->success = SetPointTrajectory_appendPoints(request->firstPointIndex, request->pointsCount, request->times, request->temperatures, request->isLastChunk);
+    SetPointTrajectory_getBufferStatus(&(response->nextPointIndex), &(response->bufferedPointsCount), &(response->freePointsCount));
+    
+    MasterUartGateway_sendResponse(EMessageId_TrajectoryChunkResponse, response, context);
+}
+
+void handleStopTrajectoryRequest(TStopTrajectoryRequest* request, const TRequestContext* context)
+{
+    TStopTrajectoryResponse* response = MasterDataMemoryManager_allocate(EMessageId_StopTrajectoryResponse);
+    
+    response->underrunsCount = 0;
+    response->success = SetPointTrajectory_stop(&(response->underrunsCount));
+    
+    MasterUartGateway_sendResponse(EMessageId_StopTrajectoryResponse, response, context);
+}
+
+void handleBeginConfigurationBatchRequest(TBeginConfigurationBatchRequest* request, const TRequestContext* context)
+{
+    TBeginConfigurationBatchResponse* response = MasterDataMemoryManager_allocate(EMessageId_BeginConfigurationBatchResponse);
+    
+    // Requests following the begin were routed as staged when it was dispatched, see isRequestStaged(). Master is told
+    // the begin failed, so the requests it sends next are routed as immediate.
+    response->success = ConfigurationBatch_begin();
+    if (!response->success)
+    {
+        mIsConfigurationBatchDispatched = false;
+    }
+    
+    MasterUartGateway_sendResponse(EMessageId_BeginConfigurationBatchResponse, response, context);
+}
+
+void handleCommitConfigurationBatchRequest(TCommitConfigurationBatchRequest* request, const TRequestContext* context)
+{
+    TCommitConfigurationBatchResponse* response = MasterDataMemoryManager_allocate(EMessageId_CommitConfigurationBatchResponse);
+    
+    response->success = ConfigurationBatch_commit(&(response->stagedChangesCount), &(response->appliedChangesCount));
+    
+    MasterUartGateway_sendResponse(EMessageId_CommitConfigurationBatchResponse, response, context);
+}
+
+void handleAbortConfigurationBatchRequest(TAbortConfigurationBatchRequest* request, const TRequestContext* context)
+{
+    TAbortConfigurationBatchResponse* response = MasterDataMemoryManager_allocate(EMessageId_AbortConfigurationBatchResponse);
+    
+    response->success = ConfigurationBatch_abort(&(response->discardedChangesCount));
+    
+    MasterUartGateway_sendResponse(EMessageId_AbortConfigurationBatchResponse, response, context);
+}
+
+void handleClearEmergencyStopRequest(TClearEmergencyStopRequest* request, const TRequestContext* context)
+{
+    TClearEmergencyStopResponse* response = MasterDataMemoryManager_allocate(EMessageId_ClearEmergencyStopResponse);
+    
+    response->success = EmergencyStop_clear();
+    
+    MasterUartGateway_sendResponse(EMessageId_ClearEmergencyStopResponse, response, context);
+}
+
+void handleUnexpectedMessage(u8 messageId, const TRequestContext* context)
 {
     TUnexpectedMasterMessageInd* indication = MasterDataMemoryManager_allocate(EMessageId_UnexpectedMasterMessageInd);
     indication->id = messageId;
-    MasterUartGateway_sendMessage(EMessageId_UnexpectedMasterMessageInd, indication);
+    MasterUartGateway_sendResponse(EMessageId_UnexpectedMasterMessageInd, indication, context);
 }
 
 // Indications to Master callbacks
@@ -500,31 +1218,80 @@ void faultIndCallback(SFaultIndication* faultIndication)
 
 void sampleCarrierDataIndCallback(SSampleCarrierData* sampleCarrierData)
 {
+    float value;
+    if (!filterStreamSample(ERegisteringDataType_SampleCarrierData, sampleCarrierData->unitId - EUnitId_RtdPt1000, sampleCarrierData->value, &value))
+    {
+        return;
+    }
+    
     TSampleCarrierDataInd* indication = MasterDataMemoryManager_allocate(EMessageId_SampleCarrierDataInd);
     CopyObject_SSampleCarrierData(sampleCarrierData, &(indication->data));
+    indication->data.value = value;
+    indication->data.timestamp = TimeSynchronizer_convertTimestamp(sampleCarrierData->timestamp);
+    indication->sequenceNumber = mSampleCarrierDataSequenceNumbers[sampleCarrierData->unitId - EUnitId_RtdPt1000]++;
     MasterUartGateway_sendMessage(EMessageId_SampleCarrierDataInd, indication);
 }
 
-void heaterTemperatureIndCallback(float temperature)
+void sampleCarrierRawDataIndCallback(EUnitId unitId, u32 code, u8 configurationId, u32 timestamp)
+{
+    // Raw codes are not linear across the sign boundary, so the stream filters are bypassed.
+    TSampleCarrierRawDataInd* indication = MasterDataMemoryManager_allocate(EMessageId_SampleCarrierRawDataInd);
+    indication->unitId = unitId;
+    indication->code = code;
+    indication->configurationId = configurationId;
+    indication->timestamp = TimeSynchronizer_convertTimestamp(timestamp);
+    indication->sequenceNumber = mSampleCarrierDataSequenceNumbers[unitId - EUnitId_RtdPt1000]++;
+    MasterUartGateway_sendMessage(EMessageId_SampleCarrierRawDataInd, indication);
+}
+
+void sampleCarrierConversionDescriptorInd(SSampleCarrierConversionDescriptor* descriptor)
 {
+    TSampleCarrierConversionDescriptorInd* indication = MasterDataMemoryManager_allocate(EMessageId_SampleCarrierConversionDescriptorInd);
+    CopyObject_SSampleCarrierConversionDescriptor(descriptor, &(indication->descriptor));
+    MasterUartGateway_sendMessage(EMessageId_SampleCarrierConversionDescriptorInd, indication);
+}
+
+void heaterTemperatureIndCallback(float temperature, u32 timestamp)
+{
+    if (!filterStreamSample(ERegisteringDataType_HeaterTemperature, 0, temperature, &temperature))
+    {
+        return;
+    }
+    
     THeaterTemperatureInd* indication = MasterDataMemoryManager_allocate(EMessageId_HeaterTemperatureInd);
     indication->temperature = temperature;
+    indication->timestamp = TimeSynchronizer_convertTimestamp(timestamp);
+    indication->sequenceNumber = mHeaterTemperatureSequenceNumber++;
     MasterUartGateway_sendMessage(EMessageId_HeaterTemperatureInd, indication);
 }
 
-void referenceTemperatureIndCallback(float temperature)
+void referenceTemperatureIndCallback(float temperature, u32 timestamp)
 {
+    if (!filterStreamSample(ERegisteringDataType_ReferenceTemperature, 0, temperature, &temperature))
+    {
+        return;
+    }
+    
     TReferenceTemperatureInd* indication = MasterDataMemoryManager_allocate(EMessageId_ReferenceTemperatureInd);
     indication->temperature = temperature;
+    indication->timestamp = TimeSynchronizer_convertTimestamp(timestamp);
+    indication->sequenceNumber = mReferenceTemperatureSequenceNumber++;
     MasterUartGateway_sendMessage(EMessageId_ReferenceTemperatureInd, indication);
 }
 
-void controllerDataIndCallback(EControllerDataType type, float value)
+void controllerDataIndCallback(EControllerDataType type, float value, u32 timestamp)
 {
+    if (!filterStreamSample(ERegisteringDataType_ControllerData, type, value, &value))
+    {
+        return;
+    }
+    
     TControllerDataInd* indication = MasterDataMemoryManager_allocate(EMessageId_ControllerDataInd);
     //CopyObject_SControllerData(controllerData, &(indication->data));
     indication->type = type;
     indication->value = value;
+    indication->timestamp = TimeSynchronizer_convertTimestamp(timestamp);
+    indication->sequenceNumber = mControllerDataSequenceNumbers[type]++;
     MasterUartGateway_sendMessage(EMessageId_ControllerDataInd, indication);
 }
 
@@ -544,6 +1311,32 @@ void segmentStartedInd(u16 segmentNumber, u8 leftRegisteredSegments)
     MasterUartGateway_sendMessage(EMessageId_SegmentStartedInd, indication);
 }
 
+void emergencyStopDoneInd(SEmergencyStopReport* report)
+{
+    TEmergencyStopInd* indication = MasterDataMemoryManager_allocate(EMessageId_EmergencyStopInd);
+    CopyObject_SEmergencyStopReport(report, &(indication->report));
+    indication->report.triggerTimestamp = TimeSynchronizer_convertTimestamp(report->triggerTimestamp);
+    MasterUartGateway_sendMessage(EMessageId_EmergencyStopInd, indication);
+}
+
+void commandScriptMarkerInd(u16 marker, u16 pc, u32 timestamp)
+{
+    TCommandScriptMarkerInd* indication = MasterDataMemoryManager_allocate(EMessageId_CommandScriptMarkerInd);
+    indication->marker = marker;
+    indication->pc = pc;
+    indication->timestamp = TimeSynchronizer_convertTimestamp(timestamp);
+    MasterUartGateway_sendMessage(EMessageId_CommandScriptMarkerInd, indication);
+}
+
+void commandScriptDoneInd(ECommandScriptStatus status, u16 pc, u32 executionTime)
+{
+    TCommandScriptDoneInd* indication = MasterDataMemoryManager_allocate(EMessageId_CommandScriptDoneInd);
+    indication->status = status;
+    indication->pc = pc;
+    indication->executionTime = executionTime;
+    MasterUartGateway_sendMessage(EMessageId_CommandScriptDoneInd, indication);
+}
+
 void unitReadyIndCallback(EUnitId unitId, bool status)
 {
     TUnitReadyInd* indication = MasterDataMemoryManager_allocate(EMessageId_UnitReadyInd);
@@ -552,6 +1345,91 @@ void unitReadyIndCallback(EUnitId unitId, bool status)
     MasterUartGateway_sendMessage(EMessageId_UnitReadyInd, indication);
 }
 
+// Telemetry streams filtering
+
+SStreamFilter* getStreamFilter(ERegisteringDataType dataType, u8 channel)
+{
+    switch (dataType)
+    {
+        case ERegisteringDataType_HeaterTemperature :
+            return ( 0 == channel ) ? &mHeaterTemperatureFilter : NULL;
+        
+        case ERegisteringDataType_ReferenceTemperature :
+            return ( 0 == channel ) ? &mReferenceTemperatureFilter : NULL;
+        
+        case ERegisteringDataType_ControllerData :
+            return ( CONTROLLER_DATA_STREAMS_COUNT > channel ) ? &(mControllerDataFilters[channel]) : NULL;
+        
+        case ERegisteringDataType_SampleCarrierData :
+            return ( SAMPLE_CARRIER_STREAMS_COUNT > channel ) ? &(mSampleCarrierDataFilters[channel]) : NULL;
+        
+        default :
+            return NULL;
+    }
+}
+
+bool configureStreamFilters(ERegisteringDataType dataType, u8 channel, EStreamFilterType filterType, u16 decimationFactor)
+{
+    SStreamFilter filter;
+    if (!StreamFilter_configure(&filter, filterType, decimationFactor))
+    {
+        return false;
+    }
+    
+    osMutexWait(mStreamFiltersMutexId, osWaitForever);
+    
+    bool result = true;
+    if (ERegisteringDataType_All == dataType)
+    {
+        mHeaterTemperatureFilter = filter;
+        mReferenceTemperatureFilter = filter;
+        for (u8 iter = 0; CONTROLLER_DATA_STREAMS_COUNT > iter; ++iter)
+        {
+            mControllerDataFilters[iter] = filter;
+        }
+        for (u8 iter = 0; SAMPLE_CARRIER_STREAMS_COUNT > iter; ++iter)
+        {
+            mSampleCarrierDataFilters[iter] = filter;
+        }
+    }
+    else
+    {
+        SStreamFilter* streamFilter = getStreamFilter(dataType, channel);
+        if (streamFilter)
+        {
+            *streamFilter = filter;
+        }
+        else
+        {
+            result = false;
+        }
+    }
+    
+    osMutexRelease(mStreamFiltersMutexId);
+    
+    return result;
+}
+
+bool filterStreamSample(ERegisteringDataType dataType, u8 channel, float input, float* output)
+{
+    osMutexWait(mStreamFiltersMutexId, osWaitForever);
+    
+    bool isOutputReady = true;
+    SStreamFilter* streamFilter = getStreamFilter(dataType, channel);
+    if (streamFilter)
+    {
+        isOutputReady = StreamFilter_process(streamFilter, input, output);
+    }
+    else
+    {
+        *output = input;
+    }
+    
+    osMutexRelease(mStreamFiltersMutexId);
+    
+    return isOutputReady;
+}
+
 // Delayed responses to Master
 
 void callibreADS1248ResponseCallback(EADS1248CallibrationType type, bool success)
@@ -559,5 +1437,18 @@ void callibreADS1248ResponseCallback(EADS1248CallibrationType type, bool success
     TCallibreADS1248Response* response = MasterDataMemoryManager_allocate(EMessageId_CallibreADS1248Response);
     response->callibrationType = type;
     response->success = success;
-    MasterUartGateway_sendMessage(EMessageId_CallibreADS1248Response, response);
+    MasterUartGateway_sendResponse(EMessageId_CallibreADS1248Response, response, &mCallibreADS1248Context);
 }
+
+#undef SAMPLE_CARRIER_STREAMS_COUNT
+#undef CONTROLLER_DATA_STREAMS_COUNT
+#undef RECORDING_BULK_SAMPLE_SIZE
+#undef REQUEST_HANDLER_FromMaster
+#undef REQUEST_HANDLER_ToMaster
+#undef REQUEST_HANDLER_Link
+#undef REQUEST_HANDLER
+#undef REQUEST_DISPATCH_FromMaster
+#undef REQUEST_DISPATCH_ToMaster
+#undef REQUEST_DISPATCH_Link
+#undef REQUEST_DISPATCH
+#undef RAW_MESSAGE_IGNORED
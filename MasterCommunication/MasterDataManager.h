@@ -4,10 +4,13 @@
 
 #include "Defines/CommonDefines.h"
 #include "System/ThreadMacros.h"
+#include "SharedDefines/TMessage.h"
+#include "SharedDefines/TRequestContext.h"
 
 THREAD_PROTOTYPE(MasterDataManager)
 
 void MasterDataManager_setup(void);
 void MasterDataManager_initialize(void);
+void MasterDataManager_executeRequest(TMessage* message, const TRequestContext* context);
 
 #endif
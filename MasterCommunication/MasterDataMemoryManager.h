@@ -8,6 +8,6 @@
 void MasterDataMemoryManager_setup(void);
 void* MasterDataMemoryManager_allocate(EMessageId messageId);
 void MasterDataMemoryManager_free(EMessageId messageId, void* allocatedMemory);
-u8 MasterDataMemoryManager_getLength(EMessageId messageId);
+u16 MasterDataMemoryManager_getLength(EMessageId messageId);
 
 #endif
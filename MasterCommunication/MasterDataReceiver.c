@@ -1,8 +1,13 @@
 #include "MasterCommunication/MasterDataReceiver.h"
 #include "MasterCommunication/MasterUartGateway.h"
 #include "MasterCommunication/MasterDataMemoryManager.h"
+#include "MasterCommunication/MasterDataTransmitter.h"
+#include "MasterCommunication/LinkStatistics.h"
+
+#include "Controller/EmergencyStop.h"
 
 #include "Peripherals/UART1.h"
+#include "Peripherals/TIM2.h"
 #include "SharedDefines/EMessagePart.h"
 #include "SharedDefines/EMessageId.h"
 #include "SharedDefines/TMessage.h"
@@ -19,6 +24,7 @@
 THREAD_DEFINES(MasterDataReceiver, MasterDataReceiver)
 EVENT_HANDLER_PROTOTYPE(DataFromMasterReceivedInd)
 EVENT_HANDLER_PROTOTYPE(StartReceivingData)
+EVENT_HANDLER_PROTOTYPE(FrameFromMasterReceivedInd)
 
 #define MESSAGES_BUFFER_SIZE 15
 
@@ -27,8 +33,10 @@ static TByte mMessageEnd [4];
 static TMessage mActiveMessage;
 static EMessagePart mReceivingMessagePart = EMessagePart_End;
 static bool mIsMessageCorrupted = true;
+static volatile u32 mDataReceivedTimestamp = 0;
 
 static void dataReceivedCallback(void);
+static void byteReceivedCallback(TByte byte);
 
 THREAD(MasterDataReceiver)
 {
@@ -36,6 +44,7 @@ THREAD(MasterDataReceiver)
     
         EVENT_HANDLING(DataFromMasterReceivedInd)
         EVENT_HANDLING(StartReceivingData)
+        EVENT_HANDLING(FrameFromMasterReceivedInd)
     
     THREAD_SKELETON_END
 }
@@ -56,6 +65,7 @@ EVENT_HANDLER(DataFromMasterReceivedInd)
             {
                 if (! ( ('M' == mMessageHeader[0]) && ('S' == mMessageHeader[1]) && ('G' == mMessageHeader[2]) ) )
                 {
+                    LinkStatistics_increment(ELinkCounter_MalformedHeaders);
                     mIsMessageCorrupted = true;
                 }
             }
@@ -65,16 +75,28 @@ EVENT_HANDLER(DataFromMasterReceivedInd)
                 mActiveMessage.transactionId = mMessageHeader[4];
                 mActiveMessage.crc = ( mMessageHeader[5] | ( ( ( (u16) ( mMessageHeader[6] )) << 8 ) & 0xFF00 ) );
                 mActiveMessage.length = mMessageHeader[7];
+                mActiveMessage.isBroadcast = false;
                  
                 Logger_debugSystem("%s: Receiving %s message from Master device.", getLoggerPrefix(), CStringConverter_EMessageId(mActiveMessage.id));
-
+                
                 mActiveMessage.data = (TByte*) ( MasterDataMemoryManager_allocate(mActiveMessage.id) );
-
+                
                 if (NULL == mActiveMessage.data)
                 {
                     Logger_error("%s: Allocating memory for message %s failed. System failure!", getLoggerPrefix(), CStringConverter_EMessageId(mActiveMessage.id));
                     FaultIndication_start(EFaultId_NoMemory, EUnitId_Nucleo, EUnitId_Empty);
                     mIsMessageCorrupted = true;
+                    
+                    if (EMessageId_Limit > mActiveMessage.id)
+                    {
+                        TRequestContext context = { mActiveMessage.transactionId, false, false };
+                        MasterUartGateway_indicateBusyRequest(mActiveMessage.id, &context);
+                    }
+                }
+                else if (MasterDataMemoryManager_getLength(mActiveMessage.id) < mActiveMessage.length)
+                {
+                    Logger_error("%s: Message %s is longer than expected (%u bytes).", getLoggerPrefix(), CStringConverter_EMessageId(mActiveMessage.id), mActiveMessage.length);
+                    mIsMessageCorrupted = true;
                 }
             }
             
@@ -142,6 +164,8 @@ EVENT_HANDLER(DataFromMasterReceivedInd)
             
             if (!mIsMessageCorrupted)
             {
+                LinkStatistics_increment(ELinkCounter_FramesReceived);
+                mActiveMessage.timestamp = mDataReceivedTimestamp;
                 MasterUartGateway_handleReceivedMessage(mActiveMessage);
             }
             else
@@ -160,10 +184,45 @@ EVENT_HANDLER(DataFromMasterReceivedInd)
     }
 }
 
+EVENT_HANDLER(FrameFromMasterReceivedInd)
+{
+    EVENT_MESSAGE(FrameFromMasterReceivedInd)
+    
+    TMessage message;
+    if (MasterUartGateway_decodeFrame(event->frame, event->length, &message))
+    {
+        Logger_debugSystem("%s: Received %s message from Master device.", getLoggerPrefix(), CStringConverter_EMessageId(message.id));
+        message.timestamp = event->timestamp;
+        MasterUartGateway_handleReceivedMessage(message);
+    }
+    else
+    {
+        // Credit of a delivered request is returned once it is executed, a skipped frame gives it back right away.
+        Logger_error("%s: Frame of %u bytes could not be decoded and will be skipped.", getLoggerPrefix(), event->length);
+        MasterUartGateway_returnRxCredit( ( 3 <= event->length ) ? (EMessageId) ( event->frame[2] ) : EMessageId_Unknown );
+    }
+    
+    MasterUartGateway_releaseFrame(event->frame);
+}
+
 EVENT_HANDLER(StartReceivingData)
 {
     Logger_debugSystem("%s: Starting receiving data from Master...", getLoggerPrefix());
     
+    UART1_abortReceiving();
+    
+    if (EFramingMode_Cobs == MasterUartGateway_getFramingMode())
+    {
+        if (!UART1_startReceivingByteStream(byteReceivedCallback))
+        {
+            Logger_error("%s: Starting receiving frames from Master failed! UART failure.", getLoggerPrefix());
+            assert_param(0);
+        }
+        
+        Logger_debugSystem("%s: Receiving frames from Master started.", getLoggerPrefix());
+        return;
+    }
+    
     mIsMessageCorrupted = false;
     mReceivingMessagePart = EMessagePart_Header;
     Logger_debugSystemMasterDataExtended("%s: Message part awaiting: %u.", getLoggerPrefix(), mReceivingMessagePart);
@@ -189,10 +248,74 @@ void MasterDataReceiver_initialize(void)
     osMutexRelease(mMutexId);
 }
 
+void MasterDataReceiver_restartReceiving(void)
+{
+    CREATE_EVENT_ISR(StartReceivingData, mThreadId);
+    SEND_EVENT();
+}
+
 void dataReceivedCallback(void)
 {
     static u8 iter = 0;
+    mDataReceivedTimestamp = TIM2_getMicroseconds();
     Logger_debugSystem("%s: Data received callback. Iteration: %u.", getLoggerPrefix(), ++iter);
     CREATE_EVENT_ISR(DataFromMasterReceivedInd, mThreadId);
     SEND_EVENT();
 }
+
+void byteReceivedCallback(TByte byte)
+{
+    u16 frameLength;
+    bool isEmergencyStop = MasterUartGateway_isEmergencyStopByte(byte);
+    TByte* frame = MasterUartGateway_decodeReceivedByte(byte, &frameLength);
+    
+    // Emergency stop is executed right here, it never waits in an event queue behind other requests, nor for a free RX
+    // frame buffer.
+    if (isEmergencyStop)
+    {
+        EmergencyStop_triggerFromISR();
+        
+        if (frame)
+        {
+            MasterUartGateway_releaseFrame(frame);
+        }
+        
+        return;
+    }
+    
+    if (frame)
+    {
+        if (!MasterUartGateway_isFrameAddressedToUnit(frame, frameLength))
+        {
+            LinkStatistics_increment(ELinkCounter_ForeignFrames);
+            MasterUartGateway_releaseFrame(frame);
+            return;
+        }
+        
+        u8 credits;
+        if (MasterUartGateway_isTxCreditFrame(frame, frameLength, &credits))
+        {
+            MasterDataTransmitter_grantCreditsFromISR(credits);
+            MasterUartGateway_releaseFrame(frame);
+            return;
+        }
+        
+        u8 nextExpectedSequenceNumber;
+        u8 selectiveAckMask;
+        if (MasterUartGateway_isDeliveryAckFrame(frame, frameLength, &nextExpectedSequenceNumber, &selectiveAckMask))
+        {
+            MasterDataTransmitter_acknowledgeFromISR(nextExpectedSequenceNumber, selectiveAckMask);
+            MasterUartGateway_releaseFrame(frame);
+            return;
+        }
+        
+        CREATE_EVENT_ISR(FrameFromMasterReceivedInd, mThreadId);
+        CREATE_EVENT_MESSAGE(FrameFromMasterReceivedInd);
+        
+        eventMessage->frame = frame;
+        eventMessage->length = frameLength;
+        eventMessage->timestamp = TIM2_getMicroseconds();
+        
+        SEND_EVENT();
+    }
+}
@@ -10,5 +10,6 @@ THREAD_PROTOTYPE(MasterDataReceiver)
 
 void MasterDataReceiver_setup(void);
 void MasterDataReceiver_initialize(void);
+void MasterDataReceiver_restartReceiving(void);
 
 #endif
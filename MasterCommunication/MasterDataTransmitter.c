@@ -1,37 +1,157 @@
 #include "MasterCommunication/MasterDataTransmitter.h"
 #include "MasterCommunication/MasterDataMemoryManager.h"
+#include "MasterCommunication/LinkStatistics.h"
+#include "MasterCommunication/MasterUartGateway.h"
 
 #include "Peripherals/UART1.h"
+#include "Peripherals/TIM2.h"
 #include "SharedDefines/EMessagePart.h"
 #include "SharedDefines/EMessageId.h"
 #include "SharedDefines/TMessage.h"
+#include "SharedDefines/ETxLane.h"
+#include "SharedDefines/ETxLanePolicy.h"
 #include "System/EventManagement/EEventId.h"
 #include "Utilities/CopyObject.h"
 #include "Utilities/Logger/Logger.h"
 #include "Utilities/Printer/CStringConverter.h"
+#include "FaultManagement/FaultIndication.h"
 #include "cmsis_os.h"
+#include "stm32f4xx_hal.h"
+#include "string.h"
 
 THREAD_DEFINES(MasterDataTransmitter, MasterDataTransmitter)
 EVENT_HANDLER_PROTOTYPE(DataToMasterTransmittedInd)
 EVENT_HANDLER_PROTOTYPE(TransmitData)
+EVENT_HANDLER_PROTOTYPE(TxCreditsGrantedInd)
+EVENT_HANDLER_PROTOTYPE(FrameBoundaryReq)
+EVENT_HANDLER_PROTOTYPE(DeliveryAckReceivedInd)
 
-#define MESSAGES_BUFFER_SIZE 100
+#define RESPONSES_LANE_CAPACITY 24
+#define CONTROL_TELEMETRY_LANE_CAPACITY 32
+#define BULK_SAMPLES_LANE_CAPACITY 48
+#define BULK_TRANSFER_LANE_CAPACITY 4
+#define LOGS_LANE_CAPACITY 16
+#define CONTAINER_ENTRY_HEADER_SIZE 2
+#define CONTAINER_LATENCY_BUDGET_MS 5
+#define RELIABLE_WINDOW_SIZE 8
+#define RELIABLE_ARENA_SIZE 2048
+#define RETRANSMIT_TIMER_PERIOD_MS 100
+#define RETRANSMIT_TIMEOUT_PERIODS 3
+#define RETRANSMIT_MAX_RETRIES 5
+#define FLOW_CONTROL_MAX_CREDITS 255
+#define FLOW_CONTROL_RESPONSES_RESERVED_CREDITS 1
 
 static osMutexDef(mMutexBufferOverflow);
 static osMutexId mMutexBufferOverflowId;
 
-static TMessage mMessagesBuffer [MESSAGES_BUFFER_SIZE];
+typedef struct _STxLane
+{
+    TMessage* messages;
+    u8 capacity;
+    ETxLanePolicy policy;
+    u8 head;
+    u8 count;
+    u32 droppedMessagesCount;
+} STxLane;
+
+typedef struct _SReliableSlot
+{
+    TMessage message;
+    u16 arenaOffset;
+    u8 age;
+    u8 retries;
+    bool isUsed;
+    bool isRetransmissionPending;
+} SReliableSlot;
+
+static TMessage mResponsesLaneBuffer [RESPONSES_LANE_CAPACITY];
+static TMessage mControlTelemetryLaneBuffer [CONTROL_TELEMETRY_LANE_CAPACITY];
+static TMessage mBulkSamplesLaneBuffer [BULK_SAMPLES_LANE_CAPACITY];
+static TMessage mBulkTransferLaneBuffer [BULK_TRANSFER_LANE_CAPACITY];
+static TMessage mLogsLaneBuffer [LOGS_LANE_CAPACITY];
+
+// Bulk transfer chunks must arrive without gaps, so their lane blocks. It holds at least as many messages as their memory
+// pools, so a producer waits for a free pool entry long before it could wait for the lane.
+static STxLane mLanes [ETxLane_Count] =
+{
+    [ETxLane_Responses]         = { mResponsesLaneBuffer,           RESPONSES_LANE_CAPACITY,            ETxLanePolicy_Block,        0, 0, 0 },
+    [ETxLane_ControlTelemetry]  = { mControlTelemetryLaneBuffer,    CONTROL_TELEMETRY_LANE_CAPACITY,    ETxLanePolicy_DropOldest,   0, 0, 0 },
+    [ETxLane_BulkSamples]       = { mBulkSamplesLaneBuffer,         BULK_SAMPLES_LANE_CAPACITY,         ETxLanePolicy_DropOldest,   0, 0, 0 },
+    [ETxLane_BulkTransfer]      = { mBulkTransferLaneBuffer,        BULK_TRANSFER_LANE_CAPACITY,        ETxLanePolicy_Block,        0, 0, 0 },
+    [ETxLane_Logs]              = { mLogsLaneBuffer,                LOGS_LANE_CAPACITY,                 ETxLanePolicy_DropNewest,   0, 0, 0 }
+};
+
+#define MESSAGE_LANE(message, id, size, dir, lane) [EMessageId_##message] = ETxLane_##lane,
+#define RAW_MESSAGE_LANE(message, id, dir, lane) [EMessageId_##message] = ETxLane_##lane,
+
+static const ETxLane mMessageLanes [EMessageId_Limit] =
+{
+    MESSAGES_REGISTRY(MESSAGE_LANE, RAW_MESSAGE_LANE)
+};
+
+static TMessage mCurrentMessage;
 static TMessage* mTransmittingMessage = NULL;
-static u8 mMessagesBufferHead = 0;
-static u8 mMessagesBufferTail = 0;
 static u8 mNumberOfWaitingMessagesInBuffer = 0;
 static bool mIsTransmittionOngoing = false;
+static volatile u32 mDataTransmittedTimestamp = 0;
+static bool mIsTxLatencyMeasured = false;
 static EMessagePart mTransmittingMessagePart = EMessagePart_Header;
 static TByte mMessageHeader [8];
 static TByte mMessageEnd [4];
+static TByte mFrame [MASTER_FRAME_MAX_EXTENDED_ENCODED_SIZE];
+static void (*mMessageTransmittedCallback)(TMessage*) = NULL;
+static void (*mFrameBoundaryCallback)(void) = NULL;
+static bool mIsFrameBoundaryRequested = false;
+static TMessage mContainerMessage;
+static TByte mContainerData [MASTER_FRAME_MAX_PAYLOAD_SIZE];
+static u16 mAggregatableBytesWaiting = 0;
+static osTimerId mContainerTimerId = NULL;
+static bool mIsContainerTimerStarted = false;
+static SReliableSlot mReliableWindow [RELIABLE_WINDOW_SIZE];
+static TByte mReliableArena [RELIABLE_ARENA_SIZE];
+static u16 mReliableArenaHead = 0;
+static bool mIsReliableDeliveryEnabled = false;
+static u8 mNextSequenceNumber = 0;
+static u8 mWindowBaseSequenceNumber = 0;
+static osTimerId mRetransmitTimerId = NULL;
+static bool mIsFlowControlEnabled = false;
+static u8 mTxCredits = 0;
+static volatile u32 mGrantedCreditsTotal = 0;
+static u32 mAppliedCreditsTotal = 0;
+static volatile u16 mPendingAcknowledgement = 0;
+static volatile bool mIsAcknowledgementPending = false;
 
 static void dataTransmittedCallback(void);
-static u8 getNextBufferIndex(u8 index);
+static bool takeNextMessage(void);
+static bool startTransfer(TByte* data, u16 dataLength);
+static void abandonTransmission(void);
+static void startTransmissionIfIdle(void);
+static void notifyFrameBoundary(void);
+static ETxLane getLane(EMessageId messageId);
+static STxLane* getHighestPriorityLane(void);
+static TMessage* peekLane(STxLane* lane);
+static void popLane(STxLane* lane, TMessage* message);
+static void pushLane(STxLane* lane, TMessage* message);
+static void dropMessage(ETxLane lane, TMessage* message);
+static bool isAggregatable(EMessageId messageId);
+static void consumeAggregatableBytes(TMessage* message);
+static TMessage* packContainer(TMessage* firstMessage);
+static void containerTimerCallback(const void* arg);
+static bool isReliable(EMessageId messageId);
+static bool isReliableDeliveryActive(void);
+static bool isReliableWindowFull(u16 dataLength);
+static bool reserveReliableArena(u16 dataLength, u16* offset);
+static void assignSequenceNumber(TMessage* message);
+static SReliableSlot* getPendingRetransmission(void);
+static void releaseReliableSlot(SReliableSlot* slot);
+static void releaseReliableWindow(void);
+static void advanceReliableWindow(void);
+static void applyAcknowledgement(u8 nextExpectedSequenceNumber, u8 selectiveAckMask);
+static bool isAnythingToTransmit(void);
+static void retransmitTimerCallback(const void* arg);
+static bool isFlowControlActive(void);
+static bool hasTxCredit(ETxLane lane);
+static void consumeTxCredit(void);
 
 THREAD(MasterDataTransmitter)
 {
@@ -39,6 +159,9 @@ THREAD(MasterDataTransmitter)
     
         EVENT_HANDLING(DataToMasterTransmittedInd)
         EVENT_HANDLING(TransmitData)
+        EVENT_HANDLING(TxCreditsGrantedInd)
+        EVENT_HANDLING(FrameBoundaryReq)
+        EVENT_HANDLING(DeliveryAckReceivedInd)
     
     THREAD_SKELETON_END
 }
@@ -47,14 +170,37 @@ EVENT_HANDLER(TransmitData)
 {
     //osMutexWait(mMutexBufferOverflowId, osWaitForever);
     
-    mMessagesBufferHead = getNextBufferIndex(mMessagesBufferHead);
+    // The thread skeleton holds mMutexId here, so lanes, the reliable window and their counters are accessed under the
+    // same lock as in MasterDataTransmitter_transmitAsync(), acknowledge and the timer callbacks.
+    if (!takeNextMessage())
+    {
+        mIsTransmittionOngoing = false;
+        notifyFrameBoundary();
+        return;
+    }
     
-    Logger_debugSystem("%s: Processing with message from TX buffer: %u.", getLoggerPrefix(), mMessagesBufferHead);
+    consumeTxCredit();
     
     mTransmittingMessagePart = EMessagePart_Header;
-    mTransmittingMessage = &(mMessagesBuffer[mMessagesBufferHead]);
     mIsTransmittionOngoing = true;
     
+    if (EFramingMode_Cobs == MasterUartGateway_getFramingMode())
+    {
+        // Retransmitted data still belongs to the reliable window, so the frame is encoded before the lock is released.
+        mTransmittingMessagePart = EMessagePart_End;
+        u16 frameLength = MasterUartGateway_encodeFrame(mTransmittingMessage, mFrame);
+        
+        if (!startTransfer(mFrame, frameLength))
+        {
+            Logger_debugSystem("%s: Transmitting frame failed (Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
+            abandonTransmission();
+            return;
+        }
+        
+        Logger_debugSystem("%s: Transmitted frame of %u bytes (Message: %s).", getLoggerPrefix(), frameLength, CStringConverter_EMessageId(mTransmittingMessage->id));
+        return;
+    }
+    
     mMessageHeader[0] = 'M';
     mMessageHeader[1] = 'S';
     mMessageHeader[2] = 'G';
@@ -62,18 +208,18 @@ EVENT_HANDLER(TransmitData)
     mMessageHeader[4] = mTransmittingMessage->transactionId;
     mMessageHeader[5] = ( mTransmittingMessage->crc & 0xFF );
     mMessageHeader[6] = ( ( mTransmittingMessage->crc >> 8 ) & 0xFF );
-    mMessageHeader[7] = mTransmittingMessage->length;
+    mMessageHeader[7] = (u8) ( mTransmittingMessage->length );
     
     for (u16 iter = 0; 8 > iter; ++iter)
     {
         Logger_debugSystemMasterDataExtended("%s: Header byte[%u]: 0x%02X.", getLoggerPrefix(), iter, mMessageHeader[iter]);
     }
     
-    if (!UART1_transmit(mMessageHeader, 8))
+    if (!startTransfer(mMessageHeader, 8))
     {
-        mIsTransmittionOngoing = false;
         Logger_debugSystem("%s: Transmitting header failed (Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
-        assert_param(0);
+        abandonTransmission();
+        return;
     }
     
     Logger_debugSystem("%s: Transmitted header (Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
@@ -92,11 +238,11 @@ EVENT_HANDLER(DataToMasterTransmittedInd)
                 Logger_debugSystemMasterDataExtended("%s: Data byte[%u]: 0x%02X.", getLoggerPrefix(), iter, mTransmittingMessage->data[iter]);
             }
             
-            if (!UART1_transmit(mTransmittingMessage->data, mTransmittingMessage->length))
+            if (!startTransfer(mTransmittingMessage->data, mTransmittingMessage->length))
             {
-                mIsTransmittionOngoing = false;
                 Logger_debugSystem("%s: Transmitting data failed (Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
-                assert_param(0);
+                abandonTransmission();
+                break;
             }
             
             Logger_debugSystem("%s: Transmitted data(Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
@@ -118,11 +264,11 @@ EVENT_HANDLER(DataToMasterTransmittedInd)
                 Logger_debugSystemMasterDataExtended("%s: End byte[%u]: 0x%02X.", getLoggerPrefix(), iter, mMessageEnd[iter]);
             }
             
-            if (!UART1_transmit(mMessageEnd, 4))
+            if (!startTransfer(mMessageEnd, 4))
             {
-                mIsTransmittionOngoing = false;
                 Logger_debugSystem("%s: Transmitting end of message failed (Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
-                assert_param(0);
+                abandonTransmission();
+                break;
             }
             
             Logger_debugSystem("%s: Transmitted end of message (Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
@@ -134,10 +280,43 @@ EVENT_HANDLER(DataToMasterTransmittedInd)
         {
             mTransmittingMessagePart = EMessagePart_Unknown;
             
-            MasterDataMemoryManager_free(mTransmittingMessage->id, mTransmittingMessage->data);
-            --mNumberOfWaitingMessagesInBuffer;
+            // Until now timestamp holds the time the message was queued.
+            LinkStatistics_increment(ELinkCounter_FramesTransmitted);
+            if (mIsTxLatencyMeasured)
+            {
+                LinkStatistics_registerTxLatency(mDataTransmittedTimestamp - mTransmittingMessage->timestamp);
+            }
+            
+            mTransmittingMessage->timestamp = mDataTransmittedTimestamp;
+            
+            if (mMessageTransmittedCallback)
+            {
+                (*mMessageTransmittedCallback)(mTransmittingMessage);
+            }
+            
+            notifyFrameBoundary();
+            
+            if ( (&mContainerMessage != mTransmittingMessage) && !mTransmittingMessage->isReliable )
+            {
+                MasterDataMemoryManager_free(mTransmittingMessage->id, mTransmittingMessage->data);
+            }
+            
+            if ( mIsReliableDeliveryEnabled && (EFramingMode_Cobs != MasterUartGateway_getFramingMode()) )
+            {
+                Logger_warning("%s: Framing mode changed. Reliable delivery disabled.", getLoggerPrefix());
+                mIsReliableDeliveryEnabled = false;
+                osTimerStop(mRetransmitTimerId);
+                releaseReliableWindow();
+            }
+            
+            if ( mIsFlowControlEnabled && (EFramingMode_Cobs != MasterUartGateway_getFramingMode()) )
+            {
+                Logger_warning("%s: Framing mode changed. Flow control disabled.", getLoggerPrefix());
+                mIsFlowControlEnabled = false;
+                mTxCredits = 0;
+            }
             
-            if (mMessagesBufferHead == mMessagesBufferTail)
+            if (!isAnythingToTransmit())
             {
                 mIsTransmittionOngoing = false;
                 Logger_debugSystem
@@ -171,10 +350,67 @@ EVENT_HANDLER(DataToMasterTransmittedInd)
     }
 }
 
+EVENT_HANDLER(TxCreditsGrantedInd)
+{
+    // Grants are counted by the RX ISR only, the difference of both totals is what was not applied yet.
+    // The thread skeleton holds mMutexId, so credits and the transmission flag change under the same lock as in
+    // MasterDataTransmitter_transmitAsync().
+    u32 grantedCreditsTotal = mGrantedCreditsTotal;
+    u32 credits = grantedCreditsTotal - mAppliedCreditsTotal;
+    mAppliedCreditsTotal = grantedCreditsTotal;
+    
+    if ( !mIsFlowControlEnabled || (0 == credits) )
+    {
+        return;
+    }
+    
+    mTxCredits = ( FLOW_CONTROL_MAX_CREDITS - mTxCredits < credits ) ? FLOW_CONTROL_MAX_CREDITS : (u8) ( mTxCredits + credits );
+    Logger_debugSystem("%s: Master granted %u credits. Available credits: %u.", getLoggerPrefix(), credits, mTxCredits);
+    
+    startTransmissionIfIdle();
+}
+
+EVENT_HANDLER(DeliveryAckReceivedInd)
+{
+    // Applied here rather than by the gateway, so no sender holding the gateway lock can hold off the acknowledgements
+    // that free the window. Only the latest one is kept: its cumulative part covers the earlier ones, and a lost
+    // selective bit costs a retransmission at most.
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    bool isAcknowledgementPending = mIsAcknowledgementPending;
+    u16 acknowledgement = mPendingAcknowledgement;
+    mIsAcknowledgementPending = false;
+    __set_PRIMASK(primask);
+    
+    if ( !isAcknowledgementPending || !mIsReliableDeliveryEnabled )
+    {
+        return;
+    }
+    
+    applyAcknowledgement((u8) ( acknowledgement >> 8 ), (u8) ( acknowledgement & 0xFF ));
+}
+
+EVENT_HANDLER(FrameBoundaryReq)
+{
+    // Served right away when the link is idle, otherwise once the frame being transmitted is done.
+    mIsFrameBoundaryRequested = true;
+    
+    if (!mIsTransmittionOngoing)
+    {
+        notifyFrameBoundary();
+    }
+}
+
 void MasterDataTransmitter_setup(void)
 {
     THREAD_INITIALIZE_MUTEX
     mMutexBufferOverflowId = osMutexCreate(osMutex(mMutexBufferOverflow));
+    
+    osTimerDef(containerTimer, containerTimerCallback);
+    mContainerTimerId = osTimerCreate(osTimer(containerTimer), osTimerOnce, NULL);
+    
+    osTimerDef(retransmitTimer, retransmitTimerCallback);
+    mRetransmitTimerId = osTimerCreate(osTimer(retransmitTimer), osTimerPeriodic, NULL);
 }
 
 void MasterDataTransmitter_initialize(void)
@@ -191,49 +427,682 @@ void MasterDataTransmitter_transmitAsync(TMessage* message)
     
     Logger_debugSystem("%s: Transmitting message %s.", getLoggerPrefix(), CStringConverter_EMessageId(message->id));
     
-    u8 nextTail = getNextBufferIndex(mMessagesBufferTail);
-    while (nextTail == mMessagesBufferHead)
+    ETxLane laneId = getLane(message->id);
+    STxLane* lane = &(mLanes[laneId]);
+    
+    message->timestamp = TIM2_getMicroseconds();
+    
+    if (lane->capacity <= lane->count)
     {
-        osMutexRelease(mMutexId);
-        Logger_debugSystem("%s: TX buffer is full. Waiting for free place in buffer...", getLoggerPrefix());
-        osDelay(1);
-        //osMutexWait(mMutexBufferOverflowId, osWaitForever);
-        osMutexWait(mMutexId, osWaitForever);
-        nextTail = getNextBufferIndex(mMessagesBufferTail);
+        LinkStatistics_increment(ELinkCounter_TxLaneFullEvents);
     }
     
-    CopyObject_TMessage(message, &(mMessagesBuffer[nextTail]));
-    mMessagesBufferTail = nextTail;
-    ++mNumberOfWaitingMessagesInBuffer;
-    Logger_debugSystem("%s: Copied message to TX buffer. Position: %u. Messages waiting count: %u.", getLoggerPrefix(), mMessagesBufferTail, mNumberOfWaitingMessagesInBuffer);
+    while (lane->capacity <= lane->count)
+    {
+        if (ETxLanePolicy_Block == lane->policy)
+        {
+            osMutexRelease(mMutexId);
+            Logger_debugSystem("%s: %s TX lane is full. Waiting for free place in lane...", getLoggerPrefix(), CStringConverter_ETxLane(laneId));
+            osDelay(1);
+            osMutexWait(mMutexId, osWaitForever);
+        }
+        else if (ETxLanePolicy_DropNewest == lane->policy)
+        {
+            dropMessage(laneId, message);
+            osMutexRelease(mMutexId);
+            return;
+        }
+        else
+        {
+            TMessage oldestMessage;
+            popLane(lane, &oldestMessage);
+            dropMessage(laneId, &oldestMessage);
+        }
+    }
+    
+    pushLane(lane, message);
+    LinkStatistics_updateTxQueueLength(mNumberOfWaitingMessagesInBuffer);
+    Logger_debugSystem("%s: Copied message to %s TX lane. Messages waiting count: %u.", getLoggerPrefix(), CStringConverter_ETxLane(laneId), mNumberOfWaitingMessagesInBuffer);
+    
+    bool isMessageAggregatable = isAggregatable(message->id);
     
     if (!mIsTransmittionOngoing)
+    {
+        if ( isMessageAggregatable && (MASTER_FRAME_MAX_PAYLOAD_SIZE > mAggregatableBytesWaiting) )
+        {
+            if (!mIsContainerTimerStarted)
+            {
+                osStatus osResult = osTimerStart(mContainerTimerId, CONTAINER_LATENCY_BUDGET_MS);
+                if (osOK != osResult)
+                {
+                    Logger_error("%s: Starting container timer failed.", getLoggerPrefix());
+                    Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
+                    FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+                }
+                else
+                {
+                    mIsContainerTimerStarted = true;
+                }
+            }
+        }
+        
+        if ( !mIsContainerTimerStarted || !isMessageAggregatable || (MASTER_FRAME_MAX_PAYLOAD_SIZE <= mAggregatableBytesWaiting) )
+        {
+            if (mIsContainerTimerStarted)
+            {
+                osTimerStop(mContainerTimerId);
+                mIsContainerTimerStarted = false;
+            }
+            
+            mIsTransmittionOngoing = true;
+            CREATE_EVENT_ISR(TransmitData, mThreadId);
+            SEND_EVENT();
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+u32 MasterDataTransmitter_getDroppedMessagesCount(ETxLane lane)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    u32 droppedMessagesCount = ( ETxLane_Count > lane ) ? mLanes[lane].droppedMessagesCount : 0;
+    osMutexRelease(mMutexId);
+    return droppedMessagesCount;
+}
+
+void MasterDataTransmitter_setReliableDelivery(bool enabled)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (enabled != mIsReliableDeliveryEnabled)
+    {
+        releaseReliableWindow();
+        mIsReliableDeliveryEnabled = enabled;
+        
+        osStatus osResult = enabled ? osTimerStart(mRetransmitTimerId, RETRANSMIT_TIMER_PERIOD_MS) : osTimerStop(mRetransmitTimerId);
+        if (osOK != osResult)
+        {
+            Logger_error("%s: Changing retransmit timer state failed.", getLoggerPrefix());
+            Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
+            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+void MasterDataTransmitter_acknowledgeFromISR(u8 nextExpectedSequenceNumber, u8 selectiveAckMask)
+{
+    mPendingAcknowledgement = (u16) ( ( ( (u16) nextExpectedSequenceNumber ) << 8 ) | selectiveAckMask );
+    mIsAcknowledgementPending = true;
+    CREATE_EVENT_ISR(DeliveryAckReceivedInd, mThreadId);
+    SEND_EVENT();
+}
+
+void applyAcknowledgement(u8 nextExpectedSequenceNumber, u8 selectiveAckMask)
+{
+    u8 cumulativeCount = (u8) ( nextExpectedSequenceNumber - mWindowBaseSequenceNumber );
+    u8 outstandingCount = (u8) ( mNextSequenceNumber - mWindowBaseSequenceNumber );
+    
+    for (u8 iter = 0; outstandingCount > iter; ++iter)
+    {
+        u8 sequenceNumber = (u8) ( mWindowBaseSequenceNumber + iter );
+        u8 selectiveOffset = (u8) ( sequenceNumber - nextExpectedSequenceNumber - 1 );
+        SReliableSlot* slot = &(mReliableWindow[sequenceNumber % RELIABLE_WINDOW_SIZE]);
+        
+        bool isAcknowledged = ( (cumulativeCount > iter) && (outstandingCount >= cumulativeCount) );
+        isAcknowledged = isAcknowledged || ( (8 > selectiveOffset) && ( 0 != ( selectiveAckMask & (1 << selectiveOffset) ) ) );
+        
+        if ( isAcknowledged && slot->isUsed )
+        {
+            Logger_debugSystem("%s: Message %s (sequence %u) acknowledged.", getLoggerPrefix(), CStringConverter_EMessageId(slot->message.id), sequenceNumber);
+            releaseReliableSlot(slot);
+        }
+    }
+    
+    advanceReliableWindow();
+    
+    startTransmissionIfIdle();
+}
+
+void MasterDataTransmitter_setFlowControl(bool enabled, u8 initialCredits)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    mIsFlowControlEnabled = enabled;
+    mTxCredits = initialCredits;
+    mAppliedCreditsTotal = mGrantedCreditsTotal;
+    
+    startTransmissionIfIdle();
+    
+    osMutexRelease(mMutexId);
+}
+
+void MasterDataTransmitter_grantCreditsFromISR(u8 credits)
+{
+    mGrantedCreditsTotal += credits;
+    CREATE_EVENT_ISR(TxCreditsGrantedInd, mThreadId);
+    SEND_EVENT();
+}
+
+void MasterDataTransmitter_requestFrameBoundary(void)
+{
+    CREATE_EVENT_ISR(FrameBoundaryReq, mThreadId);
+    SEND_EVENT();
+}
+
+void MasterDataTransmitter_flushContainer(void)
+{
+    // Sends whatever waits for the container timer right away, used when the producer knows no more entries follow.
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mIsContainerTimerStarted)
+    {
+        osTimerStop(mContainerTimerId);
+        mIsContainerTimerStarted = false;
+        
+        if (!mIsTransmittionOngoing)
+        {
+            mIsTransmittionOngoing = true;
+            CREATE_EVENT_ISR(TransmitData, mThreadId);
+            SEND_EVENT();
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+void MasterDataTransmitter_registerMessageTransmittedCallback(void (*messageTransmittedCallback)(TMessage*))
+{
+    mMessageTransmittedCallback = messageTransmittedCallback;
+}
+
+void MasterDataTransmitter_deregisterMessageTransmittedCallback(void)
+{
+    mMessageTransmittedCallback = NULL;
+}
+
+void MasterDataTransmitter_registerFrameBoundaryCallback(void (*frameBoundaryCallback)(void))
+{
+    mFrameBoundaryCallback = frameBoundaryCallback;
+}
+
+void MasterDataTransmitter_deregisterFrameBoundaryCallback(void)
+{
+    mFrameBoundaryCallback = NULL;
+}
+
+bool takeNextMessage(void)
+{
+    SReliableSlot* slot = getPendingRetransmission();
+    if (NULL != slot)
+    {
+        slot->isRetransmissionPending = false;
+        slot->age = 0;
+        ++(slot->retries);
+        CopyObject_TMessage(&(slot->message), &mCurrentMessage);
+        mTransmittingMessage = &mCurrentMessage;
+        mIsTxLatencyMeasured = false;
+        
+        Logger_debugSystem("%s: Retransmitting message %s (sequence %u, retry %u).", getLoggerPrefix(), CStringConverter_EMessageId(mCurrentMessage.id), mCurrentMessage.sequenceNumber, slot->retries);
+        
+        return true;
+    }
+    
+    STxLane* lane = getHighestPriorityLane();
+    if (NULL == lane)
+    {
+        return false;
+    }
+    
+    Logger_debugSystem("%s: Processing with message from %s TX lane.", getLoggerPrefix(), CStringConverter_ETxLane((ETxLane) ( lane - mLanes )));
+    
+    popLane(lane, &mCurrentMessage);
+    mTransmittingMessage = &mCurrentMessage;
+    mIsTxLatencyMeasured = true;
+    
+    if (isAggregatable(mTransmittingMessage->id))
+    {
+        mTransmittingMessage = packContainer(mTransmittingMessage);
+        mIsTxLatencyMeasured = false;
+    }
+    else if ( isReliableDeliveryActive() && isReliable(mTransmittingMessage->id) )
+    {
+        assignSequenceNumber(mTransmittingMessage);
+    }
+    
+    return true;
+}
+
+void notifyFrameBoundary(void)
+{
+    if (!mIsFrameBoundaryRequested)
+    {
+        return;
+    }
+    
+    mIsFrameBoundaryRequested = false;
+    
+    if (mFrameBoundaryCallback)
+    {
+        (*mFrameBoundaryCallback)();
+    }
+}
+
+bool startTransfer(TByte* data, u16 dataLength)
+{
+    // The transferred bytes were taken over from the lanes, mIsTransmittionOngoing keeps any other context from starting
+    // a transfer meanwhile, so producers are not held off while DMA is started.
+    osMutexRelease(mMutexId);
+    bool isStarted = UART1_transmit(data, dataLength);
+    osMutexWait(mMutexId, osWaitForever);
+    
+    return isStarted;
+}
+
+void abandonTransmission(void)
+{
+    // The message was already taken over from its lane. Reliable data stays in its slot for retransmission, any other
+    // message is dropped, and the credit is given back as nothing reached Master.
+    Logger_error("%s: Starting transfer of message %s failed.", getLoggerPrefix(), CStringConverter_EMessageId(mTransmittingMessage->id));
+    LinkStatistics_increment(ELinkCounter_TxDroppedMessages);
+    
+    if ( (&mContainerMessage != mTransmittingMessage) && !mTransmittingMessage->isReliable )
+    {
+        MasterDataMemoryManager_free(mTransmittingMessage->id, mTransmittingMessage->data);
+    }
+    
+    if ( isFlowControlActive() && (FLOW_CONTROL_MAX_CREDITS > mTxCredits) )
+    {
+        ++mTxCredits;
+    }
+    
+    mTransmittingMessagePart = EMessagePart_Unknown;
+    mIsTransmittionOngoing = false;
+    
+    notifyFrameBoundary();
+    startTransmissionIfIdle();
+}
+
+void startTransmissionIfIdle(void)
+{
+    // Check and set of the transmission flag must not be split, callers hold mMutexId (event handlers through the
+    // thread skeleton).
+    if ( !mIsTransmittionOngoing && isAnythingToTransmit() )
     {
         mIsTransmittionOngoing = true;
         CREATE_EVENT_ISR(TransmitData, mThreadId);
         SEND_EVENT();
     }
-    
-    osMutexRelease(mMutexId);
 }
 
 void dataTransmittedCallback(void)
 {
+    mDataTransmittedTimestamp = TIM2_getMicroseconds();
     CREATE_EVENT_ISR(DataToMasterTransmittedInd, mThreadId);
     SEND_EVENT();
 }
 
-u8 getNextBufferIndex(u8 index)
+bool isAggregatable(EMessageId messageId)
+{
+    switch (messageId)
+    {
+        case EMessageId_SampleCarrierDataInd :
+        case EMessageId_HeaterTemperatureInd :
+        case EMessageId_ReferenceTemperatureInd :
+        case EMessageId_ControllerDataInd :
+            return true;
+        default :
+            return false;
+    }
+}
+
+void consumeAggregatableBytes(TMessage* message)
+{
+    // Shared with MasterDataTransmitter_transmitAsync(), which decides on the container timer, callers hold mMutexId.
+    u16 bytes = CONTAINER_ENTRY_HEADER_SIZE + message->length;
+    mAggregatableBytesWaiting = ( bytes < mAggregatableBytesWaiting ) ? ( mAggregatableBytesWaiting - bytes ) : 0;
+}
+
+TMessage* packContainer(TMessage* firstMessage)
+{
+    // Called from TransmitData with mMutexId held. Every aggregated entry is popped, and so its lane, waiting count and
+    // aggregatable bytes are updated, before the lock is released for the DMA transfer.
+    TMessage message;
+    CopyObject_TMessage(firstMessage, &message);
+    u16 length = 0;
+    u8 count = 0;
+    
+    while (true)
+    {
+        mContainerData[length++] = message.id;
+        mContainerData[length++] = (u8) ( message.length );
+        memcpy(&(mContainerData[length]), message.data, message.length);
+        length += message.length;
+        ++count;
+        
+        if (1 < count)
+        {
+            MasterDataMemoryManager_free(message.id, message.data);
+        }
+        
+        STxLane* lane = getHighestPriorityLane();
+        if (NULL == lane)
+        {
+            break;
+        }
+        
+        TMessage* nextMessage = peekLane(lane);
+        if ( !isAggregatable(nextMessage->id) || ( (MASTER_FRAME_MAX_PAYLOAD_SIZE - length) < (CONTAINER_ENTRY_HEADER_SIZE + nextMessage->length) ) )
+        {
+            break;
+        }
+        
+        popLane(lane, &message);
+    }
+    
+    if (1 == count)
+    {
+        return firstMessage;
+    }
+    
+    MasterDataMemoryManager_free(firstMessage->id, firstMessage->data);
+    MasterUartGateway_prepareContainer(&mContainerMessage, mContainerData, length);
+    
+    Logger_debugSystem("%s: Packed %u messages into container of %u bytes.", getLoggerPrefix(), count, length);
+    
+    return &mContainerMessage;
+}
+
+void containerTimerCallback(const void* arg)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    if (mIsContainerTimerStarted)
+    {
+        mIsContainerTimerStarted = false;
+        
+        if (!mIsTransmittionOngoing)
+        {
+            mIsTransmittionOngoing = true;
+            CREATE_EVENT_ISR(TransmitData, mThreadId);
+            SEND_EVENT();
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+bool isReliable(EMessageId messageId)
+{
+    // Reliable messages are kept in the Responses lane, which never drops, so none is evicted before its sequence number.
+    // TimeSyncResponse is never retransmitted, a copy sent later would not match its t3; Master simply asks again.
+    return ( (ETxLane_Responses == getLane(messageId)) && (EMessageId_TimeSyncResponse != messageId) );
+}
+
+bool isReliableDeliveryActive(void)
+{
+    return ( mIsReliableDeliveryEnabled && (EFramingMode_Cobs == MasterUartGateway_getFramingMode()) );
+}
+
+bool isReliableWindowFull(u16 dataLength)
+{
+    u16 offset;
+    return ( ( RELIABLE_WINDOW_SIZE <= (u8) ( mNextSequenceNumber - mWindowBaseSequenceNumber ) ) || !reserveReliableArena(dataLength, &offset) );
+}
+
+bool reserveReliableArena(u16 dataLength, u16* offset)
 {
-    ++index;
-    if (MESSAGES_BUFFER_SIZE <= index)
+    // Data is copied in sequence order and its space is reclaimed as the window base advances, so the arena is a ring
+    // starting at the oldest outstanding slot. Data never wraps, and the head never catches up with that slot.
+    if (mWindowBaseSequenceNumber == mNextSequenceNumber)
+    {
+        *offset = 0;
+        return ( RELIABLE_ARENA_SIZE >= dataLength );
+    }
+    
+    u16 tail = mReliableWindow[mWindowBaseSequenceNumber % RELIABLE_WINDOW_SIZE].arenaOffset;
+    
+    if (mReliableArenaHead >= tail)
     {
-        return 0;
+        if ( (RELIABLE_ARENA_SIZE - mReliableArenaHead) >= dataLength )
+        {
+            *offset = mReliableArenaHead;
+            return true;
+        }
+        
+        *offset = 0;
+        return ( tail > dataLength );
     }
-    else
+    
+    *offset = mReliableArenaHead;
+    return ( (tail - mReliableArenaHead) > dataLength );
+}
+
+void assignSequenceNumber(TMessage* message)
+{
+    // The reliable window is shared with acknowledgements and the retransmit timer, which release slots, so all its helpers
+    // are called with mMutexId held.
+    SReliableSlot* slot = &(mReliableWindow[mNextSequenceNumber % RELIABLE_WINDOW_SIZE]);
+    
+    // The pool entry is given back right away, pools of responses are small and Master may pipeline requests of one type.
+    // getHighestPriorityLane() only lets a reliable message through when the arena has room for it.
+    reserveReliableArena(message->length, &(slot->arenaOffset));
+    memcpy(&(mReliableArena[slot->arenaOffset]), message->data, message->length);
+    MasterDataMemoryManager_free(message->id, message->data);
+    mReliableArenaHead = slot->arenaOffset + message->length;
+    
+    message->data = &(mReliableArena[slot->arenaOffset]);
+    message->isReliable = true;
+    message->sequenceNumber = mNextSequenceNumber++;
+    
+    CopyObject_TMessage(message, &(slot->message));
+    slot->age = 0;
+    slot->retries = 0;
+    slot->isUsed = true;
+    slot->isRetransmissionPending = false;
+}
+
+SReliableSlot* getPendingRetransmission(void)
+{
+    if (!hasTxCredit(ETxLane_Responses))
     {
-        return index;
+        return NULL;
     }
+    
+    u8 outstandingCount = (u8) ( mNextSequenceNumber - mWindowBaseSequenceNumber );
+    
+    for (u8 iter = 0; outstandingCount > iter; ++iter)
+    {
+        SReliableSlot* slot = &(mReliableWindow[(u8) ( mWindowBaseSequenceNumber + iter ) % RELIABLE_WINDOW_SIZE]);
+        
+        if ( slot->isUsed && slot->isRetransmissionPending )
+        {
+            return slot;
+        }
+    }
+    
+    return NULL;
+}
+
+void releaseReliableSlot(SReliableSlot* slot)
+{
+    // The arena space is reclaimed by advanceReliableWindow().
+    slot->isUsed = false;
+    slot->isRetransmissionPending = false;
+}
+
+void releaseReliableWindow(void)
+{
+    for (u8 iter = 0; RELIABLE_WINDOW_SIZE > iter; ++iter)
+    {
+        if (mReliableWindow[iter].isUsed)
+        {
+            releaseReliableSlot(&(mReliableWindow[iter]));
+        }
+    }
+    
+    mNextSequenceNumber = 0;
+    mWindowBaseSequenceNumber = 0;
+    mReliableArenaHead = 0;
+}
+
+void advanceReliableWindow(void)
+{
+    while ( (mWindowBaseSequenceNumber != mNextSequenceNumber) && !mReliableWindow[mWindowBaseSequenceNumber % RELIABLE_WINDOW_SIZE].isUsed )
+    {
+        ++mWindowBaseSequenceNumber;
+    }
+}
+
+bool isAnythingToTransmit(void)
+{
+    return ( (NULL != getPendingRetransmission()) || (NULL != getHighestPriorityLane()) );
+}
+
+void retransmitTimerCallback(const void* arg)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    for (u8 iter = 0; RELIABLE_WINDOW_SIZE > iter; ++iter)
+    {
+        SReliableSlot* slot = &(mReliableWindow[iter]);
+        
+        if ( !slot->isUsed || slot->isRetransmissionPending )
+        {
+            continue;
+        }
+        
+        if (RETRANSMIT_TIMEOUT_PERIODS > ++(slot->age))
+        {
+            continue;
+        }
+        
+        if (RETRANSMIT_MAX_RETRIES <= slot->retries)
+        {
+            Logger_warning("%s: Message %s (sequence %u) was not acknowledged by Master. Giving up.", getLoggerPrefix(), CStringConverter_EMessageId(slot->message.id), slot->message.sequenceNumber);
+            releaseReliableSlot(slot);
+        }
+        else
+        {
+            slot->isRetransmissionPending = true;
+        }
+    }
+    
+    advanceReliableWindow();
+    
+    startTransmissionIfIdle();
+    
+    osMutexRelease(mMutexId);
+}
+
+bool isFlowControlActive(void)
+{
+    return ( mIsFlowControlEnabled && (EFramingMode_Cobs == MasterUartGateway_getFramingMode()) );
+}
+
+bool hasTxCredit(ETxLane lane)
+{
+    // The last credits are kept for responses, so telemetry is throttled first when Master falls behind.
+    if (!isFlowControlActive())
+    {
+        return true;
+    }
+    
+    return ( ( (ETxLane_Responses == lane) ? 0 : FLOW_CONTROL_RESPONSES_RESERVED_CREDITS ) < mTxCredits );
+}
+
+void consumeTxCredit(void)
+{
+    if ( !isFlowControlActive() || (0 == mTxCredits) )
+    {
+        return;
+    }
+    
+    if (0 == --mTxCredits)
+    {
+        LinkStatistics_increment(ELinkCounter_TxCreditExhausted);
+        Logger_debugSystem("%s: TX credits exhausted. Waiting for Master to grant more.", getLoggerPrefix());
+    }
+}
+
+ETxLane getLane(EMessageId messageId)
+{
+    return ( EMessageId_Limit > messageId ) ? mMessageLanes[messageId] : ETxLane_Responses;
+}
+
+STxLane* getHighestPriorityLane(void)
+{
+    for (u8 iter = 0; ETxLane_Count > iter; ++iter)
+    {
+        if ( (0 == mLanes[iter].count) || !hasTxCredit((ETxLane) iter) )
+        {
+            continue;
+        }
+        
+        if ( isReliableDeliveryActive() && isReliable(peekLane(&(mLanes[iter]))->id) && isReliableWindowFull(peekLane(&(mLanes[iter]))->length) )
+        {
+            continue;
+        }
+        
+        return &(mLanes[iter]);
+    }
+    
+    return NULL;
+}
+
+TMessage* peekLane(STxLane* lane)
+{
+    return &(lane->messages[lane->head]);
+}
+
+void popLane(STxLane* lane, TMessage* message)
+{
+    CopyObject_TMessage(&(lane->messages[lane->head]), message);
+    lane->head = (lane->head + 1) % lane->capacity;
+    --(lane->count);
+    --mNumberOfWaitingMessagesInBuffer;
+    
+    if (isAggregatable(message->id))
+    {
+        consumeAggregatableBytes(message);
+    }
+}
+
+void pushLane(STxLane* lane, TMessage* message)
+{
+    CopyObject_TMessage(message, &(lane->messages[(lane->head + lane->count) % lane->capacity]));
+    ++(lane->count);
+    ++mNumberOfWaitingMessagesInBuffer;
+    
+    if (isAggregatable(message->id))
+    {
+        mAggregatableBytesWaiting += CONTAINER_ENTRY_HEADER_SIZE + message->length;
+    }
+}
+
+void dropMessage(ETxLane lane, TMessage* message)
+{
+    ++(mLanes[lane].droppedMessagesCount);
+    LinkStatistics_increment(ELinkCounter_TxDroppedMessages);
+    Logger_debugSystem("%s: %s TX lane is full. Message %s dropped.", getLoggerPrefix(), CStringConverter_ETxLane(lane), CStringConverter_EMessageId(message->id));
+    MasterDataMemoryManager_free(message->id, message->data);
 }
 
-#undef MESSAGES_BUFFER_SIZE
+#undef RESPONSES_LANE_CAPACITY
+#undef CONTROL_TELEMETRY_LANE_CAPACITY
+#undef BULK_SAMPLES_LANE_CAPACITY
+#undef BULK_TRANSFER_LANE_CAPACITY
+#undef LOGS_LANE_CAPACITY
+#undef CONTAINER_ENTRY_HEADER_SIZE
+#undef CONTAINER_LATENCY_BUDGET_MS
+#undef RELIABLE_WINDOW_SIZE
+#undef RELIABLE_ARENA_SIZE
+#undef RETRANSMIT_TIMER_PERIOD_MS
+#undef RETRANSMIT_TIMEOUT_PERIODS
+#undef RETRANSMIT_MAX_RETRIES
+#undef FLOW_CONTROL_MAX_CREDITS
+#undef FLOW_CONTROL_RESPONSES_RESERVED_CREDITS
+#undef MESSAGE_LANE
+#undef RAW_MESSAGE_LANE
@@ -3,13 +3,26 @@
 #define _MASTER_DATA_TRANSMITTER_H_
 
 #include "Defines/CommonDefines.h"
+#include "stdbool.h"
 #include "System/ThreadMacros.h"
 #include "SharedDefines/TMessage.h"
+#include "SharedDefines/ETxLane.h"
 
 THREAD_PROTOTYPE(MasterDataTransmitter)
 
 void MasterDataTransmitter_setup(void);
 void MasterDataTransmitter_initialize(void);
 void MasterDataTransmitter_transmitAsync(TMessage* message);
+u32 MasterDataTransmitter_getDroppedMessagesCount(ETxLane lane);
+void MasterDataTransmitter_setReliableDelivery(bool enabled);
+void MasterDataTransmitter_acknowledgeFromISR(u8 nextExpectedSequenceNumber, u8 selectiveAckMask);
+void MasterDataTransmitter_setFlowControl(bool enabled, u8 initialCredits);
+void MasterDataTransmitter_grantCreditsFromISR(u8 credits);
+void MasterDataTransmitter_requestFrameBoundary(void);
+void MasterDataTransmitter_flushContainer(void);
+void MasterDataTransmitter_registerMessageTransmittedCallback(void (*messageTransmittedCallback)(TMessage*));
+void MasterDataTransmitter_deregisterMessageTransmittedCallback(void);
+void MasterDataTransmitter_registerFrameBoundaryCallback(void (*frameBoundaryCallback)(void));
+void MasterDataTransmitter_deregisterFrameBoundaryCallback(void);
 
 #endif
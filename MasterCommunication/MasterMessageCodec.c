@@ -0,0 +1,474 @@
+#include "MasterCommunication/MasterMessageCodec.h"
+
+#include "SharedDefines/MessagesDefines.h"
+
+#include "stddef.h"
+#include "string.h"
+
+typedef enum _EWireType
+{
+    EWireType_U8    = 0,
+    EWireType_U16   = 1,
+    EWireType_U32   = 2,
+    EWireType_F32   = 3,
+    EWireType_F64   = 4,
+    EWireType_U24   = 5
+} EWireType;
+
+typedef struct _SWireField
+{
+    u16 offset;
+    u8 size;
+    EWireType type;
+    u16 capacity;
+    u16 countOffset;
+    u8 countSize;
+    u8 countWireSize;
+} SWireField;
+
+typedef struct _SMessageSchema
+{
+    const SWireField* fields;
+    u8 fieldsCount;
+} SMessageSchema;
+
+#define ELEMENTS_COUNT(array) ( sizeof(array) / sizeof((array)[0]) )
+#define MEMBER(message, field) ( ((T##message*) 0)->field )
+
+#define WIRE_FIELD(message, field, wireType) \
+    { offsetof(T##message, field), sizeof(MEMBER(message, field)), EWireType_##wireType, 1, 0, 0, 0 }
+#define WIRE_FIXED_ARRAY(message, field, wireType) \
+    { offsetof(T##message, field), sizeof(MEMBER(message, field)[0]), EWireType_##wireType, ELEMENTS_COUNT(MEMBER(message, field)), 0, 0, 0 }
+#define WIRE_ARRAY(message, field, wireType, countField) \
+    { offsetof(T##message, field), sizeof(MEMBER(message, field)[0]), EWireType_##wireType, ELEMENTS_COUNT(MEMBER(message, field)), offsetof(T##message, countField), sizeof(MEMBER(message, countField)), 1 }
+#define WIRE_LONG_ARRAY(message, field, wireType, countField) \
+    { offsetof(T##message, field), sizeof(MEMBER(message, field)[0]), EWireType_##wireType, ELEMENTS_COUNT(MEMBER(message, field)), offsetof(T##message, countField), sizeof(MEMBER(message, countField)), 2 }
+#define WIRE_STRING(message, field, lengthField) WIRE_ARRAY(message, field, U8, lengthField)
+
+#define SCHEMA(message) static const SWireField m##message##Schema [] =
+#define SCHEMA_ENTRY(message, id, size, dir, lane) [EMessageId_##message] = { m##message##Schema, ELEMENTS_COUNT(m##message##Schema) },
+#define RAW_MESSAGE_WITHOUT_SCHEMA(message, id, dir, lane)
+
+SCHEMA(LogInd)                                                  { WIRE_FIELD(LogInd, severity, U8), WIRE_STRING(LogInd, data, length) };
+SCHEMA(FaultInd)                                                { WIRE_FIELD(FaultInd, indication.faultId, U8), WIRE_FIELD(FaultInd, indication.faultyUnitId, U8), WIRE_FIELD(FaultInd, indication.faultySubUnitId, U8), WIRE_FIELD(FaultInd, indication.state, U8) };
+SCHEMA(PollingRequest)                                          { WIRE_FIELD(PollingRequest, dummy, U8) };
+SCHEMA(PollingResponse)                                         { WIRE_FIELD(PollingResponse, success, U8) };
+SCHEMA(ResetUnitRequest)                                        { WIRE_FIELD(ResetUnitRequest, unitId, U8) };
+SCHEMA(ResetUnitResponse)                                       { WIRE_FIELD(ResetUnitResponse, unitId, U8), WIRE_FIELD(ResetUnitResponse, success, U8) };
+SCHEMA(SampleCarrierDataInd)                                    { WIRE_FIELD(SampleCarrierDataInd, data.unitId, U8), WIRE_FIELD(SampleCarrierDataInd, data.value, F32), WIRE_FIELD(SampleCarrierDataInd, data.timestamp, U32), WIRE_FIELD(SampleCarrierDataInd, sequenceNumber, U16) };
+SCHEMA(HeaterTemperatureInd)                                    { WIRE_FIELD(HeaterTemperatureInd, temperature, F32), WIRE_FIELD(HeaterTemperatureInd, timestamp, U32), WIRE_FIELD(HeaterTemperatureInd, sequenceNumber, U16) };
+SCHEMA(ReferenceTemperatureInd)                                 { WIRE_FIELD(ReferenceTemperatureInd, temperature, F32), WIRE_FIELD(ReferenceTemperatureInd, timestamp, U32), WIRE_FIELD(ReferenceTemperatureInd, sequenceNumber, U16) };
+SCHEMA(ControllerDataInd)                                       { WIRE_FIELD(ControllerDataInd, type, U8), WIRE_FIELD(ControllerDataInd, value, F32), WIRE_FIELD(ControllerDataInd, timestamp, U32), WIRE_FIELD(ControllerDataInd, sequenceNumber, U16) };
+SCHEMA(SetHeaterPowerRequest)                                   { WIRE_FIELD(SetHeaterPowerRequest, power, F32) };
+SCHEMA(SetHeaterPowerResponse)                                  { WIRE_FIELD(SetHeaterPowerResponse, power, F32), WIRE_FIELD(SetHeaterPowerResponse, success, U8) };
+SCHEMA(CallibreADS1248Request)                                  { WIRE_FIELD(CallibreADS1248Request, callibrationType, U8) };
+SCHEMA(CallibreADS1248Response)                                 { WIRE_FIELD(CallibreADS1248Response, callibrationType, U8), WIRE_FIELD(CallibreADS1248Response, success, U8) };
+SCHEMA(SetChannelGainADS1248Request)                            { WIRE_FIELD(SetChannelGainADS1248Request, value, U8) };
+SCHEMA(SetChannelGainADS1248Response)                           { WIRE_FIELD(SetChannelGainADS1248Response, value, U8), WIRE_FIELD(SetChannelGainADS1248Response, success, U8) };
+SCHEMA(SetChannelSamplingSpeedADS1248Request)                   { WIRE_FIELD(SetChannelSamplingSpeedADS1248Request, value, U8) };
+SCHEMA(SetChannelSamplingSpeedADS1248Response)                  { WIRE_FIELD(SetChannelSamplingSpeedADS1248Response, value, U8), WIRE_FIELD(SetChannelSamplingSpeedADS1248Response, success, U8) };
+SCHEMA(StartRegisteringDataRequest)                             { WIRE_FIELD(StartRegisteringDataRequest, dataType, U8), WIRE_FIELD(StartRegisteringDataRequest, period, U16) };
+SCHEMA(StartRegisteringDataResponse)                            { WIRE_FIELD(StartRegisteringDataResponse, dataType, U8), WIRE_FIELD(StartRegisteringDataResponse, success, U8) };
+SCHEMA(StopRegisteringDataRequest)                              { WIRE_FIELD(StopRegisteringDataRequest, dataType, U8) };
+SCHEMA(StopRegisteringDataResponse)                             { WIRE_FIELD(StopRegisteringDataResponse, dataType, U8), WIRE_FIELD(StopRegisteringDataResponse, success, U8) };
+SCHEMA(SetNewDeviceModeADS1248Request)                          { WIRE_FIELD(SetNewDeviceModeADS1248Request, mode, U8) };
+SCHEMA(SetNewDeviceModeADS1248Response)                         { WIRE_FIELD(SetNewDeviceModeADS1248Response, mode, U8), WIRE_FIELD(SetNewDeviceModeADS1248Response, success, U8) };
+SCHEMA(SetNewDeviceModeLMP90100ControlSystemRequest)            { WIRE_FIELD(SetNewDeviceModeLMP90100ControlSystemRequest, mode, U8) };
+SCHEMA(SetNewDeviceModeLMP90100ControlSystemResponse)           { WIRE_FIELD(SetNewDeviceModeLMP90100ControlSystemResponse, mode, U8), WIRE_FIELD(SetNewDeviceModeLMP90100ControlSystemResponse, success, U8) };
+SCHEMA(SetNewDeviceModeLMP90100SignalsMeasurementRequest)       { WIRE_FIELD(SetNewDeviceModeLMP90100SignalsMeasurementRequest, mode, U8) };
+SCHEMA(SetNewDeviceModeLMP90100SignalsMeasurementResponse)      { WIRE_FIELD(SetNewDeviceModeLMP90100SignalsMeasurementResponse, mode, U8), WIRE_FIELD(SetNewDeviceModeLMP90100SignalsMeasurementResponse, success, U8) };
+SCHEMA(SetControlSystemTypeRequest)                             { WIRE_FIELD(SetControlSystemTypeRequest, type, U8) };
+SCHEMA(SetControlSystemTypeResponse)                            { WIRE_FIELD(SetControlSystemTypeResponse, type, U8), WIRE_FIELD(SetControlSystemTypeResponse, success, U8) };
+SCHEMA(SetControllerTunesRequest)                               { WIRE_FIELD(SetControllerTunesRequest, pid, U8), WIRE_FIELD(SetControllerTunesRequest, tunes.kp, F64), WIRE_FIELD(SetControllerTunesRequest, tunes.ki, F64), WIRE_FIELD(SetControllerTunesRequest, tunes.kd, F64), WIRE_FIELD(SetControllerTunesRequest, tunes.n, F64) };
+SCHEMA(SetControllerTunesResponse)                              { WIRE_FIELD(SetControllerTunesResponse, pid, U8), WIRE_FIELD(SetControllerTunesResponse, success, U8) };
+SCHEMA(SetProcessModelParametersRequest)                        { WIRE_FIELD(SetProcessModelParametersRequest, parameters.dummy, U32) };
+SCHEMA(SetProcessModelParametersResponse)                       { WIRE_FIELD(SetProcessModelParametersResponse, parameters.dummy, U32), WIRE_FIELD(SetProcessModelParametersResponse, success, U8) };
+SCHEMA(SetControllingAlgorithmExecutionPeriodRequest)           { WIRE_FIELD(SetControllingAlgorithmExecutionPeriodRequest, value, U16) };
+SCHEMA(SetControllingAlgorithmExecutionPeriodResponse)          { WIRE_FIELD(SetControllingAlgorithmExecutionPeriodResponse, value, U16), WIRE_FIELD(SetControllingAlgorithmExecutionPeriodResponse, success, U8) };
+SCHEMA(RegisterNewSegmentToProgramRequest)                      { WIRE_FIELD(RegisterNewSegmentToProgramRequest, segment.number, U16), WIRE_FIELD(RegisterNewSegmentToProgramRequest, segment.type, U8), WIRE_FIELD(RegisterNewSegmentToProgramRequest, segment.startTemperature, F32), WIRE_FIELD(RegisterNewSegmentToProgramRequest, segment.stopTemperature, F32), WIRE_FIELD(RegisterNewSegmentToProgramRequest, segment.settingTimeInterval, U32), WIRE_FIELD(RegisterNewSegmentToProgramRequest, segment.temperatureStep, F32) };
+SCHEMA(RegisterNewSegmentToProgramResponse)                     { WIRE_FIELD(RegisterNewSegmentToProgramResponse, segmentNumber, U8), WIRE_FIELD(RegisterNewSegmentToProgramResponse, success, U8) };
+SCHEMA(DeregisterSegmentFromProgramRequest)                     { WIRE_FIELD(DeregisterSegmentFromProgramRequest, segmentNumber, U16) };
+SCHEMA(DeregisterSegmentFromProgramResponse)                    { WIRE_FIELD(DeregisterSegmentFromProgramResponse, segmentNumber, U16), WIRE_FIELD(DeregisterSegmentFromProgramResponse, numberOfRegisteredSegments, U16), WIRE_FIELD(DeregisterSegmentFromProgramResponse, success, U8) };
+SCHEMA(StartSegmentProgramRequest)                              { WIRE_FIELD(StartSegmentProgramRequest, dummy, U8) };
+SCHEMA(StartSegmentProgramResponse)                             { WIRE_FIELD(StartSegmentProgramResponse, success, U8) };
+SCHEMA(StopSegmentProgramRequest)                               { WIRE_FIELD(StopSegmentProgramRequest, dummy, U8) };
+SCHEMA(StopSegmentProgramResponse)                              { WIRE_FIELD(StopSegmentProgramResponse, success, U8) };
+SCHEMA(SegmentStartedInd)                                       { WIRE_FIELD(SegmentStartedInd, segmentNumber, U8), WIRE_FIELD(SegmentStartedInd, leftRegisteredSegments, U8) };
+SCHEMA(SegmentsProgramDoneInd)                                  { WIRE_FIELD(SegmentsProgramDoneInd, realizedSegmentsCount, U8), WIRE_FIELD(SegmentsProgramDoneInd, numberOfLastDoneSegment, U8) };
+SCHEMA(StartReferenceTemperatureStabilizationRequest)           { WIRE_FIELD(StartReferenceTemperatureStabilizationRequest, dummy, U8) };
+SCHEMA(StartReferenceTemperatureStabilizationResponse)          { WIRE_FIELD(StartReferenceTemperatureStabilizationResponse, success, U8) };
+SCHEMA(StopReferenceTemperatureStabilizationRequest)            { WIRE_FIELD(StopReferenceTemperatureStabilizationRequest, dummy, U8) };
+SCHEMA(StopReferenceTemperatureStabilizationResponse)           { WIRE_FIELD(StopReferenceTemperatureStabilizationResponse, success, U8) };
+SCHEMA(SetRTDPolynomialCoefficientsRequest)                     { WIRE_FIXED_ARRAY(SetRTDPolynomialCoefficientsRequest, coefficients.values, F64) };
+SCHEMA(SetRTDPolynomialCoefficientsResponse)                    { WIRE_FIELD(SetRTDPolynomialCoefficientsResponse, success, U8) };
+SCHEMA(UnitReadyInd)                                            { WIRE_FIELD(UnitReadyInd, unitId, U8), WIRE_FIELD(UnitReadyInd, success, U8) };
+SCHEMA(SetHeaterTemperatureInFeedbackModeRequest)               { WIRE_FIELD(SetHeaterTemperatureInFeedbackModeRequest, temperature, F32) };
+SCHEMA(SetHeaterTemperatureInFeedbackModeResponse)              { WIRE_FIELD(SetHeaterTemperatureInFeedbackModeResponse, temperature, F32), WIRE_FIELD(SetHeaterTemperatureInFeedbackModeResponse, success, U8) };
+SCHEMA(SetFramingModeRequest)                                   { WIRE_FIELD(SetFramingModeRequest, mode, U8) };
+SCHEMA(SetFramingModeResponse)                                  { WIRE_FIELD(SetFramingModeResponse, mode, U8), WIRE_FIELD(SetFramingModeResponse, success, U8) };
+SCHEMA(UnexpectedMasterMessageInd)                              { WIRE_FIELD(UnexpectedMasterMessageInd, id, U8) };
+SCHEMA(SetBaudRateRequest)                                      { WIRE_FIELD(SetBaudRateRequest, baudRate, U32) };
+SCHEMA(SetBaudRateResponse)                                     { WIRE_FIELD(SetBaudRateResponse, baudRate, U32), WIRE_FIELD(SetBaudRateResponse, success, U8) };
+SCHEMA(SetStreamFilterRequest)                                  { WIRE_FIELD(SetStreamFilterRequest, dataType, U8), WIRE_FIELD(SetStreamFilterRequest, channel, U8), WIRE_FIELD(SetStreamFilterRequest, filterType, U8), WIRE_FIELD(SetStreamFilterRequest, decimationFactor, U16) };
+SCHEMA(SetStreamFilterResponse)                                 { WIRE_FIELD(SetStreamFilterResponse, dataType, U8), WIRE_FIELD(SetStreamFilterResponse, channel, U8), WIRE_FIELD(SetStreamFilterResponse, success, U8) };
+SCHEMA(SetReliableDeliveryRequest)                              { WIRE_FIELD(SetReliableDeliveryRequest, enabled, U8) };
+SCHEMA(SetReliableDeliveryResponse)                             { WIRE_FIELD(SetReliableDeliveryResponse, enabled, U8), WIRE_FIELD(SetReliableDeliveryResponse, success, U8) };
+SCHEMA(DeliveryAckInd)                                          { WIRE_FIELD(DeliveryAckInd, nextExpectedSequenceNumber, U8), WIRE_FIELD(DeliveryAckInd, selectiveAckMask, U8) };
+SCHEMA(LoadSegmentsProgramRequest)                              { WIRE_FIELD(LoadSegmentsProgramRequest, chunkIndex, U8), WIRE_FIELD(LoadSegmentsProgramRequest, chunksCount, U8), WIRE_ARRAY(LoadSegmentsProgramRequest, numbers, U16, segmentsCount), WIRE_ARRAY(LoadSegmentsProgramRequest, types, U8, segmentsCount), WIRE_ARRAY(LoadSegmentsProgramRequest, startTemperatures, F32, segmentsCount), WIRE_ARRAY(LoadSegmentsProgramRequest, stopTemperatures, F32, segmentsCount), WIRE_ARRAY(LoadSegmentsProgramRequest, settingTimeIntervals, U32, segmentsCount), WIRE_ARRAY(LoadSegmentsProgramRequest, temperatureSteps, F32, segmentsCount) };
+SCHEMA(LoadSegmentsProgramResponse)                             { WIRE_FIELD(LoadSegmentsProgramResponse, chunkIndex, U8), WIRE_FIELD(LoadSegmentsProgramResponse, loadedSegmentsCount, U16), WIRE_FIELD(LoadSegmentsProgramResponse, isProgramApplied, U8), WIRE_FIELD(LoadSegmentsProgramResponse, success, U8) };
+SCHEMA(SnapshotRequest)                                         { WIRE_FIELD(SnapshotRequest, dummy, U8) };
+SCHEMA(SnapshotResponse)                                        { WIRE_FIELD(SnapshotResponse, assemblyTimestamp, U32), WIRE_FIELD(SnapshotResponse, heaterTemperature, F32), WIRE_FIELD(SnapshotResponse, heaterTemperatureTimestamp, U32), WIRE_FIELD(SnapshotResponse, referenceTemperature, F32), WIRE_FIELD(SnapshotResponse, referenceTemperatureTimestamp, U32), WIRE_FIXED_ARRAY(SnapshotResponse, controllerData, F32), WIRE_FIXED_ARRAY(SnapshotResponse, controllerDataTimestamps, U32), WIRE_FIELD(SnapshotResponse, dacOutputVoltage, F32), WIRE_FIELD(SnapshotResponse, dacOutputVoltageTimestamp, U32), WIRE_FIXED_ARRAY(SnapshotResponse, sampleCarrierValues, F32), WIRE_FIXED_ARRAY(SnapshotResponse, sampleCarrierTimestamps, U32), WIRE_FIELD(SnapshotResponse, isProgramRunning, U8), WIRE_FIELD(SnapshotResponse, currentSegmentNumber, U16), WIRE_FIELD(SnapshotResponse, registeredSegmentsCount, U16), WIRE_FIELD(SnapshotResponse, programStatusTimestamp, U32), WIRE_FIELD(SnapshotResponse, validValuesMask, U16) };
+SCHEMA(StartRecordingRequest)                                   { WIRE_FIELD(StartRecordingRequest, capacity, U16) };
+SCHEMA(StartRecordingResponse)                                  { WIRE_FIELD(StartRecordingResponse, capacity, U16), WIRE_FIELD(StartRecordingResponse, success, U8) };
+SCHEMA(StopRecordingRequest)                                    { WIRE_FIELD(StopRecordingRequest, dummy, U8) };
+SCHEMA(StopRecordingResponse)                                   { WIRE_FIELD(StopRecordingResponse, recordedSamplesCount, U16), WIRE_FIELD(StopRecordingResponse, overwrittenSamplesCount, U32), WIRE_FIELD(StopRecordingResponse, success, U8) };
+SCHEMA(ReadRecordingRequest)                                    { WIRE_FIELD(ReadRecordingRequest, firstSampleIndex, U16), WIRE_FIELD(ReadRecordingRequest, chunksCount, U8) };
+SCHEMA(ReadRecordingResponse)                                   { WIRE_FIELD(ReadRecordingResponse, firstSampleIndex, U16), WIRE_FIELD(ReadRecordingResponse, recordedSamplesCount, U16), WIRE_ARRAY(ReadRecordingResponse, unitIds, U8, samplesCount), WIRE_ARRAY(ReadRecordingResponse, values, F32, samplesCount), WIRE_ARRAY(ReadRecordingResponse, timestamps, U32, samplesCount) };
+SCHEMA(TimeSyncRequest)                                         { WIRE_FIELD(TimeSyncRequest, masterTransmitTimestamp, U32), WIRE_FIELD(TimeSyncRequest, previousMasterReceiveTimestamp, U32), WIRE_FIELD(TimeSyncRequest, isMasterTimeReportingEnabled, U8) };
+SCHEMA(TimeSyncResponse)                                        { WIRE_FIELD(TimeSyncResponse, masterTransmitTimestamp, U32), WIRE_FIELD(TimeSyncResponse, deviceReceiveTimestamp, U32), WIRE_FIELD(TimeSyncResponse, previousDeviceTransmitTimestamp, U32), WIRE_FIELD(TimeSyncResponse, offset, U32), WIRE_FIELD(TimeSyncResponse, skewPpm, F32), WIRE_FIELD(TimeSyncResponse, isSynchronized, U8) };
+SCHEMA(SetUnitAddressRequest)                                   { WIRE_FIELD(SetUnitAddressRequest, address, U8) };
+SCHEMA(SetUnitAddressResponse)                                  { WIRE_FIELD(SetUnitAddressResponse, address, U8), WIRE_FIELD(SetUnitAddressResponse, success, U8) };
+SCHEMA(LinkStatisticsRequest)                                   { WIRE_FIELD(LinkStatisticsRequest, reset, U8) };
+SCHEMA(LinkStatisticsResponse)                                  { WIRE_FIXED_ARRAY(LinkStatisticsResponse, counters, U32), WIRE_FIELD(LinkStatisticsResponse, txQueueHighWaterMark, U16), WIRE_FIELD(LinkStatisticsResponse, meanTxLatency, U32), WIRE_FIELD(LinkStatisticsResponse, maxTxLatency, U32), WIRE_FIELD(LinkStatisticsResponse, isReset, U8) };
+SCHEMA(StartTrajectoryRequest)                                  { WIRE_FIELD(StartTrajectoryRequest, underrunPolicy, U8), WIRE_FIELD(StartTrajectoryRequest, prebufferTime, U32) };
+SCHEMA(StartTrajectoryResponse)                                 { WIRE_FIELD(StartTrajectoryResponse, success, U8) };
+SCHEMA(TrajectoryChunkRequest)                                  { WIRE_FIELD(TrajectoryChunkRequest, firstPointIndex, U32), WIRE_FIELD(TrajectoryChunkRequest, isLastChunk, U8), WIRE_ARRAY(TrajectoryChunkRequest, times, U32, pointsCount), WIRE_ARRAY(TrajectoryChunkRequest, temperatures, F32, pointsCount) };
+SCHEMA(TrajectoryChunkResponse)                                 { WIRE_FIELD(TrajectoryChunkResponse, nextPointIndex, U32), WIRE_FIELD(TrajectoryChunkResponse, bufferedPointsCount, U16), WIRE_FIELD(TrajectoryChunkResponse, freePointsCount, U16), WIRE_FIELD(TrajectoryChunkResponse, success, U8) };
+SCHEMA(StopTrajectoryRequest)                                   { WIRE_FIELD(StopTrajectoryRequest, dummy, U8) };
+SCHEMA(StopTrajectoryResponse)                                  { WIRE_FIELD(StopTrajectoryResponse, underrunsCount, U32), WIRE_FIELD(StopTrajectoryResponse, success, U8) };
+SCHEMA(BeginConfigurationBatchRequest)                          { WIRE_FIELD(BeginConfigurationBatchRequest, dummy, U8) };
+SCHEMA(BeginConfigurationBatchResponse)                         { WIRE_FIELD(BeginConfigurationBatchResponse, success, U8) };
+SCHEMA(CommitConfigurationBatchRequest)                         { WIRE_FIELD(CommitConfigurationBatchRequest, dummy, U8) };
+SCHEMA(CommitConfigurationBatchResponse)                        { WIRE_FIELD(CommitConfigurationBatchResponse, stagedChangesCount, U8), WIRE_FIELD(CommitConfigurationBatchResponse, appliedChangesCount, U8), WIRE_FIELD(CommitConfigurationBatchResponse, success, U8) };
+SCHEMA(AbortConfigurationBatchRequest)                          { WIRE_FIELD(AbortConfigurationBatchRequest, dummy, U8) };
+SCHEMA(AbortConfigurationBatchResponse)                         { WIRE_FIELD(AbortConfigurationBatchResponse, discardedChangesCount, U8), WIRE_FIELD(AbortConfigurationBatchResponse, success, U8) };
+SCHEMA(EmergencyStopInd)                                        { WIRE_FIELD(EmergencyStopInd, report.triggerTimestamp, U32), WIRE_FIELD(EmergencyStopInd, report.peltierStopTime, U32), WIRE_FIELD(EmergencyStopInd, report.heaterStopTime, U32), WIRE_FIELD(EmergencyStopInd, report.heaterOutputValue, U16), WIRE_FIELD(EmergencyStopInd, report.wasReferenceStabilizationActive, U8), WIRE_FIELD(EmergencyStopInd, report.wasControllerRunning, U8), WIRE_FIELD(EmergencyStopInd, report.wasSegmentsProgramRunning, U8), WIRE_FIELD(EmergencyStopInd, report.wasTrajectoryRunning, U8), WIRE_FIELD(EmergencyStopInd, report.success, U8) };
+SCHEMA(ClearEmergencyStopRequest)                               { WIRE_FIELD(ClearEmergencyStopRequest, dummy, U8) };
+SCHEMA(ClearEmergencyStopResponse)                              { WIRE_FIELD(ClearEmergencyStopResponse, success, U8) };
+SCHEMA(SetFlowControlRequest)                                   { WIRE_FIELD(SetFlowControlRequest, enabled, U8), WIRE_FIELD(SetFlowControlRequest, initialCredits, U8) };
+SCHEMA(SetFlowControlResponse)                                  { WIRE_FIELD(SetFlowControlResponse, enabled, U8), WIRE_FIELD(SetFlowControlResponse, rxCredits, U8), WIRE_FIELD(SetFlowControlResponse, success, U8) };
+SCHEMA(TxCreditInd)                                             { WIRE_FIELD(TxCreditInd, grantedCredits, U8) };
+SCHEMA(RxCreditInd)                                             { WIRE_FIELD(RxCreditInd, returnedCreditsTotal, U8) };
+SCHEMA(StartBulkTransferRequest)                                { WIRE_FIELD(StartBulkTransferRequest, source, U8), WIRE_FIELD(StartBulkTransferRequest, offset, U32) };
+SCHEMA(StartBulkTransferResponse)                               { WIRE_FIELD(StartBulkTransferResponse, source, U8), WIRE_FIELD(StartBulkTransferResponse, transferId, U8), WIRE_FIELD(StartBulkTransferResponse, totalSize, U32), WIRE_FIELD(StartBulkTransferResponse, success, U8) };
+SCHEMA(BulkChunkInd)                                            { WIRE_FIELD(BulkChunkInd, transferId, U8), WIRE_FIELD(BulkChunkInd, totalSize, U32), WIRE_FIELD(BulkChunkInd, offset, U32), WIRE_LONG_ARRAY(BulkChunkInd, data, U8, length) };
+SCHEMA(LoadCommandScriptRequest)                                { WIRE_FIELD(LoadCommandScriptRequest, chunkIndex, U8), WIRE_FIELD(LoadCommandScriptRequest, chunksCount, U8), WIRE_ARRAY(LoadCommandScriptRequest, code, U8, length) };
+SCHEMA(LoadCommandScriptResponse)                               { WIRE_FIELD(LoadCommandScriptResponse, chunkIndex, U8), WIRE_FIELD(LoadCommandScriptResponse, loadedLength, U16), WIRE_FIELD(LoadCommandScriptResponse, isScriptApplied, U8), WIRE_FIELD(LoadCommandScriptResponse, success, U8) };
+SCHEMA(StartCommandScriptRequest)                               { WIRE_FIELD(StartCommandScriptRequest, dummy, U8) };
+SCHEMA(StartCommandScriptResponse)                              { WIRE_FIELD(StartCommandScriptResponse, success, U8) };
+SCHEMA(StopCommandScriptRequest)                                { WIRE_FIELD(StopCommandScriptRequest, dummy, U8) };
+SCHEMA(StopCommandScriptResponse)                               { WIRE_FIELD(StopCommandScriptResponse, success, U8) };
+SCHEMA(CommandScriptMarkerInd)                                  { WIRE_FIELD(CommandScriptMarkerInd, marker, U16), WIRE_FIELD(CommandScriptMarkerInd, pc, U16), WIRE_FIELD(CommandScriptMarkerInd, timestamp, U32) };
+SCHEMA(CommandScriptDoneInd)                                    { WIRE_FIELD(CommandScriptDoneInd, status, U8), WIRE_FIELD(CommandScriptDoneInd, pc, U16), WIRE_FIELD(CommandScriptDoneInd, executionTime, U32) };
+SCHEMA(SetSampleStreamFormatRequest)                            { WIRE_FIELD(SetSampleStreamFormatRequest, format, U8) };
+SCHEMA(SetSampleStreamFormatResponse)                           { WIRE_FIELD(SetSampleStreamFormatResponse, format, U8), WIRE_FIELD(SetSampleStreamFormatResponse, success, U8) };
+SCHEMA(SampleCarrierConversionDescriptorInd)                    { WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.configurationId, U8), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.thermocoupleReferenceVoltage, F32), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.thermocoupleGain, F32), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.thermocouplePositiveFullScaleCode, U32), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.thermocoupleOutputScale, F32), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.isThermocoupleReferenceClamped, U8), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.rtdReferenceResistance, F32), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.rtdGain, F32), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.rtdComparatorResistance, F32), WIRE_FIELD(SampleCarrierConversionDescriptorInd, descriptor.rtdFullScaleCode, U32), WIRE_FIXED_ARRAY(SampleCarrierConversionDescriptorInd, descriptor.rtdTemperatureCoefficients, F32) };
+SCHEMA(SampleCarrierRawDataInd)                                 { WIRE_FIELD(SampleCarrierRawDataInd, unitId, U8), WIRE_FIELD(SampleCarrierRawDataInd, code, U24), WIRE_FIELD(SampleCarrierRawDataInd, configurationId, U8), WIRE_FIELD(SampleCarrierRawDataInd, timestamp, U32), WIRE_FIELD(SampleCarrierRawDataInd, sequenceNumber, U16) };
+SCHEMA(RequestBusyInd)                                          { WIRE_FIELD(RequestBusyInd, id, U8) };
+
+static const SMessageSchema mSchemas [EMessageId_Limit] =
+{
+    MESSAGES_REGISTRY(SCHEMA_ENTRY, RAW_MESSAGE_WITHOUT_SCHEMA)
+};
+
+static const SMessageSchema* getSchema(EMessageId messageId);
+static u8 getWireSize(EWireType type);
+static bool isValidField(const SWireField* field);
+static u64 readNative(const TByte* source, u8 size);
+static void writeNative(TByte* destination, u8 size, u64 value);
+static bool encodeField(const SWireField* field, const TByte* message, TByte* buffer, u16 bufferSize, u16* position);
+static bool isCountShared(const SMessageSchema* schema, u8 fieldIndex);
+static bool decodeField(const SWireField* field, bool isCountDecoded, const TByte* buffer, u16 length, u16* position, TByte* message);
+
+bool MasterMessageCodec_isSupported(EMessageId messageId)
+{
+    return ( NULL != getSchema(messageId) );
+}
+
+bool MasterMessageCodec_encode(EMessageId messageId, const void* message, TByte* buffer, u16 bufferSize, u16* length)
+{
+    const SMessageSchema* schema = getSchema(messageId);
+    if (NULL == schema)
+    {
+        return false;
+    }
+    
+    u16 position = 0;
+    for (u8 iter = 0; schema->fieldsCount > iter; ++iter)
+    {
+        if (!encodeField(&(schema->fields[iter]), (const TByte*) message, buffer, bufferSize, &position))
+        {
+            return false;
+        }
+    }
+    
+    *length = position;
+    return true;
+}
+
+bool MasterMessageCodec_decode(EMessageId messageId, const TByte* buffer, u16 length, void* message)
+{
+    const SMessageSchema* schema = getSchema(messageId);
+    if (NULL == schema)
+    {
+        return false;
+    }
+    
+    u16 position = 0;
+    for (u8 iter = 0; schema->fieldsCount > iter; ++iter)
+    {
+        if (!decodeField(&(schema->fields[iter]), isCountShared(schema, iter), buffer, length, &position, (TByte*) message))
+        {
+            return false;
+        }
+    }
+    
+    return ( length == position );
+}
+
+const SMessageSchema* getSchema(EMessageId messageId)
+{
+    if ( (ELEMENTS_COUNT(mSchemas) <= (u32) messageId) || (NULL == mSchemas[messageId].fields) )
+    {
+        return NULL;
+    }
+    
+    return &(mSchemas[messageId]);
+}
+
+u8 getWireSize(EWireType type)
+{
+    switch (type)
+    {
+        case EWireType_U8 :
+            return 1;
+        case EWireType_U16 :
+            return 2;
+        case EWireType_U24 :
+            return 3;
+        case EWireType_U32 :
+        case EWireType_F32 :
+            return 4;
+        case EWireType_F64 :
+            return 8;
+        default :
+            return 0;
+    }
+}
+
+bool isValidField(const SWireField* field)
+{
+    u8 wireSize = getWireSize(field->type);
+    
+    if ( (0 == wireSize) || (sizeof(u64) < field->size) )
+    {
+        return false;
+    }
+    
+    if ( (EWireType_F32 == field->type) || (EWireType_F64 == field->type) )
+    {
+        return ( wireSize == field->size );
+    }
+    
+    return true;
+}
+
+u64 readNative(const TByte* source, u8 size)
+{
+    switch (size)
+    {
+        case sizeof(u8) :
+            return *source;
+        case sizeof(u16) :
+        {
+            u16 value;
+            memcpy(&value, source, sizeof(value));
+            return value;
+        }
+        case sizeof(u32) :
+        {
+            u32 value;
+            memcpy(&value, source, sizeof(value));
+            return value;
+        }
+        case sizeof(u64) :
+        {
+            u64 value;
+            memcpy(&value, source, sizeof(value));
+            return value;
+        }
+        default :
+            return 0;
+    }
+}
+
+void writeNative(TByte* destination, u8 size, u64 value)
+{
+    switch (size)
+    {
+        case sizeof(u8) :
+        {
+            *destination = (u8) value;
+            break;
+        }
+        case sizeof(u16) :
+        {
+            u16 nativeValue = (u16) value;
+            memcpy(destination, &nativeValue, sizeof(nativeValue));
+            break;
+        }
+        case sizeof(u32) :
+        {
+            u32 nativeValue = (u32) value;
+            memcpy(destination, &nativeValue, sizeof(nativeValue));
+            break;
+        }
+        case sizeof(u64) :
+        {
+            memcpy(destination, &value, sizeof(value));
+            break;
+        }
+        default :
+            break;
+    }
+}
+
+bool encodeField(const SWireField* field, const TByte* message, TByte* buffer, u16 bufferSize, u16* position)
+{
+    if (!isValidField(field))
+    {
+        return false;
+    }
+    
+    u8 wireSize = getWireSize(field->type);
+    u64 count = field->capacity;
+    
+    if (0 != field->countSize)
+    {
+        count = readNative(&(message[field->countOffset]), field->countSize);
+        
+        if ( (field->capacity < count) || (0 != ( count >> (8 * field->countWireSize) )) || ( (bufferSize - *position) < field->countWireSize ) )
+        {
+            return false;
+        }
+        
+        for (u8 iter = 0; field->countWireSize > iter; ++iter)
+        {
+            buffer[(*position)++] = (TByte) ( ( count >> (8 * iter) ) & 0xFF );
+        }
+    }
+    
+    if ( (bufferSize - *position) < (count * wireSize) )
+    {
+        return false;
+    }
+    
+    for (u16 element = 0; count > element; ++element)
+    {
+        u64 value = readNative(&(message[field->offset + element * field->size]), field->size);
+        
+        if ( (sizeof(u64) > wireSize) && (0 != ( value >> (8 * wireSize) )) )
+        {
+            return false;
+        }
+        
+        for (u8 iter = 0; wireSize > iter; ++iter)
+        {
+            buffer[(*position)++] = (TByte) ( ( value >> (8 * iter) ) & 0xFF );
+        }
+    }
+    
+    return true;
+}
+
+bool isCountShared(const SMessageSchema* schema, u8 fieldIndex)
+{
+    const SWireField* field = &(schema->fields[fieldIndex]);
+    
+    if (0 == field->countSize)
+    {
+        return false;
+    }
+    
+    for (u8 iter = 0; fieldIndex > iter; ++iter)
+    {
+        if ( (0 != schema->fields[iter].countSize) && (field->countOffset == schema->fields[iter].countOffset) )
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool decodeField(const SWireField* field, bool isCountDecoded, const TByte* buffer, u16 length, u16* position, TByte* message)
+{
+    if (!isValidField(field))
+    {
+        return false;
+    }
+    
+    u8 wireSize = getWireSize(field->type);
+    u16 count = field->capacity;
+    
+    if (0 != field->countSize)
+    {
+        if ( (length - *position) < field->countWireSize )
+        {
+            return false;
+        }
+        
+        count = 0;
+        for (u8 iter = 0; field->countWireSize > iter; ++iter)
+        {
+            count |= ( ( (u16) ( buffer[(*position)++] ) ) << (8 * iter) );
+        }
+        
+        if (field->capacity < count)
+        {
+            return false;
+        }
+        
+        // Arrays sharing one count field carry their own count prefix on the wire, a frame where they differ is malformed.
+        if ( isCountDecoded && (readNative(&(message[field->countOffset]), field->countSize) != count) )
+        {
+            return false;
+        }
+        
+        writeNative(&(message[field->countOffset]), field->countSize, count);
+    }
+    
+    if ( (length - *position) < (count * wireSize) )
+    {
+        return false;
+    }
+    
+    for (u16 element = 0; count > element; ++element)
+    {
+        u64 value = 0;
+        for (u8 iter = 0; wireSize > iter; ++iter)
+        {
+            value |= ( ( (u64) ( buffer[(*position)++] ) ) << (8 * iter) );
+        }
+        
+        if ( (sizeof(u64) > field->size) && (0 != ( value >> (8 * field->size) )) )
+        {
+            return false;
+        }
+        
+        writeNative(&(message[field->offset + element * field->size]), field->size, value);
+    }
+    
+    return true;
+}
+
+#undef ELEMENTS_COUNT
+#undef MEMBER
+#undef WIRE_FIELD
+#undef WIRE_FIXED_ARRAY
+#undef WIRE_ARRAY
+#undef WIRE_LONG_ARRAY
+#undef WIRE_STRING
+#undef SCHEMA
+#undef SCHEMA_ENTRY
+#undef RAW_MESSAGE_WITHOUT_SCHEMA
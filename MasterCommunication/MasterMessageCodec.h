@@ -0,0 +1,13 @@
+#ifndef _MASTER_MESSAGE_CODEC_H_
+
+#define _MASTER_MESSAGE_CODEC_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/EMessageId.h"
+#include "stdbool.h"
+
+bool MasterMessageCodec_isSupported(EMessageId messageId);
+bool MasterMessageCodec_encode(EMessageId messageId, const void* message, TByte* buffer, u16 bufferSize, u16* length);
+bool MasterMessageCodec_decode(EMessageId messageId, const TByte* buffer, u16 length, void* message);
+
+#endif
@@ -2,55 +2,209 @@
 #include "MasterCommunication/MasterDataMemoryManager.h"
 #include "MasterCommunication/MasterDataManager.h"
 #include "MasterCommunication/MasterDataTransmitter.h"
+#include "MasterCommunication/MasterDataReceiver.h"
+#include "MasterCommunication/MasterMessageCodec.h"
+#include "MasterCommunication/TimeSynchronizer.h"
+#include "MasterCommunication/LinkStatistics.h"
+#include "MasterCommunication/BulkTransfer.h"
 
+#include "Peripherals/UART1.h"
+#include "Peripherals/FlashStorage.h"
 #include "SharedDefines/TMessage.h"
 #include "SharedDefines/MessagesDefines.h"
 #include "System/ThreadMacros.h"
 #include "Utilities/CopyObject.h"
+#include "FaultManagement/FaultIndication.h"
 
 #include "cmsis_os.h"
+#include "stm32f4xx_hal.h"
+#include "string.h"
+
+#define RX_FRAME_BUFFERS_COUNT 6
+#define RX_CREDIT_RESERVED_FRAMES 2
+#define RX_CREDIT_REPORT_THRESHOLD 2
+#define RX_CREDIT_REPORT_RETRY_MS 10
+#define BAUD_RATE_VERIFICATION_TIMEOUT_MS 1000
 
 static osMutexDef(mMutex);
 static osMutexId mMutexId = NULL;
 
-static u16 calculateCrcValue(u8 dataLength, TByte* data);
+static volatile EFramingMode mFramingMode = EFramingMode_Legacy;
+static volatile EFramingMode mPendingFramingMode = EFramingMode_Legacy;
+static volatile bool mIsFramingModeChangePending = false;
+
+static volatile TUartBaudRate mPendingBaudRate = 0;
+static volatile bool mIsBaudRateChangePending = false;
+static TUartBaudRate mPreviousBaudRate = 0;
+static volatile bool mIsBaudRateVerificationPending = false;
+static osTimerId mBaudRateVerificationTimerId = NULL;
+
+static TByte mTxDecodedFrame [MASTER_FRAME_MAX_EXTENDED_DECODED_SIZE];
+static TByte mRxFrameBuffers [RX_FRAME_BUFFERS_COUNT][MASTER_FRAME_MAX_DECODED_SIZE];
+static volatile bool mIsRxFrameBufferUsed [RX_FRAME_BUFFERS_COUNT];
+static u8 mActiveRxFrameBuffer = 0;
+static SCobsDecoder mRxDecoder;
+static SCobsDecoder mEmergencyStopDecoder;
+static TByte mEmergencyStopFrame [MASTER_EMERGENCY_STOP_FRAME_SIZE];
+static TByte mCodecBuffer [MASTER_FRAME_MAX_EXTENDED_PAYLOAD_SIZE];
+
+static volatile u8 mUnitAddress = MASTER_UNIT_ADDRESS_DEFAULT;
+
+static volatile bool mIsFlowControlEnabled = false;
+static volatile u8 mRxCreditsReturnedTotal = 0;
+static volatile u8 mUnreportedRxCredits = 0;
+static bool mIsRxFrameSkipped = false;
+static osTimerId mRxCreditReportTimerId = NULL;
+
+static u16 calculateCrcValue(u16 dataLength, TByte* data);
+static void sendMessage(EMessageId messageType, void* message, u8 transactionId);
+static bool prepareMessage(EMessageId messageType, void* message, u8 transactionId, TMessage* packedMessage);
+static void indicateDroppedMessage(EMessageId messageType);
+static void reportRxCredits(void);
+static void messageTransmittedCallback(TMessage* message);
+static void startDecodingNewRxFrame(void);
+static bool isEmergencyStopFrame(const TByte* frame, u16 frameLength);
+#ifdef USE_FULL_ASSERT
+static void checkEmergencyStopWithoutRxBuffers(void);
+#endif
+static void applyPendingBaudRate(void);
+static void baudRateVerificationTimeoutCallback(const void* arg);
+static void frameBoundaryCallback(void);
+static void rxCreditReportTimerCallback(const void* arg);
 static const char* getLoggerPrefix(void);
 
 void MasterUartGateway_setup(void)
 {
     mMutexId = osMutexCreate(osMutex(mMutex));
+    
+    osTimerDef(baudRateVerificationTimer, baudRateVerificationTimeoutCallback);
+    mBaudRateVerificationTimerId = osTimerCreate(osTimer(baudRateVerificationTimer), osTimerOnce, NULL);
+    
+    osTimerDef(rxCreditReportTimer, rxCreditReportTimerCallback);
+    mRxCreditReportTimerId = osTimerCreate(osTimer(rxCreditReportTimer), osTimerOnce, NULL);
+    
+    Cobs_initializeDecoder(&mEmergencyStopDecoder, mEmergencyStopFrame, MASTER_EMERGENCY_STOP_FRAME_SIZE);
+    
+#ifdef USE_FULL_ASSERT
+    checkEmergencyStopWithoutRxBuffers();
+#endif
 }
 
 void MasterUartGateway_initialize(void)
 {
     osMutexWait(mMutexId, osWaitForever);
+    MasterDataTransmitter_registerMessageTransmittedCallback(messageTransmittedCallback);
+    MasterDataTransmitter_registerFrameBoundaryCallback(frameBoundaryCallback);
+    
+    u32 storedAddress;
+    if ( FlashStorage_read(EFlashStorageKey_UnitAddress, &storedAddress) && (MASTER_UNIT_ADDRESS_BROADCAST > storedAddress) )
+    {
+        mUnitAddress = (u8) ( storedAddress );
+    }
+    
+    Logger_info("%s: Unit address: %u.", getLoggerPrefix(), mUnitAddress);
     Logger_debugSystem("MasterUartGateway: Initialized!");
     osMutexRelease(mMutexId);
 }
 
 void MasterUartGateway_sendMessage(EMessageId messageType, void* message)
+{
+    sendMessage(messageType, message, 0);
+}
+
+void MasterUartGateway_sendResponse(EMessageId messageType, void* message, const TRequestContext* context)
+{
+    // Broadcast requests are executed by every unit on the bus, but none of them answers to avoid collisions.
+    // The flag travels with the request context, so delayed responses are suppressed as well.
+    if (context->isBroadcast)
+    {
+        Logger_debugSystem("%s: Response %s to broadcast request is suppressed.", getLoggerPrefix(), CStringConverter_EMessageId(messageType));
+        MasterDataMemoryManager_free(messageType, message);
+        return;
+    }
+    
+    sendMessage(messageType, message, context->transactionId);
+}
+
+void MasterUartGateway_indicateBusyRequest(EMessageId requestId, const TRequestContext* context)
+{
+    // Master retries a busy request later instead of waiting for its response until timeout.
+    TRequestBusyInd* indication = MasterDataMemoryManager_allocate(EMessageId_RequestBusyInd);
+    if (NULL == indication)
+    {
+        Logger_error("%s: Allocating memory for %s failed, request %s is rejected silently.", getLoggerPrefix(), CStringConverter_EMessageId(EMessageId_RequestBusyInd), CStringConverter_EMessageId(requestId));
+        return;
+    }
+    
+    indication->id = requestId;
+    MasterUartGateway_sendResponse(EMessageId_RequestBusyInd, indication, context);
+}
+
+void sendMessage(EMessageId messageType, void* message, u8 transactionId)
 {
     osMutexWait(mMutexId, osWaitForever);
     
     TMessage packedMessage;
-    packedMessage.id = messageType;
-    packedMessage.transactionId = 0;
-    packedMessage.data = message;
-    packedMessage.length = MasterDataMemoryManager_getLength(messageType);
+    bool isPrepared = prepareMessage(messageType, message, transactionId, &packedMessage);
+    
+    osMutexRelease(mMutexId);
     
-    if (EMessageId_LogInd == messageType)
+    if (!isPrepared)
     {
-        TLogInd* logInd = (TLogInd*) message;
-        packedMessage.length = packedMessage.length - (MAX_LOG_SIZE - logInd->length);
+        indicateDroppedMessage(messageType);
+        return;
     }
     
-    packedMessage.crc = calculateCrcValue(packedMessage.length, packedMessage.data);
+    // A full Responses lane makes the transmitter wait, which must never happen with the gateway lock held.
+    MasterDataTransmitter_transmitAsync(&packedMessage);
+}
+
+bool prepareMessage(EMessageId messageType, void* message, u8 transactionId, TMessage* packedMessage)
+{
+    // Uses the shared codec buffer, callers hold mMutexId.
+    packedMessage->id = messageType;
+    packedMessage->transactionId = transactionId;
+    packedMessage->data = message;
+    packedMessage->length = MasterDataMemoryManager_getLength(messageType);
+    packedMessage->isReliable = false;
+    packedMessage->isBroadcast = false;
+    packedMessage->sequenceNumber = 0;
+    packedMessage->timestamp = 0;
     
-    Logger_debugSystem("MasterUartGateway: Message %s prepared and will be sent to Master.", CStringConverter_EMessageId(packedMessage.id));
+    u16 encodedLength;
+    u16 codecBufferSize = ( MASTER_FRAME_MAX_EXTENDED_PAYLOAD_SIZE < packedMessage->length ) ? MASTER_FRAME_MAX_EXTENDED_PAYLOAD_SIZE : packedMessage->length;
+    if (!MasterMessageCodec_encode(messageType, message, mCodecBuffer, codecBufferSize, &encodedLength))
+    {
+        Logger_error("%s: Encoding message %s failed. Message dropped.", getLoggerPrefix(), CStringConverter_EMessageId(messageType));
+        MasterDataMemoryManager_free(messageType, message);
+        return false;
+    }
     
-    MasterDataTransmitter_transmitAsync(&packedMessage);
+    memcpy(message, mCodecBuffer, encodedLength);
+    packedMessage->length = encodedLength;
     
-    osMutexRelease(mMutexId);
+    if ( (MASTER_FRAME_MAX_PAYLOAD_SIZE < packedMessage->length) && (EFramingMode_Cobs != mFramingMode) )
+    {
+        Logger_error("%s: Message %s of %u bytes needs %s framing mode. Message dropped.", getLoggerPrefix(), CStringConverter_EMessageId(messageType), packedMessage->length, CStringConverter_EFramingMode(EFramingMode_Cobs));
+        MasterDataMemoryManager_free(messageType, message);
+        return false;
+    }
+    
+    packedMessage->crc = calculateCrcValue(packedMessage->length, packedMessage->data);
+    
+    Logger_debugSystem("MasterUartGateway: Message %s (transaction %u) prepared and will be sent to Master.", CStringConverter_EMessageId(packedMessage->id), packedMessage->transactionId);
+    
+    return true;
+}
+
+void indicateDroppedMessage(EMessageId messageType)
+{
+    // Fault indication is itself sent through the gateway, so it is raised without the gateway lock held and
+    // never for a dropped fault indication.
+    if (EMessageId_FaultInd != messageType)
+    {
+        FaultIndication_start(EFaultId_WrongData, EUnitId_Nucleo, EUnitId_Empty);
+    }
 }
 
 void MasterUartGateway_handleReceivedMessage(TMessage message)
@@ -60,7 +214,38 @@ void MasterUartGateway_handleReceivedMessage(TMessage message)
     bool verifyingResult = ( calculateCrcValue(message.length, message.data) == message.crc );
     if (verifyingResult)
     {
-        Logger_info("MasterUartGateway: Message %s received and passed CRC verification.", CStringConverter_EMessageId(message.id));
+        memcpy(mCodecBuffer, message.data, message.length);
+        memset(message.data, 0, MasterDataMemoryManager_getLength(message.id));
+        
+        if (!MasterMessageCodec_decode(message.id, mCodecBuffer, message.length, message.data))
+        {
+            Logger_error("%s: Message %s received but its payload could not be decoded.", getLoggerPrefix(), CStringConverter_EMessageId(message.id));
+            MasterDataMemoryManager_free(message.id, message.data);
+            osMutexRelease(mMutexId);
+            MasterUartGateway_returnRxCredit(message.id);
+            return;
+        }
+        
+        message.length = MasterDataMemoryManager_getLength(message.id);
+        
+        if (mIsBaudRateVerificationPending)
+        {
+            mIsBaudRateVerificationPending = false;
+            osTimerStop(mBaudRateVerificationTimerId);
+            Logger_info("%s: Link verified at %u baud.", getLoggerPrefix(), UART1_getBaudRate());
+        }
+        
+        Logger_info("MasterUartGateway: Message %s (transaction %u) received and passed CRC verification.", CStringConverter_EMessageId(message.id), message.transactionId);
+        
+        if ( (EMessageId_TxCreditInd == message.id) || (EMessageId_DeliveryAckInd == message.id) )
+        {
+            // Valid grants and acknowledgements are consumed in the RX ISR, see MasterUartGateway_isTxCreditFrame()
+            // and MasterUartGateway_isDeliveryAckFrame().
+            Logger_warning("%s: %s outside of flow control framing is ignored.", getLoggerPrefix(), CStringConverter_EMessageId(message.id));
+            MasterDataMemoryManager_free(message.id, message.data);
+            osMutexRelease(mMutexId);
+            return;
+        }
         
         CREATE_EVENT_ISR(DataFromMasterReceivedInd, EThreadId_MasterDataManager);
         CREATE_EVENT_MESSAGE(DataFromMasterReceivedInd);
@@ -71,14 +256,607 @@ void MasterUartGateway_handleReceivedMessage(TMessage message)
     }
     else
     {
+        LinkStatistics_increment(ELinkCounter_CrcErrors);
         Logger_debugSystem("MasterUartGateway: Message %s received but CRC verification failed.", CStringConverter_EMessageId(message.id));
         MasterDataMemoryManager_free(message.id, message.data);
+        osMutexRelease(mMutexId);
+        MasterUartGateway_returnRxCredit(message.id);
+        return;
     }
     
     osMutexRelease(mMutexId);
 }
 
-u16 calculateCrcValue(u8 dataLength, TByte* data)
+bool MasterUartGateway_changeBaudRate(u32 baudRate)
+{
+    if (!UART1_isBaudRateSupported(baudRate))
+    {
+        Logger_warning("%s: Baud rate %u is not supported.", getLoggerPrefix(), baudRate);
+        return false;
+    }
+    
+    mPendingBaudRate = baudRate;
+    mIsBaudRateChangePending = true;
+    
+    Logger_info("%s: Baud rate %u will be used after the response is transmitted.", getLoggerPrefix(), baudRate);
+    
+    return true;
+}
+
+void MasterUartGateway_prepareContainer(TMessage* container, TByte* payload, u16 length)
+{
+    container->id = EMessageId_ContainerInd;
+    container->transactionId = 0;
+    container->data = payload;
+    container->length = length;
+    container->isReliable = false;
+    container->isBroadcast = false;
+    container->sequenceNumber = 0;
+    container->timestamp = 0;
+    container->crc = calculateCrcValue(container->length, container->data);
+}
+
+EFramingMode MasterUartGateway_getFramingMode(void)
+{
+    return mFramingMode;
+}
+
+bool MasterUartGateway_changeFramingMode(EFramingMode framingMode)
+{
+    if ( (EFramingMode_Legacy != framingMode) && (EFramingMode_Cobs != framingMode) )
+    {
+        Logger_warning("%s: Framing mode %s is not supported.", getLoggerPrefix(), CStringConverter_EFramingMode(framingMode));
+        return false;
+    }
+    
+    mPendingFramingMode = framingMode;
+    mIsFramingModeChangePending = true;
+    
+    Logger_info("%s: Framing mode %s will be used after the response is transmitted.", getLoggerPrefix(), CStringConverter_EFramingMode(framingMode));
+    
+    return true;
+}
+
+bool MasterUartGateway_changeReliableDelivery(bool enabled)
+{
+    if ( enabled && (EFramingMode_Cobs != mFramingMode) )
+    {
+        Logger_warning("%s: Reliable delivery requires %s framing mode.", getLoggerPrefix(), CStringConverter_EFramingMode(EFramingMode_Cobs));
+        return false;
+    }
+    
+    MasterDataTransmitter_setReliableDelivery(enabled);
+    
+    Logger_info("%s: Reliable delivery %s.", getLoggerPrefix(), enabled ? "enabled" : "disabled");
+    
+    return true;
+}
+
+bool MasterUartGateway_changeFlowControl(bool enabled, u8 initialCredits, u8* rxCredits)
+{
+    if ( enabled && (EFramingMode_Cobs != mFramingMode) )
+    {
+        Logger_warning("%s: Flow control requires %s framing mode.", getLoggerPrefix(), CStringConverter_EFramingMode(EFramingMode_Cobs));
+        return false;
+    }
+    
+    if ( enabled && (0 == initialCredits) )
+    {
+        Logger_warning("%s: Flow control cannot be enabled without initial credits.", getLoggerPrefix());
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    // One buffer is always kept for the frame being decoded and one for Link frames, which never consume credit.
+    u8 freeBuffersCount = 0;
+    for (u8 iter = 0; RX_FRAME_BUFFERS_COUNT > iter; ++iter)
+    {
+        if (!mIsRxFrameBufferUsed[iter])
+        {
+            ++freeBuffersCount;
+        }
+    }
+    
+    *rxCredits = ( RX_CREDIT_RESERVED_FRAMES - 1 < freeBuffersCount ) ? ( freeBuffersCount - (RX_CREDIT_RESERVED_FRAMES - 1) ) : 0;
+    
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    mRxCreditsReturnedTotal = 0;
+    mUnreportedRxCredits = 0;
+    __set_PRIMASK(primask);
+    
+    mIsFlowControlEnabled = enabled;
+    
+    MasterDataTransmitter_setFlowControl(enabled, initialCredits);
+    
+    osMutexRelease(mMutexId);
+    
+    Logger_info("%s: Flow control %s (TX credits: %u, RX credits: %u).", getLoggerPrefix(), enabled ? "enabled" : "disabled", initialCredits, *rxCredits);
+    
+    return true;
+}
+
+void MasterUartGateway_returnRxCredit(EMessageId messageId)
+{
+    // Called once a request is done with, by whichever thread executed or discarded it, so the counters are guarded
+    // by a critical section, which is cheaper than the gateway lock.
+    if (!mIsFlowControlEnabled)
+    {
+        return;
+    }
+    
+    if ( (EMessageId_DeliveryAckInd == messageId) || (EMessageId_TxCreditInd == messageId) )
+    {
+        return;
+    }
+    
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    ++mRxCreditsReturnedTotal;
+    u8 unreportedRxCredits = ++mUnreportedRxCredits;
+    __set_PRIMASK(primask);
+    
+    if (RX_CREDIT_REPORT_THRESHOLD <= unreportedRxCredits)
+    {
+        reportRxCredits();
+    }
+}
+
+u16 MasterUartGateway_encodeFrame(TMessage* message, TByte* frame)
+{
+    u16 headerSize = MASTER_FRAME_HEADER_SIZE;
+    
+    mTxDecodedFrame[0] = 0;
+    mTxDecodedFrame[1] = mUnitAddress;
+    mTxDecodedFrame[2] = message->id;
+    mTxDecodedFrame[3] = message->transactionId;
+    mTxDecodedFrame[4] = ( message->crc & 0xFF );
+    mTxDecodedFrame[5] = ( ( message->crc >> 8 ) & 0xFF );
+    mTxDecodedFrame[6] = ( message->length & 0xFF );
+    
+    if (MASTER_FRAME_MAX_PAYLOAD_SIZE < message->length)
+    {
+        mTxDecodedFrame[0] |= MASTER_FRAME_FLAG_EXTENDED_LENGTH;
+        mTxDecodedFrame[headerSize++] = ( ( message->length >> 8 ) & 0xFF );
+    }
+    
+    if (message->isReliable)
+    {
+        mTxDecodedFrame[0] |= MASTER_FRAME_FLAG_RELIABLE;
+        mTxDecodedFrame[headerSize++] = message->sequenceNumber;
+    }
+    
+    memcpy(&(mTxDecodedFrame[headerSize]), message->data, message->length);
+    
+    u16 frameLength = Cobs_encode(mTxDecodedFrame, headerSize + message->length, frame);
+    frame[frameLength++] = COBS_DELIMITER;
+    
+    return frameLength;
+}
+
+TByte* MasterUartGateway_decodeReceivedByte(TByte byte, u16* frameLength)
+{
+    if (NULL == mRxDecoder.buffer)
+    {
+        // No free RX frame buffer, the frame is skipped up to its delimiter.
+        if (COBS_DELIMITER != byte)
+        {
+            mIsRxFrameSkipped = true;
+            return NULL;
+        }
+        
+        if (mIsRxFrameSkipped)
+        {
+            mIsRxFrameSkipped = false;
+            LinkStatistics_increment(ELinkCounter_RxFramesOverCredit);
+        }
+        
+        startDecodingNewRxFrame();
+        return NULL;
+    }
+    
+    switch (Cobs_decodeByte(&mRxDecoder, byte))
+    {
+        case ECobsDecoderStatus_FrameDone :
+        {
+            TByte* frame = mRxDecoder.buffer;
+            *frameLength = mRxDecoder.length;
+            LinkStatistics_increment(ELinkCounter_FramesReceived);
+            startDecodingNewRxFrame();
+            return frame;
+        }
+        
+        case ECobsDecoderStatus_FrameCorrupted :
+        {
+            LinkStatistics_increment(ELinkCounter_CorruptedFrames);
+            Cobs_initializeDecoder(&mRxDecoder, mRxDecoder.buffer, MASTER_FRAME_MAX_DECODED_SIZE);
+            break;
+        }
+        
+        default :
+            break;
+    }
+    
+    return NULL;
+}
+
+bool MasterUartGateway_decodeFrame(TByte* frame, u16 frameLength, TMessage* message)
+{
+    if (MASTER_FRAME_HEADER_SIZE > frameLength)
+    {
+        LinkStatistics_increment(ELinkCounter_MalformedHeaders);
+        Logger_error("%s: Received frame is too short (%u bytes).", getLoggerPrefix(), frameLength);
+        return false;
+    }
+    
+    u16 headerSize = MASTER_FRAME_HEADER_SIZE;
+    
+    message->id = (EMessageId) ( frame[2] );
+    message->transactionId = frame[3];
+    message->crc = ( frame[4] | ( ( ( (u16) ( frame[5] )) << 8 ) & 0xFF00 ) );
+    message->length = frame[6];
+    message->isReliable = ( 0 != ( frame[0] & MASTER_FRAME_FLAG_RELIABLE ) );
+    message->isBroadcast = ( MASTER_UNIT_ADDRESS_BROADCAST == frame[1] );
+    message->sequenceNumber = 0;
+    message->timestamp = 0;
+    
+    if ( ( 0 != ( frame[0] & MASTER_FRAME_FLAG_EXTENDED_LENGTH ) ) && (headerSize < frameLength) )
+    {
+        message->length |= ( ( (u16) ( frame[headerSize++] ) ) << 8 );
+    }
+    
+    if ( message->isReliable && (headerSize < frameLength) )
+    {
+        message->sequenceNumber = frame[headerSize++];
+    }
+    
+    if ( (0 != ( frame[0] & ~( MASTER_FRAME_FLAG_RELIABLE | MASTER_FRAME_FLAG_EXTENDED_LENGTH ) )) || ( (frameLength - headerSize) != message->length ) )
+    {
+        LinkStatistics_increment(ELinkCounter_MalformedHeaders);
+        Logger_error("%s: Received frame header is corrupted (Message: %s).", getLoggerPrefix(), CStringConverter_EMessageId(message->id));
+        return false;
+    }
+    
+    if ( (EMessageId_Limit <= message->id) || (0 == MasterDataMemoryManager_getLength(message->id)) )
+    {
+        LinkStatistics_increment(ELinkCounter_UnknownMessageIds);
+        Logger_error("%s: Received frame carries unknown message id %u.", getLoggerPrefix(), message->id);
+        return false;
+    }
+    
+    message->data = (TByte*) ( MasterDataMemoryManager_allocate(message->id) );
+    if (NULL == message->data)
+    {
+        Logger_error("%s: Allocating memory for message %s failed.", getLoggerPrefix(), CStringConverter_EMessageId(message->id));
+        TRequestContext context = { message->transactionId, message->isBroadcast, false };
+        MasterUartGateway_indicateBusyRequest(message->id, &context);
+        return false;
+    }
+    
+    if (MasterDataMemoryManager_getLength(message->id) < message->length)
+    {
+        Logger_error("%s: Received message %s is longer than expected (%u bytes).", getLoggerPrefix(), CStringConverter_EMessageId(message->id), message->length);
+        MasterDataMemoryManager_free(message->id, message->data);
+        return false;
+    }
+    
+    memcpy(message->data, &(frame[headerSize]), message->length);
+    
+    return true;
+}
+
+void MasterUartGateway_releaseFrame(TByte* frame)
+{
+    for (u8 iter = 0; RX_FRAME_BUFFERS_COUNT > iter; ++iter)
+    {
+        if (mRxFrameBuffers[iter] == frame)
+        {
+            mIsRxFrameBufferUsed[iter] = false;
+            return;
+        }
+    }
+}
+
+bool MasterUartGateway_isFrameAddressedToUnit(const TByte* frame, u16 frameLength)
+{
+    // Called from UART ISR, frames too short to carry the address are left to the header verification.
+    if (2 > frameLength)
+    {
+        return true;
+    }
+    
+    return ( (mUnitAddress == frame[1]) || (MASTER_UNIT_ADDRESS_BROADCAST == frame[1]) );
+}
+
+bool MasterUartGateway_isEmergencyStopByte(TByte byte)
+{
+    // Called from UART ISR for every received byte, before it is decoded. The reserved frame is decoded into its own
+    // buffer, so it gets through even when every RX frame buffer is taken. Longer frames overflow it and are ignored.
+    ECobsDecoderStatus status = Cobs_decodeByte(&mEmergencyStopDecoder, byte);
+    if (ECobsDecoderStatus_InProgress == status)
+    {
+        return false;
+    }
+    
+    bool isEmergencyStop = ( (ECobsDecoderStatus_FrameDone == status) && isEmergencyStopFrame(mEmergencyStopFrame, mEmergencyStopDecoder.length) );
+    Cobs_initializeDecoder(&mEmergencyStopDecoder, mEmergencyStopFrame, MASTER_EMERGENCY_STOP_FRAME_SIZE);
+    
+    return isEmergencyStop;
+}
+
+bool isEmergencyStopFrame(const TByte* frame, u16 frameLength)
+{
+    if (MASTER_EMERGENCY_STOP_FRAME_SIZE != frameLength)
+    {
+        return false;
+    }
+    
+    if ( (0xE5 != frame[0]) || (0x70 != frame[2]) || (0x5A != frame[3]) )
+    {
+        return false;
+    }
+    
+    return ( (mUnitAddress == frame[1]) || (MASTER_UNIT_ADDRESS_BROADCAST == frame[1]) );
+}
+
+bool MasterUartGateway_isTxCreditFrame(const TByte* frame, u16 frameLength, u8* credits)
+{
+    // Called from UART ISR, credit grants must not wait behind requests that are themselves blocked on credit.
+    if ( !mIsFlowControlEnabled || ( (MASTER_FRAME_HEADER_SIZE + 1) != frameLength ) )
+    {
+        return false;
+    }
+    
+    if ( (0 != frame[0]) || (EMessageId_TxCreditInd != frame[2]) || (1 != frame[6]) )
+    {
+        return false;
+    }
+    
+    if ( (mUnitAddress != frame[1]) && (MASTER_UNIT_ADDRESS_BROADCAST != frame[1]) )
+    {
+        return false;
+    }
+    
+    // A corrupted grant would inflate credits for good. It is left to the thread path, which counts and drops it.
+    u16 crc = ( frame[4] | ( ( ( (u16) ( frame[5] )) << 8 ) & 0xFF00 ) );
+    if (calculateCrcValue(1, (TByte*) ( &(frame[MASTER_FRAME_HEADER_SIZE]) )) != crc)
+    {
+        return false;
+    }
+    
+    *credits = frame[MASTER_FRAME_HEADER_SIZE];
+    return true;
+}
+
+bool MasterUartGateway_isDeliveryAckFrame(const TByte* frame, u16 frameLength, u8* nextExpectedSequenceNumber, u8* selectiveAckMask)
+{
+    // Called from UART ISR, like credit grants the acknowledgements must not wait behind the gateway lock.
+    if ( (MASTER_FRAME_HEADER_SIZE + 2) != frameLength )
+    {
+        return false;
+    }
+    
+    if ( (0 != frame[0]) || (EMessageId_DeliveryAckInd != frame[2]) || (2 != frame[6]) )
+    {
+        return false;
+    }
+    
+    if ( (mUnitAddress != frame[1]) && (MASTER_UNIT_ADDRESS_BROADCAST != frame[1]) )
+    {
+        return false;
+    }
+    
+    u16 crc = ( frame[4] | ( ( ( (u16) ( frame[5] )) << 8 ) & 0xFF00 ) );
+    if (calculateCrcValue(2, (TByte*) ( &(frame[MASTER_FRAME_HEADER_SIZE]) )) != crc)
+    {
+        return false;
+    }
+    
+    *nextExpectedSequenceNumber = frame[MASTER_FRAME_HEADER_SIZE];
+    *selectiveAckMask = frame[MASTER_FRAME_HEADER_SIZE + 1];
+    return true;
+}
+
+u8 MasterUartGateway_getUnitAddress(void)
+{
+    return mUnitAddress;
+}
+
+bool MasterUartGateway_changeUnitAddress(u8 address)
+{
+    if (MASTER_UNIT_ADDRESS_BROADCAST == address)
+    {
+        Logger_warning("%s: Broadcast address %u cannot be assigned to the unit.", getLoggerPrefix(), address);
+        return false;
+    }
+    
+    if (!FlashStorage_write(EFlashStorageKey_UnitAddress, address))
+    {
+        Logger_error("%s: Storing unit address %u failed.", getLoggerPrefix(), address);
+        return false;
+    }
+    
+    mUnitAddress = address;
+    
+    Logger_info("%s: Unit address changed to %u.", getLoggerPrefix(), address);
+    
+    return true;
+}
+
+void messageTransmittedCallback(TMessage* message)
+{
+    if ( mIsFramingModeChangePending && (EMessageId_SetFramingModeResponse == message->id) )
+    {
+        mIsFramingModeChangePending = false;
+        
+        if (EFramingMode_Cobs == mPendingFramingMode)
+        {
+            MasterUartGateway_releaseFrame(mRxDecoder.buffer);
+            startDecodingNewRxFrame();
+        }
+        
+        mFramingMode = mPendingFramingMode;
+        MasterDataReceiver_restartReceiving();
+        
+        if (EFramingMode_Cobs != mFramingMode)
+        {
+            mIsFlowControlEnabled = false;
+        }
+        
+        Logger_info("%s: Framing mode changed to %s.", getLoggerPrefix(), CStringConverter_EFramingMode(mFramingMode));
+    }
+    
+    if ( mIsBaudRateChangePending && (EMessageId_SetBaudRateResponse == message->id) )
+    {
+        mIsBaudRateChangePending = false;
+        applyPendingBaudRate();
+    }
+    
+    if (EMessageId_TimeSyncResponse == message->id)
+    {
+        TimeSynchronizer_handleResponseTransmitted(message->timestamp);
+    }
+    
+    if (EMessageId_BulkChunkInd == message->id)
+    {
+        BulkTransfer_handleChunkTransmitted();
+    }
+}
+
+void applyPendingBaudRate(void)
+{
+    mPreviousBaudRate = UART1_getBaudRate();
+    
+    if (!UART1_changeBaudRate(mPendingBaudRate))
+    {
+        Logger_error("%s: Changing baud rate to %u failed.", getLoggerPrefix(), mPendingBaudRate);
+        MasterDataReceiver_restartReceiving();
+        return;
+    }
+    
+    mIsBaudRateVerificationPending = true;
+    MasterDataReceiver_restartReceiving();
+    
+    osStatus osResult = osTimerStart(mBaudRateVerificationTimerId, BAUD_RATE_VERIFICATION_TIMEOUT_MS);
+    if (osOK != osResult)
+    {
+        Logger_error("%s: Starting baud rate verification timer failed: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
+    }
+    
+    Logger_info("%s: Baud rate changed to %u. Waiting for Master to verify the link.", getLoggerPrefix(), mPendingBaudRate);
+}
+
+void baudRateVerificationTimeoutCallback(const void* arg)
+{
+    // UART is never reinitialized from the timer thread, the fallback is applied by the transmitter thread between frames.
+    if (mIsBaudRateVerificationPending)
+    {
+        MasterDataTransmitter_requestFrameBoundary();
+    }
+}
+
+void frameBoundaryCallback(void)
+{
+    // Called from the transmitter thread with its lock held, the gateway lock is always taken before it, so it is not taken here.
+    if (mIsBaudRateVerificationPending)
+    {
+        mIsBaudRateVerificationPending = false;
+        
+        Logger_warning("%s: Link at %u baud was not verified. Falling back to %u baud.", getLoggerPrefix(), UART1_getBaudRate(), mPreviousBaudRate);
+        
+        if (!UART1_changeBaudRate(mPreviousBaudRate))
+        {
+            Logger_error("%s: Falling back to %u baud failed.", getLoggerPrefix(), mPreviousBaudRate);
+        }
+        
+        MasterDataReceiver_restartReceiving();
+    }
+}
+
+void reportRxCredits(void)
+{
+    TRxCreditInd* indication = MasterDataMemoryManager_allocate(EMessageId_RxCreditInd);
+    if (NULL == indication)
+    {
+        osTimerStart(mRxCreditReportTimerId, RX_CREDIT_REPORT_RETRY_MS);
+        return;
+    }
+    
+    // The running total is reported, so a report dropped from the TX lane is covered by the next one.
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    indication->returnedCreditsTotal = mRxCreditsReturnedTotal;
+    mUnreportedRxCredits = 0;
+    __set_PRIMASK(primask);
+    
+    sendMessage(EMessageId_RxCreditInd, indication, 0);
+}
+
+void rxCreditReportTimerCallback(const void* arg)
+{
+    if ( mIsFlowControlEnabled && (0 != mUnreportedRxCredits) )
+    {
+        reportRxCredits();
+    }
+}
+
+void startDecodingNewRxFrame(void)
+{
+    for (u8 iter = 0; RX_FRAME_BUFFERS_COUNT > iter; ++iter)
+    {
+        u8 index = (mActiveRxFrameBuffer + iter + 1) % RX_FRAME_BUFFERS_COUNT;
+        
+        if (!mIsRxFrameBufferUsed[index])
+        {
+            mIsRxFrameBufferUsed[index] = true;
+            mActiveRxFrameBuffer = index;
+            Cobs_initializeDecoder(&mRxDecoder, mRxFrameBuffers[index], MASTER_FRAME_MAX_DECODED_SIZE);
+            return;
+        }
+    }
+    
+    mRxDecoder.buffer = NULL;
+}
+
+#ifdef USE_FULL_ASSERT
+void checkEmergencyStopWithoutRxBuffers(void)
+{
+    // Runs before reception is started and before link statistics are set up, so nothing it touches is observed.
+    TByte frame [MASTER_EMERGENCY_STOP_FRAME_SIZE] = { 0xE5, MASTER_UNIT_ADDRESS_BROADCAST, 0x70, 0x5A };
+    TByte encodedFrame [COBS_MAX_ENCODED_LENGTH(MASTER_EMERGENCY_STOP_FRAME_SIZE) + 1];
+    u16 encodedLength = Cobs_encode(frame, MASTER_EMERGENCY_STOP_FRAME_SIZE, encodedFrame);
+    encodedFrame[encodedLength++] = COBS_DELIMITER;
+    
+    for (u8 iter = 0; RX_FRAME_BUFFERS_COUNT > iter; ++iter)
+    {
+        mIsRxFrameBufferUsed[iter] = true;
+    }
+    
+    startDecodingNewRxFrame();
+    
+    bool isEmergencyStop = false;
+    for (u16 iter = 0; encodedLength > iter; ++iter)
+    {
+        u16 frameLength;
+        isEmergencyStop = MasterUartGateway_isEmergencyStopByte(encodedFrame[iter]);
+        TByte* decodedFrame = MasterUartGateway_decodeReceivedByte(encodedFrame[iter], &frameLength);
+        assert_param(NULL == decodedFrame);
+    }
+    
+    assert_param(isEmergencyStop);
+    
+    for (u8 iter = 0; RX_FRAME_BUFFERS_COUNT > iter; ++iter)
+    {
+        mIsRxFrameBufferUsed[iter] = false;
+    }
+    
+    mRxDecoder.buffer = NULL;
+    mIsRxFrameSkipped = false;
+}
+#endif
+
+u16 calculateCrcValue(u16 dataLength, TByte* data)
 {
     return 0;
 }
@@ -88,3 +866,9 @@ const char* getLoggerPrefix(void)
     static const char* loggerPrefix = "MasterUartGateway";
     return loggerPrefix;
 }
+
+#undef RX_FRAME_BUFFERS_COUNT
+#undef RX_CREDIT_RESERVED_FRAMES
+#undef RX_CREDIT_REPORT_THRESHOLD
+#undef RX_CREDIT_REPORT_RETRY_MS
+#undef BAUD_RATE_VERIFICATION_TIMEOUT_MS
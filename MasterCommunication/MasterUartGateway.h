@@ -5,11 +5,56 @@
 #include "stdbool.h"
 #include "SharedDefines/EMessageId.h"
 #include "SharedDefines/TMessage.h"
+#include "SharedDefines/TRequestContext.h"
+#include "SharedDefines/EFramingMode.h"
+#include "Utilities/Cobs.h"
+
+#define MASTER_FRAME_HEADER_SIZE 7
+#define MASTER_FRAME_MAX_HEADER_SIZE ( MASTER_FRAME_HEADER_SIZE + 2 )
+#define MASTER_FRAME_MAX_PAYLOAD_SIZE 255
+#define MASTER_FRAME_MAX_DECODED_SIZE ( MASTER_FRAME_MAX_HEADER_SIZE + MASTER_FRAME_MAX_PAYLOAD_SIZE )
+#define MASTER_FRAME_MAX_ENCODED_SIZE ( COBS_MAX_ENCODED_LENGTH(MASTER_FRAME_MAX_DECODED_SIZE) + 1 )
+
+// Extended length frames are produced by the unit only, RX frame buffers keep the 8-bit limit.
+#define MASTER_FRAME_MAX_EXTENDED_PAYLOAD_SIZE 1024
+#define MASTER_FRAME_MAX_EXTENDED_DECODED_SIZE ( MASTER_FRAME_MAX_HEADER_SIZE + MASTER_FRAME_MAX_EXTENDED_PAYLOAD_SIZE )
+#define MASTER_FRAME_MAX_EXTENDED_ENCODED_SIZE ( COBS_MAX_ENCODED_LENGTH(MASTER_FRAME_MAX_EXTENDED_DECODED_SIZE) + 1 )
+
+#define MASTER_FRAME_FLAG_RELIABLE 0x01
+#define MASTER_FRAME_FLAG_EXTENDED_LENGTH 0x02
+
+#define MASTER_UNIT_ADDRESS_DEFAULT 0x01
+#define MASTER_UNIT_ADDRESS_BROADCAST 0xFF
+
+// Reserved frame { 0xE5, address, 0x70, 0x5A }, shorter than any message header.
+#define MASTER_EMERGENCY_STOP_FRAME_SIZE 4
 
 void MasterUartGateway_setup(void);
 void MasterUartGateway_initialize(void);
 
 void MasterUartGateway_sendMessage(EMessageId messageType, void* message);
+void MasterUartGateway_sendResponse(EMessageId messageType, void* message, const TRequestContext* context);
+void MasterUartGateway_indicateBusyRequest(EMessageId requestId, const TRequestContext* context);
 void MasterUartGateway_handleReceivedMessage(TMessage message);
 
+EFramingMode MasterUartGateway_getFramingMode(void);
+bool MasterUartGateway_changeBaudRate(u32 baudRate);
+void MasterUartGateway_prepareContainer(TMessage* container, TByte* payload, u16 length);
+bool MasterUartGateway_changeFramingMode(EFramingMode framingMode);
+bool MasterUartGateway_changeReliableDelivery(bool enabled);
+bool MasterUartGateway_changeFlowControl(bool enabled, u8 initialCredits, u8* rxCredits);
+void MasterUartGateway_returnRxCredit(EMessageId messageId);
+
+u16 MasterUartGateway_encodeFrame(TMessage* message, TByte* frame);
+TByte* MasterUartGateway_decodeReceivedByte(TByte byte, u16* frameLength);
+bool MasterUartGateway_decodeFrame(TByte* frame, u16 frameLength, TMessage* message);
+void MasterUartGateway_releaseFrame(TByte* frame);
+bool MasterUartGateway_isFrameAddressedToUnit(const TByte* frame, u16 frameLength);
+bool MasterUartGateway_isEmergencyStopByte(TByte byte);
+bool MasterUartGateway_isTxCreditFrame(const TByte* frame, u16 frameLength, u8* credits);
+bool MasterUartGateway_isDeliveryAckFrame(const TByte* frame, u16 frameLength, u8* nextExpectedSequenceNumber, u8* selectiveAckMask);
+
+u8 MasterUartGateway_getUnitAddress(void);
+bool MasterUartGateway_changeUnitAddress(u8 address);
+
 #endif
@@ -0,0 +1,30 @@
+#include "MasterCommunication/MeasurementRequestsWorker.h"
+#include "MasterCommunication/MasterDataManager.h"
+
+#include "SharedDefines/TMessage.h"
+
+#include "cmsis_os.h"
+
+THREAD_DEFINES(MeasurementRequestsWorker, MeasurementRequestsWorker)
+EVENT_HANDLER_PROTOTYPE(DataFromMasterReceivedInd)
+
+THREAD(MeasurementRequestsWorker)
+{
+    THREAD_SKELETON_START
+    
+        EVENT_HANDLING(DataFromMasterReceivedInd)
+    
+    THREAD_SKELETON_END
+}
+
+EVENT_HANDLER(DataFromMasterReceivedInd)
+{
+    EVENT_MESSAGE(DataFromMasterReceivedInd)
+    
+    MasterDataManager_executeRequest(&(event->message), &(event->context));
+}
+
+void MeasurementRequestsWorker_setup(void)
+{
+    THREAD_INITIALIZE_MUTEX
+}
@@ -0,0 +1,12 @@
+#ifndef _MEASUREMENT_REQUESTS_WORKER_H_
+
+#define _MEASUREMENT_REQUESTS_WORKER_H_
+
+#include "Defines/CommonDefines.h"
+#include "System/ThreadMacros.h"
+
+THREAD_PROTOTYPE(MeasurementRequestsWorker)
+
+void MeasurementRequestsWorker_setup(void);
+
+#endif
@@ -0,0 +1,195 @@
+#include "MasterCommunication/TimeSynchronizer.h"
+
+#include "Utilities/Logger/Logger.h"
+
+#include "cmsis_os.h"
+
+// NTP-like exchange. Request k carries master transmit time t1(k) and master receive time t4(k-1)
+// of the previous response; the device stamps t2(k) on frame reception and t3(k) on transmission
+// done (both in UART ISRs). When request k+1 comes, exchange k is complete and fed to the estimator.
+// All timestamps are wrapping 32-bit microsecond counters; offset is master time minus device time.
+
+#define TIME_SYNC_OFFSET_GAIN 0.5
+#define TIME_SYNC_SKEW_GAIN 0.25
+#define TIME_SYNC_DELAY_MARGIN_US 1000
+#define TIME_SYNC_MAX_REJECTED_EXCHANGES 4
+
+typedef struct _SExchange
+{
+    u32 masterTransmitTimestamp;
+    u32 deviceReceiveTimestamp;
+    u32 deviceTransmitTimestamp;
+    bool isReceived;
+    bool isTransmitted;
+} SExchange;
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+
+static SExchange mPendingExchange;
+static double mOffset = 0.0;
+static double mSkew = 0.0;
+static u32 mReferenceDeviceTimestamp = 0;
+static u32 mMinRoundTripDelay = 0xFFFFFFFF;
+static u8 mRejectedExchangesCount = 0;
+static u8 mAcceptedExchangesCount = 0;
+static bool mIsMasterTimeReportingEnabled = false;
+
+static void processExchange(SExchange* exchange, u32 masterReceiveTimestamp);
+static bool isSynchronized(void);
+static const char* getLoggerPrefix(void);
+
+void TimeSynchronizer_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+}
+
+u32 TimeSynchronizer_handleExchange(u32 masterTransmitTimestamp, u32 previousMasterReceiveTimestamp, u32 deviceReceiveTimestamp)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    u32 previousDeviceTransmitTimestamp = 0;
+    
+    if (mPendingExchange.isReceived && mPendingExchange.isTransmitted)
+    {
+        previousDeviceTransmitTimestamp = mPendingExchange.deviceTransmitTimestamp;
+        
+        if (0 != previousMasterReceiveTimestamp)
+        {
+            processExchange(&mPendingExchange, previousMasterReceiveTimestamp);
+        }
+    }
+    
+    mPendingExchange.masterTransmitTimestamp = masterTransmitTimestamp;
+    mPendingExchange.deviceReceiveTimestamp = deviceReceiveTimestamp;
+    mPendingExchange.deviceTransmitTimestamp = 0;
+    mPendingExchange.isReceived = true;
+    mPendingExchange.isTransmitted = false;
+    
+    osMutexRelease(mMutexId);
+    
+    return previousDeviceTransmitTimestamp;
+}
+
+void TimeSynchronizer_handleResponseTransmitted(u32 deviceTransmitTimestamp)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    // Only the first transmission of the response belongs to the exchange.
+    if (mPendingExchange.isReceived && !mPendingExchange.isTransmitted)
+    {
+        mPendingExchange.deviceTransmitTimestamp = deviceTransmitTimestamp;
+        mPendingExchange.isTransmitted = true;
+    }
+    
+    osMutexRelease(mMutexId);
+}
+
+bool TimeSynchronizer_getEstimate(i32* offset, float* skewPpm)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    *offset = (i32) ( mOffset );
+    *skewPpm = (float) ( mSkew * 1E6 );
+    bool result = isSynchronized();
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void TimeSynchronizer_setMasterTimeReporting(bool enabled)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    mIsMasterTimeReportingEnabled = enabled;
+    osMutexRelease(mMutexId);
+}
+
+u32 TimeSynchronizer_convertTimestamp(u32 deviceTimestamp)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    u32 timestamp = deviceTimestamp;
+    
+    if (mIsMasterTimeReportingEnabled && isSynchronized())
+    {
+        const double elapsed = (double) ( (i32) ( deviceTimestamp - mReferenceDeviceTimestamp ) );
+        timestamp = deviceTimestamp + (u32) ( (i32) ( mOffset + mSkew * elapsed ) );
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return timestamp;
+}
+
+void processExchange(SExchange* exchange, u32 masterReceiveTimestamp)
+{
+    const i32 forwardDifference = (i32) ( exchange->deviceReceiveTimestamp - exchange->masterTransmitTimestamp );
+    const i32 backwardDifference = (i32) ( exchange->deviceTransmitTimestamp - masterReceiveTimestamp );
+    const u32 roundTripDelay = ( masterReceiveTimestamp - exchange->masterTransmitTimestamp ) - ( exchange->deviceTransmitTimestamp - exchange->deviceReceiveTimestamp );
+    
+    if (mMinRoundTripDelay > roundTripDelay)
+    {
+        mMinRoundTripDelay = roundTripDelay;
+    }
+    
+    // Exchanges delayed by queueing are asymmetric and would bias the offset.
+    if ( (2 * mMinRoundTripDelay + TIME_SYNC_DELAY_MARGIN_US) < roundTripDelay )
+    {
+        if (TIME_SYNC_MAX_REJECTED_EXCHANGES == ++mRejectedExchangesCount)
+        {
+            mRejectedExchangesCount = 0;
+            mMinRoundTripDelay = roundTripDelay;
+        }
+        
+        Logger_debug("%s: Exchange rejected (Round trip delay: %u us).", getLoggerPrefix(), roundTripDelay);
+        return;
+    }
+    
+    mRejectedExchangesCount = 0;
+    
+    // Offset measured at device time of request reception.
+    const double measuredOffset = -( (double) ( forwardDifference ) + (double) ( backwardDifference ) ) / 2.0;
+    
+    if (0 == mAcceptedExchangesCount)
+    {
+        mOffset = measuredOffset;
+        mSkew = 0.0;
+    }
+    else
+    {
+        const double elapsed = (double) ( (i32) ( exchange->deviceReceiveTimestamp - mReferenceDeviceTimestamp ) );
+        const double predictedOffset = mOffset + mSkew * elapsed;
+        const double residual = measuredOffset - predictedOffset;
+        
+        mOffset = predictedOffset + TIME_SYNC_OFFSET_GAIN * residual;
+        if (0.0 < elapsed)
+        {
+            mSkew += TIME_SYNC_SKEW_GAIN * residual / elapsed;
+        }
+    }
+    
+    mReferenceDeviceTimestamp = exchange->deviceReceiveTimestamp;
+    
+    if (0xFF != mAcceptedExchangesCount)
+    {
+        ++mAcceptedExchangesCount;
+    }
+    
+    Logger_debug("%s: Offset: %.1f us. Skew: %.3f ppm. Round trip delay: %u us.", getLoggerPrefix(), mOffset, mSkew * 1E6, roundTripDelay);
+}
+
+bool isSynchronized(void)
+{
+    return ( 2 <= mAcceptedExchangesCount );
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "TimeSynchronizer";
+}
+
+#undef TIME_SYNC_OFFSET_GAIN
+#undef TIME_SYNC_SKEW_GAIN
+#undef TIME_SYNC_DELAY_MARGIN_US
+#undef TIME_SYNC_MAX_REJECTED_EXCHANGES
@@ -0,0 +1,17 @@
+#ifndef _TIME_SYNCHRONIZER_H_
+
+#define _TIME_SYNCHRONIZER_H_
+
+#include "Defines/CommonDefines.h"
+#include "stdbool.h"
+
+void TimeSynchronizer_setup(void);
+
+u32 TimeSynchronizer_handleExchange(u32 masterTransmitTimestamp, u32 previousMasterReceiveTimestamp, u32 deviceReceiveTimestamp);
+void TimeSynchronizer_handleResponseTransmitted(u32 deviceTransmitTimestamp);
+
+bool TimeSynchronizer_getEstimate(i32* offset, float* skewPpm);
+void TimeSynchronizer_setMasterTimeReporting(bool enabled);
+u32 TimeSynchronizer_convertTimestamp(u32 deviceTimestamp);
+
+#endif
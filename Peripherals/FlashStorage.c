@@ -0,0 +1,267 @@
+#include "Peripherals/FlashStorage.h"
+
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_flash.h"
+#include "stm32f4xx_hal_flash_ex.h"
+
+#include "cmsis_os.h"
+
+#include "FaultManagement/FaultIndication.h"
+#include "Utilities/Logger/Logger.h"
+#include "Utilities/Printer/CStringConverter.h"
+
+// Settings are appended as records to the last flash sector (sector 7, 128 KB) and the latest record
+// of a key wins. The sector is erased (and live records rewritten) only when it is full, because
+// erasing stalls code execution from flash for up to a few seconds. The erase never runs in the
+// writer's context: a value that does not fit is kept in RAM and the idle priority compactor thread
+// persists it, so requests are not blocked behind the erase.
+
+#define FLASH_STORAGE_COMPACT_SIGNAL 0x01
+
+#define FLASH_STORAGE_SECTOR FLASH_SECTOR_7
+#define FLASH_STORAGE_START_ADDRESS 0x08060000U
+#define FLASH_STORAGE_SIZE 0x20000U
+#define FLASH_STORAGE_RECORD_MARKER 0x5AA5U
+#define FLASH_STORAGE_ERASED_WORD 0xFFFFFFFFU
+
+typedef struct _SFlashStorageRecord
+{
+    u16 marker;
+    u8 key;
+    u8 checksum;
+    u32 value;
+} SFlashStorageRecord;
+
+#define FLASH_STORAGE_RECORDS_COUNT ( FLASH_STORAGE_SIZE / sizeof(SFlashStorageRecord) )
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+static osThreadId mCompactorThreadId = NULL;
+
+static u32 mPendingValues [EFlashStorageKey_Count];
+static bool mIsValuePending [EFlashStorageKey_Count];
+
+static void flashStorageCompactor(void const* arg);
+static bool getLatestValue(EFlashStorageKey key, u32* value);
+static const SFlashStorageRecord* getRecords(void);
+static u8 calculateChecksum(u8 key, u32 value);
+static bool isRecordValid(const SFlashStorageRecord* record);
+static bool findLatestValue(EFlashStorageKey key, u32* value);
+static i32 findFirstFreeRecord(void);
+static bool programRecord(u32 index, EFlashStorageKey key, u32 value);
+static bool compact(void);
+static const char* getLoggerPrefix(void);
+
+void FlashStorage_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+    osThreadDef(flashStorageCompactorThread, flashStorageCompactor, osPriorityIdle, 0, configMINIMAL_STACK_SIZE);
+    mCompactorThreadId = osThreadCreate(osThread(flashStorageCompactorThread), NULL);
+}
+
+bool FlashStorage_read(EFlashStorageKey key, u32* value)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    bool result = getLatestValue(key, value);
+    osMutexRelease(mMutexId);
+    return result;
+}
+
+bool FlashStorage_write(EFlashStorageKey key, u32 value)
+{
+    osMutexWait(mMutexId, osWaitForever);
+    
+    bool result = true;
+    u32 storedValue;
+    
+    if ( !getLatestValue(key, &storedValue) || (storedValue != value) )
+    {
+        i32 freeRecordIndex = findFirstFreeRecord();
+        
+        if (0 > freeRecordIndex)
+        {
+            Logger_warning("%s: Storage is full. Value of key %u is stored after compaction.", getLoggerPrefix(), key);
+            mPendingValues[key] = value;
+            mIsValuePending[key] = true;
+            osSignalSet(mCompactorThreadId, FLASH_STORAGE_COMPACT_SIGNAL);
+        }
+        else
+        {
+            result = programRecord(freeRecordIndex, key, value);
+        }
+        
+        if (!result)
+        {
+            Logger_error("%s: Storing value of key %u failed!", getLoggerPrefix(), key);
+            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    return result;
+}
+
+void flashStorageCompactor(void const* arg)
+{
+    while (true)
+    {
+        osSignalWait(FLASH_STORAGE_COMPACT_SIGNAL, osWaitForever);
+        
+        osMutexWait(mMutexId, osWaitForever);
+        
+        Logger_info("%s: Compacting...", getLoggerPrefix());
+        
+        if (!compact())
+        {
+            Logger_error("%s: Compacting failed, pending values are lost!", getLoggerPrefix());
+            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+        }
+        
+        for (u8 key = 0; EFlashStorageKey_Count > key; ++key)
+        {
+            mIsValuePending[key] = false;
+        }
+        
+        osMutexRelease(mMutexId);
+    }
+}
+
+bool getLatestValue(EFlashStorageKey key, u32* value)
+{
+    if (mIsValuePending[key])
+    {
+        *value = mPendingValues[key];
+        return true;
+    }
+    
+    return findLatestValue(key, value);
+}
+
+const SFlashStorageRecord* getRecords(void)
+{
+    return (const SFlashStorageRecord*) ( FLASH_STORAGE_START_ADDRESS );
+}
+
+u8 calculateChecksum(u8 key, u32 value)
+{
+    return (u8) ( ~( key ^ (value & 0xFF) ^ ((value >> 8) & 0xFF) ^ ((value >> 16) & 0xFF) ^ ((value >> 24) & 0xFF) ) );
+}
+
+bool isRecordValid(const SFlashStorageRecord* record)
+{
+    return ( (FLASH_STORAGE_RECORD_MARKER == record->marker) && (calculateChecksum(record->key, record->value) == record->checksum) );
+}
+
+bool findLatestValue(EFlashStorageKey key, u32* value)
+{
+    const SFlashStorageRecord* records = getRecords();
+    bool result = false;
+    
+    for (u32 iter = 0; FLASH_STORAGE_RECORDS_COUNT > iter; ++iter)
+    {
+        if (FLASH_STORAGE_ERASED_WORD == *((const u32*) &(records[iter])))
+        {
+            break;
+        }
+        
+        if ( isRecordValid(&(records[iter])) && (key == records[iter].key) )
+        {
+            *value = records[iter].value;
+            result = true;
+        }
+    }
+    
+    return result;
+}
+
+i32 findFirstFreeRecord(void)
+{
+    const SFlashStorageRecord* records = getRecords();
+    
+    for (u32 iter = 0; FLASH_STORAGE_RECORDS_COUNT > iter; ++iter)
+    {
+        if ( (FLASH_STORAGE_ERASED_WORD == *((const u32*) &(records[iter]))) && (FLASH_STORAGE_ERASED_WORD == records[iter].value) )
+        {
+            return (i32) ( iter );
+        }
+    }
+    
+    return -1;
+}
+
+bool programRecord(u32 index, EFlashStorageKey key, u32 value)
+{
+    const u32 address = FLASH_STORAGE_START_ADDRESS + index * sizeof(SFlashStorageRecord);
+    const u32 header = FLASH_STORAGE_RECORD_MARKER | ( ((u32) key) << 16 ) | ( ((u32) calculateChecksum(key, value)) << 24 );
+    
+    HAL_FLASH_Unlock();
+    
+    HAL_StatusTypeDef result = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address + 4, value);
+    if (HAL_OK == result)
+    {
+        // Header is written last, so a record interrupted by reset is never taken as valid.
+        result = HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, address, header);
+    }
+    
+    HAL_FLASH_Lock();
+    
+    if (HAL_OK != result)
+    {
+        Logger_error("%s: Programming record %u failed (Reason: %s)!", getLoggerPrefix(), index, CStringConverter_HAL_StatusTypeDef(result));
+    }
+    
+    return ( HAL_OK == result );
+}
+
+bool compact(void)
+{
+    u32 values [EFlashStorageKey_Count];
+    bool isValueStored [EFlashStorageKey_Count];
+    
+    for (u8 key = 0; EFlashStorageKey_Count > key; ++key)
+    {
+        isValueStored[key] = getLatestValue((EFlashStorageKey) key, &(values[key]));
+    }
+    
+    FLASH_EraseInitTypeDef eraseInit;
+    eraseInit.TypeErase = FLASH_TYPEERASE_SECTORS;
+    eraseInit.Sector = FLASH_STORAGE_SECTOR;
+    eraseInit.NbSectors = 1;
+    eraseInit.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    u32 sectorError = 0;
+    
+    HAL_FLASH_Unlock();
+    HAL_StatusTypeDef result = HAL_FLASHEx_Erase(&eraseInit, &sectorError);
+    HAL_FLASH_Lock();
+    
+    if (HAL_OK != result)
+    {
+        Logger_error("%s: Erasing sector failed (Reason: %s)!", getLoggerPrefix(), CStringConverter_HAL_StatusTypeDef(result));
+        return false;
+    }
+    
+    u32 index = 0;
+    for (u8 key = 0; EFlashStorageKey_Count > key; ++key)
+    {
+        if (isValueStored[key] && !programRecord(index++, (EFlashStorageKey) key, values[key]))
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "FlashStorage";
+}
+
+#undef FLASH_STORAGE_COMPACT_SIGNAL
+#undef FLASH_STORAGE_SECTOR
+#undef FLASH_STORAGE_START_ADDRESS
+#undef FLASH_STORAGE_SIZE
+#undef FLASH_STORAGE_RECORD_MARKER
+#undef FLASH_STORAGE_ERASED_WORD
+#undef FLASH_STORAGE_RECORDS_COUNT
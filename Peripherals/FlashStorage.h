@@ -0,0 +1,14 @@
+#ifndef _FLASH_STORAGE_H_
+
+#define _FLASH_STORAGE_H_
+
+#include "Defines/CommonDefines.h"
+#include "Peripherals/TypesFlashStorage.h"
+#include "stdbool.h"
+
+void FlashStorage_setup(void);
+
+bool FlashStorage_read(EFlashStorageKey key, u32* value);
+bool FlashStorage_write(EFlashStorageKey key, u32 value);
+
+#endif
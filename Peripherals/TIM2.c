@@ -0,0 +1,157 @@
+#include "Peripherals/TIM2.h"
+
+#include "stm32f4xx_hal.h"
+#include "stm32f4xx_hal_msp.h"
+#include "stm32f4xx_hal_tim.h"
+#include "cmsis_os.h"
+
+#include "FaultManagement/FaultIndication.h"
+#include "Utilities/Logger/Logger.h"
+#include "Utilities/Printer/CStringConverter.h"
+
+// TIM2 is a 32-bit free running counter used as monotonic microsecond time base for timestamping
+// samples at acquisition (wraps after ~71 minutes). The prescaler is computed from the actual APB1 timer
+// clock; when that clock is not a whole number of MHz the counter ticks every few microseconds and is scaled.
+
+#define TIM2_MAX_MICROSECONDS_PER_TICK 8
+#define TIM2_MAX_PRESCALER 0xFFFF
+#define TIM2_CHECK_PERIOD_MS 20
+#define TIM2_CHECK_TOLERANCE_US 2000
+
+static bool mIsInitialized = false;
+static TIM_HandleTypeDef mTim2Handle;
+static u32 mMicrosecondsPerTick = 1;
+
+static u32 getTimerClockFrequency(void);
+static bool calculatePrescaler(u32 timerClockFrequency, u32* prescaler, u32* microsecondsPerTick);
+static bool isMicrosecondTickVerified(void);
+static void baseMspInit(TIM_HandleTypeDef* timHandle);
+static const char* getLoggerPrefix(void);
+
+void TIM2_setup(void)
+{
+}
+
+bool TIM2_initialize(void)
+{
+    if (mIsInitialized)
+    {
+        Logger_warning("%s: Timer is running. New initialization attempt skipped.", getLoggerPrefix());
+        return true;
+    }
+    
+    MSP_setHAL_TIM_Base_MspInitCallback(baseMspInit);
+    
+    u32 timerClockFrequency = getTimerClockFrequency();
+    u32 prescaler;
+    
+    if (!calculatePrescaler(timerClockFrequency, &prescaler, &mMicrosecondsPerTick))
+    {
+        Logger_error("%s: Timer clock %u Hz cannot give a whole number of microseconds per tick!", getLoggerPrefix(), timerClockFrequency);
+        FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+        return false;
+    }
+    
+    Logger_info("%s: Timer clock %u Hz, prescaler %u, %u us per tick.", getLoggerPrefix(), timerClockFrequency, prescaler + 1, mMicrosecondsPerTick);
+    
+    mTim2Handle.Instance = TIM2;
+    mTim2Handle.Init.Period = 0xFFFFFFFF;
+    mTim2Handle.Init.Prescaler = prescaler;
+    mTim2Handle.Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+    mTim2Handle.Init.CounterMode = TIM_COUNTERMODE_UP;
+    
+    HAL_StatusTypeDef result = HAL_TIM_Base_Init(&mTim2Handle);
+    if (HAL_OK != result)
+    {
+        Logger_error("%s: Initialization failed (Reason: %s)!", getLoggerPrefix(), CStringConverter_HAL_StatusTypeDef(result));
+        FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+        return false;
+    }
+    
+    result = HAL_TIM_Base_Start(&mTim2Handle);
+    if (HAL_OK != result)
+    {
+        Logger_error("%s: Starting timer failed (Reason: %s)!", getLoggerPrefix(), CStringConverter_HAL_StatusTypeDef(result));
+        FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+        return false;
+    }
+    
+    mIsInitialized = true;
+    
+    if (!isMicrosecondTickVerified())
+    {
+        Logger_error("%s: Timer does not count in microseconds!", getLoggerPrefix());
+        FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+        mIsInitialized = false;
+        return false;
+    }
+    
+    Logger_info("%s: Initialized!", getLoggerPrefix());
+    return true;
+}
+
+u32 TIM2_getMicroseconds(void)
+{
+    return ( mIsInitialized ? ( TIM2->CNT * mMicrosecondsPerTick ) : 0 );
+}
+
+bool TIM2_isInitialized(void)
+{
+    return mIsInitialized;
+}
+
+u32 getTimerClockFrequency(void)
+{
+    // Timers on APB1 run at twice the bus clock whenever the APB1 prescaler is not 1.
+    u32 pclk1Frequency = HAL_RCC_GetPCLK1Freq();
+    return ( RCC_HCLK_DIV1 == (RCC->CFGR & RCC_CFGR_PPRE1) ) ? pclk1Frequency : ( 2 * pclk1Frequency );
+}
+
+bool calculatePrescaler(u32 timerClockFrequency, u32* prescaler, u32* microsecondsPerTick)
+{
+    // Smallest whole number of microseconds per tick that the prescaler divides exactly.
+    for (u32 tickLength = 1; TIM2_MAX_MICROSECONDS_PER_TICK >= tickLength; ++tickLength)
+    {
+        u64 clocksPerTick = (u64) timerClockFrequency * tickLength;
+        
+        if ( (0 == clocksPerTick % 1000000) && (0 < clocksPerTick / 1000000) && (TIM2_MAX_PRESCALER >= clocksPerTick / 1000000 - 1) )
+        {
+            *prescaler = (u32) ( clocksPerTick / 1000000 - 1 );
+            *microsecondsPerTick = tickLength;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool isMicrosecondTickVerified(void)
+{
+    // Cross-check against the kernel tick, a wrong timer clock assumption shows up as a time base off by its ratio.
+    u32 startTick = osKernelSysTick();
+    u32 startTime = TIM2_getMicroseconds();
+    
+    osDelay(TIM2_CHECK_PERIOD_MS);
+    
+    u32 elapsedTime = TIM2_getMicroseconds() - startTime;
+    u32 expectedTime = (u32) ( (u64) ( osKernelSysTick() - startTick ) * 1000000 / osKernelSysTickFrequency );
+    u32 difference = ( elapsedTime > expectedTime ) ? ( elapsedTime - expectedTime ) : ( expectedTime - elapsedTime );
+    
+    Logger_debug("%s: %u us counted over %u us of kernel ticks.", getLoggerPrefix(), elapsedTime, expectedTime);
+    return ( TIM2_CHECK_TOLERANCE_US >= difference );
+}
+
+void baseMspInit(TIM_HandleTypeDef* timHandle)
+{
+    __HAL_RCC_TIM2_CLK_ENABLE();
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "TIM2";
+}
+
+#undef TIM2_MAX_MICROSECONDS_PER_TICK
+#undef TIM2_MAX_PRESCALER
+#undef TIM2_CHECK_PERIOD_MS
+#undef TIM2_CHECK_TOLERANCE_US
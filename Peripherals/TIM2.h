@@ -0,0 +1,15 @@
+#ifndef _TIM2_H_
+
+#define _TIM2_H_
+
+#include "Defines/CommonDefines.h"
+#include "stdbool.h"
+
+void TIM2_setup(void);
+bool TIM2_initialize(void);
+
+u32 TIM2_getMicroseconds(void);
+
+bool TIM2_isInitialized(void);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef _TYPES_FLASH_STORAGE_H_
+
+#define _TYPES_FLASH_STORAGE_H_
+
+typedef enum _EFlashStorageKey
+{
+    EFlashStorageKey_UnitAddress    = 0,
+    EFlashStorageKey_Count
+} EFlashStorageKey;
+
+#endif
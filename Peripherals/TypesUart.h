@@ -9,4 +9,16 @@ typedef u32 TUartHwControl;
 typedef u32 TUartMode;
 typedef u32 TUartOverSampling;
 
+typedef struct _SUartStatistics
+{
+    u32 bytesReceived;
+    u32 bytesTransmitted;
+    u32 parityErrors;
+    u32 noiseErrors;
+    u32 framingErrors;
+    u32 overrunErrors;
+    u32 dmaErrors;
+    u32 receiverRestarts;
+} SUartStatistics;
+
 #endif
@@ -9,13 +9,33 @@
 
 #include "Peripherals/UART1.h"
 
+#include "cmsis_os.h"
+
+#define UART1_MIN_BAUD_RATE 1200
+#define UART1_TX_IDLE_TIMEOUT_MS 100
+#define UART1_RX_RING_SIZE 256
+#define UART1_RX_DRAIN_PERIOD_MS 1
+
 static bool mIsInitialized = false;
 UART_HandleTypeDef mUart1Handle;
 static DMA_HandleTypeDef mDMAHandleTx;
 static DMA_HandleTypeDef mDMAHandleRx;
 static void (*mTransmittingDoneCallback)(void) = NULL;
 static void (*mReceivingDoneCallback)(void) = NULL;
+static void (*mByteReceivedCallback)(TByte) = NULL;
+static TByte mRxRing [UART1_RX_RING_SIZE];
+static u16 mRxRingReadIndex = 0;
+static u16 mReceivingLength = 0;
+static osTimerId mRxDrainTimerId = NULL;
+static volatile bool mIsTransmitPending = false;
+static volatile SUartStatistics mStatistics;
 
+static bool isTransmitting(void);
+static bool isReceiving(void);
+static bool startRxRing(void);
+static void processRxRing(void);
+static void rxDrainTimerCallback(const void* arg);
+static void setRxDMAMode(u32 mode);
 static void mspInit(UART_HandleTypeDef *uartHandle);
 static void mspDeInit(UART_HandleTypeDef *uartHandle);
 
@@ -73,13 +93,18 @@ bool UART1_transmit(TByte* data, const u16 dataLength)
 {
     if (mIsInitialized)
     {
+        mIsTransmitPending = true;
+        
         HAL_StatusTypeDef status = HAL_UART_Transmit_DMA(&mUart1Handle, data, dataLength);
         if (HAL_OK != status)
         {
+            mIsTransmitPending = false;
             Logger_error("UART1: Error in transmitting data: %s.", CStringConverter_HAL_StatusTypeDef(status));
             return false;
         }
         
+        mStatistics.bytesTransmitted += dataLength;
+        
         Logger_debugSystem("UART1: Transmitted %u bytes:", dataLength);
         for (u16 iter = 0; dataLength > iter; ++iter)
         {
@@ -96,6 +121,8 @@ bool UART1_receive(TByte* data, const u16 dataLength)
 {
     if (mIsInitialized)
     {
+        mReceivingLength = dataLength;
+        
         HAL_StatusTypeDef status = HAL_UART_Receive_DMA(&mUart1Handle, data, dataLength);
         if (HAL_OK != status)
         {
@@ -109,6 +136,101 @@ bool UART1_receive(TByte* data, const u16 dataLength)
     return false;
 }
 
+bool UART1_startReceivingByteStream(void (*byteReceivedCallback)(TByte))
+{
+    if (mIsInitialized)
+    {
+        mByteReceivedCallback = byteReceivedCallback;
+        setRxDMAMode(DMA_CIRCULAR);
+        
+        if (!startRxRing())
+        {
+            mByteReceivedCallback = NULL;
+            setRxDMAMode(DMA_NORMAL);
+            return false;
+        }
+        
+        if (NULL == mRxDrainTimerId)
+        {
+            osTimerDef(rxDrainTimer, rxDrainTimerCallback);
+            mRxDrainTimerId = osTimerCreate(osTimer(rxDrainTimer), osTimerPeriodic, NULL);
+        }
+        
+        osTimerStart(mRxDrainTimerId, UART1_RX_DRAIN_PERIOD_MS);
+        
+        return true;
+    }
+    
+    return false;
+}
+
+void UART1_abortReceiving(void)
+{
+    bool isByteStreamReceived = ( NULL != mByteReceivedCallback );
+    mByteReceivedCallback = NULL;
+    
+    if (NULL != mRxDrainTimerId)
+    {
+        osTimerStop(mRxDrainTimerId);
+    }
+    
+    if (mIsInitialized)
+    {
+        HAL_UART_AbortReceive(&mUart1Handle);
+        
+        if (isByteStreamReceived)
+        {
+            setRxDMAMode(DMA_NORMAL);
+        }
+    }
+}
+
+bool UART1_isBaudRateSupported(TUartBaudRate baudRate)
+{
+    return ( (UART1_MIN_BAUD_RATE <= baudRate) && ( (HAL_RCC_GetPCLK2Freq() / 16) >= baudRate ) );
+}
+
+bool UART1_changeBaudRate(TUartBaudRate baudRate)
+{
+    if ( !mIsInitialized || !UART1_isBaudRateSupported(baudRate) )
+    {
+        return false;
+    }
+    
+    for (u8 iter = 0; isTransmitting() && (UART1_TX_IDLE_TIMEOUT_MS > iter); ++iter)
+    {
+        osDelay(1);
+    }
+    
+    if (isTransmitting())
+    {
+        Logger_error("UART1: Changing baud rate failed. Transmission is still ongoing.");
+        return false;
+    }
+    
+    UART1_abortReceiving();
+    
+    TUartBaudRate previousBaudRate = mUart1Handle.Init.BaudRate;
+    mUart1Handle.Init.BaudRate = baudRate;
+    
+    if (HAL_OK != HAL_UART_Init(&mUart1Handle))
+    {
+        Logger_error("UART1: Changing baud rate to %u failed!", baudRate);
+        FaultIndication_start(EFaultId_Uart, EUnitId_Nucleo, EUnitId_Empty);
+        mUart1Handle.Init.BaudRate = previousBaudRate;
+        HAL_UART_Init(&mUart1Handle);
+        return false;
+    }
+    
+    Logger_debug("UART1: Baud rate changed to %u.", baudRate);
+    return true;
+}
+
+TUartBaudRate UART1_getBaudRate(void)
+{
+    return mUart1Handle.Init.BaudRate;
+}
+
 void UART1_registerDataTransmittingDoneCallback(void (*transmittingDoneCallback)(void))
 {
     mTransmittingDoneCallback = transmittingDoneCallback;
@@ -134,6 +256,74 @@ bool UART1_isInitialized(void)
     return mIsInitialized;
 }
 
+bool isTransmitting(void)
+{
+    return ( HAL_UART_STATE_BUSY_TX == ( HAL_UART_GetState(&mUart1Handle) & HAL_UART_STATE_BUSY_TX ) );
+}
+
+bool isReceiving(void)
+{
+    return ( HAL_UART_STATE_BUSY_RX == ( HAL_UART_GetState(&mUart1Handle) & HAL_UART_STATE_BUSY_RX ) );
+}
+
+bool startRxRing(void)
+{
+    mRxRingReadIndex = 0;
+    
+    HAL_StatusTypeDef status = HAL_UART_Receive_DMA(&mUart1Handle, mRxRing, UART1_RX_RING_SIZE);
+    if (HAL_OK != status)
+    {
+        Logger_error("UART1: Error in starting byte stream receiving: %s.", CStringConverter_HAL_StatusTypeDef(status));
+        return false;
+    }
+    
+    return true;
+}
+
+void processRxRing(void)
+{
+    // Called from half transfer and transfer complete interrupts, and from the drain timer with interrupts masked. The DMA
+    // write position is taken once, bytes arriving meanwhile are handled by the next call.
+    u16 writeIndex = (u16) ( ( UART1_RX_RING_SIZE - __HAL_DMA_GET_COUNTER(&mDMAHandleRx) ) % UART1_RX_RING_SIZE );
+    
+    while (writeIndex != mRxRingReadIndex)
+    {
+        TByte byte = mRxRing[mRxRingReadIndex];
+        mRxRingReadIndex = (mRxRingReadIndex + 1) % UART1_RX_RING_SIZE;
+        ++(mStatistics.bytesReceived);
+        
+        if (mByteReceivedCallback)
+        {
+            (*mByteReceivedCallback)(byte);
+        }
+    }
+}
+
+void rxDrainTimerCallback(const void* arg)
+{
+    // USART1_IRQHandler is not part of this module, so the IDLE line interrupt cannot be served here. A frame tail
+    // that does not fill half of the ring is picked up by this timer instead, within one period. Byte callbacks
+    // expect interrupt context, so they run with interrupts masked.
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    
+    if (mByteReceivedCallback)
+    {
+        processRxRing();
+    }
+    
+    __set_PRIMASK(primask);
+}
+
+void setRxDMAMode(u32 mode)
+{
+    if (mode != mDMAHandleRx.Init.Mode)
+    {
+        mDMAHandleRx.Init.Mode = mode;
+        HAL_DMA_Init(&mDMAHandleRx);
+    }
+}
+
 void mspInit(UART_HandleTypeDef* uartHandle)
 {
   GPIO_InitTypeDef  GPIO_InitStruct;
@@ -252,6 +442,8 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef* uartHandle)
     __HAL_UART_FLUSH_DRREGISTER(uartHandle);
     if (&mUart1Handle == uartHandle)
     {
+        mIsTransmitPending = false;
+        
         if (mTransmittingDoneCallback)
         {
             (*mTransmittingDoneCallback)();
@@ -259,19 +451,122 @@ void HAL_UART_TxCpltCallback(UART_HandleTypeDef* uartHandle)
     }
 }
 
+void HAL_UART_RxHalfCpltCallback(UART_HandleTypeDef* uartHandle)
+{
+    if ( (&mUart1Handle == uartHandle) && mByteReceivedCallback )
+    {
+        processRxRing();
+    }
+}
+
 void HAL_UART_RxCpltCallback(UART_HandleTypeDef* uartHandle)
 {
     if (&mUart1Handle == uartHandle)
     {
-        if (mReceivingDoneCallback)
+        // Circular DMA keeps running after transfer complete, only the ring is drained here.
+        if (mByteReceivedCallback)
+        {
+            processRxRing();
+        }
+        else if (mReceivingDoneCallback)
         {
+            mStatistics.bytesReceived += mReceivingLength;
             (*mReceivingDoneCallback)();
         }
     }
 }
 
+void UART1_getStatistics(SUartStatistics* statistics)
+{
+    // Counters are updated from UART and DMA interrupts, the snapshot is taken with them masked.
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    *statistics = mStatistics;
+    __set_PRIMASK(primask);
+}
+
+void UART1_resetStatistics(void)
+{
+    u32 primask = __get_PRIMASK();
+    __disable_irq();
+    
+    mStatistics.bytesReceived = 0;
+    mStatistics.bytesTransmitted = 0;
+    mStatistics.parityErrors = 0;
+    mStatistics.noiseErrors = 0;
+    mStatistics.framingErrors = 0;
+    mStatistics.overrunErrors = 0;
+    mStatistics.dmaErrors = 0;
+    mStatistics.receiverRestarts = 0;
+    
+    __set_PRIMASK(primask);
+}
+
 void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
 {
+    if (&mUart1Handle == huart)
+    {
+        u32 errorCode = huart->ErrorCode;
+        
+        if (0 != (errorCode & HAL_UART_ERROR_PE))
+        {
+            ++(mStatistics.parityErrors);
+        }
+        
+        if (0 != (errorCode & HAL_UART_ERROR_NE))
+        {
+            ++(mStatistics.noiseErrors);
+        }
+        
+        if (0 != (errorCode & HAL_UART_ERROR_FE))
+        {
+            ++(mStatistics.framingErrors);
+        }
+        
+        if (0 != (errorCode & HAL_UART_ERROR_ORE))
+        {
+            ++(mStatistics.overrunErrors);
+        }
+        
+        if (0 != (errorCode & HAL_UART_ERROR_DMA))
+        {
+            ++(mStatistics.dmaErrors);
+        }
+        
+        // A TX DMA error ends the transfer without TxCplt. It is aborted and completed here, otherwise the transmitter
+        // would wait for it forever. The frame is lost, reliable messages are retransmitted.
+        if (mIsTransmitPending && !isTransmitting())
+        {
+            mIsTransmitPending = false;
+            HAL_UART_AbortTransmit(&mUart1Handle);
+            
+            if (mTransmittingDoneCallback)
+            {
+                (*mTransmittingDoneCallback)();
+            }
+        }
+        
+        // Byte stream reception is stopped by HAL on RX error. Bytes already in the ring are delivered, the COBS decoder
+        // resynchronizes on the next delimiter, so reception is simply restarted instead of failing the whole link.
+        if (mByteReceivedCallback)
+        {
+            if (!isReceiving())
+            {
+                ++(mStatistics.receiverRestarts);
+                processRxRing();
+                HAL_UART_AbortReceive(&mUart1Handle);
+                startRxRing();
+            }
+            
+            return;
+        }
+    }
+    
     Logger_debugSystem("UART1: Transmission failure. Error callback occured.");
     FaultIndication_start(EFaultId_Uart, EUnitId_Nucleo, EUnitId_Empty);
 }
+
+#undef UART1_MIN_BAUD_RATE
+#undef UART1_TX_IDLE_TIMEOUT_MS
+#undef UART1_RX_RING_SIZE
+#undef UART1_RX_DRAIN_PERIOD_MS
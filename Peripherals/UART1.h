@@ -10,6 +10,12 @@ void UART1_uninitialize(void);
 
 bool UART1_transmit(TByte* data, const u16 dataLength);
 bool UART1_receive(TByte* data, const u16 dataLength);
+bool UART1_startReceivingByteStream(void (*byteReceivedCallback)(TByte));
+void UART1_abortReceiving(void);
+
+bool UART1_isBaudRateSupported(TUartBaudRate baudRate);
+bool UART1_changeBaudRate(TUartBaudRate baudRate);
+TUartBaudRate UART1_getBaudRate(void);
 
 void UART1_registerDataTransmittingDoneCallback(void (*transmittingDoneCallback)(void));
 void UART1_deregisterDataTransmittingDoneCallback(void);
@@ -18,4 +24,7 @@ void UART1_deregisterDataReceivingDoneCallback(void);
 
 bool UART1_isInitialized(void);
 
+void UART1_getStatistics(SUartStatistics* statistics);
+void UART1_resetStatistics(void);
+
 #endif
@@ -2,6 +2,9 @@
 
 #define _ADS1248_TYPES_H_
 
+#define ADS1248_REFERENCE_VOLTAGE 2.048
+#define ADS1248_POSITIVE_FULL_SCALE_CODE 0x7FFFFF
+
 typedef enum _EADS1248Mode
 {
     EADS1248Mode_Off    = 0,
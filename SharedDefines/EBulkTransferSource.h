@@ -0,0 +1,11 @@
+#ifndef _E_BULK_TRANSFER_SOURCE_H_
+
+#define _E_BULK_TRANSFER_SOURCE_H_
+
+typedef enum _EBulkTransferSource
+{
+    EBulkTransferSource_Recording       = 0,
+    EBulkTransferSource_Count           = 1
+} EBulkTransferSource;
+
+#endif
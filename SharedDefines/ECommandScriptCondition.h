@@ -0,0 +1,16 @@
+#ifndef _E_COMMAND_SCRIPT_CONDITION_H_
+
+#define _E_COMMAND_SCRIPT_CONDITION_H_
+
+typedef enum _ECommandScriptCondition
+{
+    ECommandScriptCondition_Delay                       = 0,
+    ECommandScriptCondition_HeaterTemperatureAbove      = 1,
+    ECommandScriptCondition_HeaterTemperatureBelow      = 2,
+    ECommandScriptCondition_ReferenceTemperatureAbove   = 3,
+    ECommandScriptCondition_ReferenceTemperatureBelow   = 4,
+    ECommandScriptCondition_ControllerErrorWithin       = 5,
+    ECommandScriptCondition_Count                       = 6
+} ECommandScriptCondition;
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef _E_COMMAND_SCRIPT_OPCODE_H_
+
+#define _E_COMMAND_SCRIPT_OPCODE_H_
+
+// Instructions are encoded as the opcode byte followed by little-endian operands:
+//      End             -
+//      SetRegister     register (u8), value (f32)
+//      Wait            condition (u8), threshold (f32), timeout in ms (u32)
+//      SetSegment      number (u16), type (u8), start (f32), stop (f32), setting time interval (u32), step (f32)
+//      LoopBegin       iterations (u16), 0 repeats until the script is stopped
+//      LoopEnd         -
+//      EmitMarker      marker (u16)
+
+typedef enum _ECommandScriptOpcode
+{
+    ECommandScriptOpcode_End            = 0,
+    ECommandScriptOpcode_SetRegister    = 1,
+    ECommandScriptOpcode_Wait           = 2,
+    ECommandScriptOpcode_SetSegment     = 3,
+    ECommandScriptOpcode_LoopBegin      = 4,
+    ECommandScriptOpcode_LoopEnd        = 5,
+    ECommandScriptOpcode_EmitMarker     = 6,
+    ECommandScriptOpcode_Count          = 7
+} ECommandScriptOpcode;
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef _E_COMMAND_SCRIPT_REGISTER_H_
+
+#define _E_COMMAND_SCRIPT_REGISTER_H_
+
+typedef enum _ECommandScriptRegister
+{
+    ECommandScriptRegister_HeaterPower                  = 0,
+    ECommandScriptRegister_HeaterSetPoint               = 1,
+    ECommandScriptRegister_HeaterControllerRunning      = 2,
+    ECommandScriptRegister_ReferenceStabilization       = 3,
+    ECommandScriptRegister_ADS1248Gain                  = 4,
+    ECommandScriptRegister_ADS1248SamplingSpeed         = 5,
+    ECommandScriptRegister_ControlSystemType            = 6,
+    ECommandScriptRegister_AlgorithmExecutionPeriod     = 7,
+    ECommandScriptRegister_SegmentsProgramRunning       = 8,
+    ECommandScriptRegister_Count                        = 9
+} ECommandScriptRegister;
+
+#endif
@@ -0,0 +1,14 @@
+#ifndef _E_COMMAND_SCRIPT_STATUS_H_
+
+#define _E_COMMAND_SCRIPT_STATUS_H_
+
+typedef enum _ECommandScriptStatus
+{
+    ECommandScriptStatus_Done                   = 0,
+    ECommandScriptStatus_Stopped                = 1,
+    ECommandScriptStatus_WaitTimeout            = 2,
+    ECommandScriptStatus_InstructionFailed      = 3,
+    ECommandScriptStatus_EmergencyStop          = 4
+} ECommandScriptStatus;
+
+#endif
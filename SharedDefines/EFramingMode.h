@@ -0,0 +1,11 @@
+#ifndef _E_FRAMING_MODE_H_
+
+#define _E_FRAMING_MODE_H_
+
+typedef enum _EFramingMode
+{
+    EFramingMode_Legacy                                     = 0,
+    EFramingMode_Cobs                                       = 1
+} EFramingMode;
+
+#endif
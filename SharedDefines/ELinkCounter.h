@@ -0,0 +1,29 @@
+#ifndef _E_LINK_COUNTER_H_
+
+#define _E_LINK_COUNTER_H_
+
+typedef enum _ELinkCounter
+{
+    ELinkCounter_BytesReceived              = 0,
+    ELinkCounter_BytesTransmitted           = 1,
+    ELinkCounter_FramesReceived             = 2,
+    ELinkCounter_FramesTransmitted          = 3,
+    ELinkCounter_ParityErrors               = 4,
+    ELinkCounter_NoiseErrors                = 5,
+    ELinkCounter_FramingErrors              = 6,
+    ELinkCounter_OverrunErrors              = 7,
+    ELinkCounter_DmaErrors                  = 8,
+    ELinkCounter_ReceiverRestarts           = 9,
+    ELinkCounter_CorruptedFrames            = 10,
+    ELinkCounter_MalformedHeaders           = 11,
+    ELinkCounter_CrcErrors                  = 12,
+    ELinkCounter_UnknownMessageIds          = 13,
+    ELinkCounter_ForeignFrames              = 14,
+    ELinkCounter_TxLaneFullEvents           = 15,
+    ELinkCounter_TxDroppedMessages          = 16,
+    ELinkCounter_TxCreditExhausted          = 17,
+    ELinkCounter_RxFramesOverCredit         = 18,
+    ELinkCounter_Count                      = 19
+} ELinkCounter;
+
+#endif
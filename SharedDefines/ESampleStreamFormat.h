@@ -0,0 +1,12 @@
+#ifndef _E_SAMPLE_STREAM_FORMAT_H_
+
+#define _E_SAMPLE_STREAM_FORMAT_H_
+
+typedef enum _ESampleStreamFormat
+{
+    ESampleStreamFormat_Converted   = 0,
+    ESampleStreamFormat_RawCode     = 1,
+    ESampleStreamFormat_Count       = 2
+} ESampleStreamFormat;
+
+#endif
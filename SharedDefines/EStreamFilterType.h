@@ -0,0 +1,14 @@
+#ifndef _E_STREAM_FILTER_TYPE_H_
+
+#define _E_STREAM_FILTER_TYPE_H_
+
+typedef enum _EStreamFilterType
+{
+    EStreamFilterType_Decimation                            = 0,
+    EStreamFilterType_Boxcar                                = 1,
+    EStreamFilterType_Cic                                   = 2,
+    EStreamFilterType_Min                                   = 3,
+    EStreamFilterType_Max                                   = 4
+} EStreamFilterType;
+
+#endif
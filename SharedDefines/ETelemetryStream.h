@@ -0,0 +1,12 @@
+#ifndef _E_TELEMETRY_STREAM_H_
+
+#define _E_TELEMETRY_STREAM_H_
+
+typedef enum _ETelemetryStream
+{
+    ETelemetryStream_HeaterTemperature  = 0,
+    ETelemetryStream_ControllerData     = 1,
+    ETelemetryStream_Count              = 2
+} ETelemetryStream;
+
+#endif
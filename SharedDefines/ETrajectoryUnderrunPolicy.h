@@ -0,0 +1,11 @@
+#ifndef _E_TRAJECTORY_UNDERRUN_POLICY_H_
+
+#define _E_TRAJECTORY_UNDERRUN_POLICY_H_
+
+typedef enum _ETrajectoryUnderrunPolicy
+{
+    ETrajectoryUnderrunPolicy_HoldLastValue                 = 0,
+    ETrajectoryUnderrunPolicy_GoSafe                        = 1
+} ETrajectoryUnderrunPolicy;
+
+#endif
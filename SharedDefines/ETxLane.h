@@ -0,0 +1,15 @@
+#ifndef _E_TX_LANE_H_
+
+#define _E_TX_LANE_H_
+
+typedef enum _ETxLane
+{
+    ETxLane_Responses               = 0,
+    ETxLane_ControlTelemetry        = 1,
+    ETxLane_BulkSamples             = 2,
+    ETxLane_BulkTransfer            = 3,
+    ETxLane_Logs                    = 4,
+    ETxLane_Count                   = 5
+} ETxLane;
+
+#endif
@@ -0,0 +1,12 @@
+#ifndef _E_TX_LANE_POLICY_H_
+
+#define _E_TX_LANE_POLICY_H_
+
+typedef enum _ETxLanePolicy
+{
+    ETxLanePolicy_Block             = 0,
+    ETxLanePolicy_DropOldest        = 1,
+    ETxLanePolicy_DropNewest        = 2
+} ETxLanePolicy;
+
+#endif
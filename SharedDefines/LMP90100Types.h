@@ -2,6 +2,8 @@
 
 #define _LMP90100_TYPES_H_
 
+#define LMP90100_FULL_SCALE_CODE 16777216
+
 typedef enum _ELMP90100Mode
 {
     ELMP90100Mode_Off               = 0,
@@ -18,8 +18,31 @@
 #include "SharedDefines/ERegisteringDataType.h"
 #include "SharedDefines/SControllerData.h"
 #include "SharedDefines/EControllerDataType.h"
+#include "SharedDefines/EFramingMode.h"
+#include "SharedDefines/EStreamFilterType.h"
+#include "SharedDefines/ELinkCounter.h"
+#include "SharedDefines/ETrajectoryUnderrunPolicy.h"
+#include "SharedDefines/SEmergencyStopReport.h"
+#include "SharedDefines/EBulkTransferSource.h"
+#include "SharedDefines/ECommandScriptStatus.h"
+#include "SharedDefines/ESampleStreamFormat.h"
+#include "SharedDefines/SSampleCarrierConversionDescriptor.h"
 
 #define MAX_LOG_SIZE 220
+#define LOAD_SEGMENTS_PROGRAM_CHUNK_SIZE 12
+#define SNAPSHOT_CONTROLLER_DATA_COUNT 4
+#define SNAPSHOT_SAMPLE_CARRIER_UNITS_COUNT 8
+#define SNAPSHOT_VALID_HEATER_TEMPERATURE_BIT 0
+#define SNAPSHOT_VALID_REFERENCE_TEMPERATURE_BIT 1
+#define SNAPSHOT_VALID_CONTROLLER_DATA_FIRST_BIT 2
+#define SNAPSHOT_VALID_DAC_OUTPUT_VOLTAGE_BIT 6
+#define SNAPSHOT_VALID_SAMPLE_CARRIER_FIRST_BIT 7
+#define SNAPSHOT_VALID_PROGRAM_STATUS_BIT 15
+#define READ_RECORDING_CHUNK_SIZE 25
+#define READ_RECORDING_MAX_CHUNKS_COUNT 4
+#define TRAJECTORY_CHUNK_SIZE 16
+#define BULK_CHUNK_DATA_SIZE 1008
+#define COMMAND_SCRIPT_CHUNK_SIZE 200
 
 typedef struct _TLogInd
 {
@@ -57,16 +80,21 @@ typedef struct _TResetUnitResponse
 typedef struct _TSampleCarrierDataInd
 {
     SSampleCarrierData data;
+    u16 sequenceNumber;
 } TSampleCarrierDataInd;
 
 typedef struct _THeaterTemperatureInd
 {
     float temperature;
+    u32 timestamp;
+    u16 sequenceNumber;
 } THeaterTemperatureInd;
 
 typedef struct _TReferenceTemperatureInd
 {
     float temperature;
+    u32 timestamp;
+    u16 sequenceNumber;
 } TReferenceTemperatureInd;
 
 typedef struct _TControllerDataInd
@@ -74,6 +102,8 @@ typedef struct _TControllerDataInd
     //SControllerData data;
     EControllerDataType type;
     float value;
+    u32 timestamp;
+    u16 sequenceNumber;
 } TControllerDataInd;
 
 typedef struct _TSetHeaterPowerRequest
@@ -328,4 +358,398 @@ typedef struct _TSetHeaterTemperatureInFeedbackModeResponse
     bool success;
 } TSetHeaterTemperatureInFeedbackModeResponse;
 
+typedef struct _TSetFramingModeRequest
+{
+    EFramingMode mode;
+} TSetFramingModeRequest;
+
+typedef struct _TSetFramingModeResponse
+{
+    EFramingMode mode;
+    bool success;
+} TSetFramingModeResponse;
+
+typedef struct _TSetBaudRateRequest
+{
+    u32 baudRate;
+} TSetBaudRateRequest;
+
+typedef struct _TSetBaudRateResponse
+{
+    u32 baudRate;
+    bool success;
+} TSetBaudRateResponse;
+
+typedef struct _TSetStreamFilterRequest
+{
+    ERegisteringDataType dataType;
+    u8 channel;
+    EStreamFilterType filterType;
+    u16 decimationFactor;
+} TSetStreamFilterRequest;
+
+typedef struct _TSetStreamFilterResponse
+{
+    ERegisteringDataType dataType;
+    u8 channel;
+    bool success;
+} TSetStreamFilterResponse;
+
+typedef struct _TSetReliableDeliveryRequest
+{
+    bool enabled;
+} TSetReliableDeliveryRequest;
+
+typedef struct _TSetReliableDeliveryResponse
+{
+    bool enabled;
+    bool success;
+} TSetReliableDeliveryResponse;
+
+typedef struct _TDeliveryAckInd
+{
+    u8 nextExpectedSequenceNumber;
+    u8 selectiveAckMask;
+} TDeliveryAckInd;
+
+typedef struct _TLoadSegmentsProgramRequest
+{
+    u8 chunkIndex;
+    u8 chunksCount;
+    u8 segmentsCount;
+    u16 numbers [LOAD_SEGMENTS_PROGRAM_CHUNK_SIZE];
+    u8 types [LOAD_SEGMENTS_PROGRAM_CHUNK_SIZE];
+    float startTemperatures [LOAD_SEGMENTS_PROGRAM_CHUNK_SIZE];
+    float stopTemperatures [LOAD_SEGMENTS_PROGRAM_CHUNK_SIZE];
+    u32 settingTimeIntervals [LOAD_SEGMENTS_PROGRAM_CHUNK_SIZE];
+    float temperatureSteps [LOAD_SEGMENTS_PROGRAM_CHUNK_SIZE];
+} TLoadSegmentsProgramRequest;
+
+typedef struct _TLoadSegmentsProgramResponse
+{
+    u8 chunkIndex;
+    u16 loadedSegmentsCount;
+    bool isProgramApplied;
+    bool success;
+} TLoadSegmentsProgramResponse;
+
+typedef struct _TSnapshotRequest
+{
+    bool dummy;
+} TSnapshotRequest;
+
+typedef struct _TSnapshotResponse
+{
+    u32 assemblyTimestamp;
+    float heaterTemperature;
+    u32 heaterTemperatureTimestamp;
+    float referenceTemperature;
+    u32 referenceTemperatureTimestamp;
+    float controllerData [SNAPSHOT_CONTROLLER_DATA_COUNT];
+    u32 controllerDataTimestamps [SNAPSHOT_CONTROLLER_DATA_COUNT];
+    float dacOutputVoltage;
+    u32 dacOutputVoltageTimestamp;
+    float sampleCarrierValues [SNAPSHOT_SAMPLE_CARRIER_UNITS_COUNT];
+    u32 sampleCarrierTimestamps [SNAPSHOT_SAMPLE_CARRIER_UNITS_COUNT];
+    bool isProgramRunning;
+    u16 currentSegmentNumber;
+    u16 registeredSegmentsCount;
+    u32 programStatusTimestamp;
+    u16 validValuesMask;
+} TSnapshotResponse;
+
+typedef struct _TStartRecordingRequest
+{
+    u16 capacity;
+} TStartRecordingRequest;
+
+typedef struct _TStartRecordingResponse
+{
+    u16 capacity;
+    bool success;
+} TStartRecordingResponse;
+
+typedef struct _TStopRecordingRequest
+{
+    bool dummy;
+} TStopRecordingRequest;
+
+typedef struct _TStopRecordingResponse
+{
+    u16 recordedSamplesCount;
+    u32 overwrittenSamplesCount;
+    bool success;
+} TStopRecordingResponse;
+
+typedef struct _TReadRecordingRequest
+{
+    u16 firstSampleIndex;
+    u8 chunksCount;
+} TReadRecordingRequest;
+
+typedef struct _TReadRecordingResponse
+{
+    u16 firstSampleIndex;
+    u16 recordedSamplesCount;
+    u8 samplesCount;
+    u8 unitIds [READ_RECORDING_CHUNK_SIZE];
+    float values [READ_RECORDING_CHUNK_SIZE];
+    u32 timestamps [READ_RECORDING_CHUNK_SIZE];
+} TReadRecordingResponse;
+
+typedef struct _TTimeSyncRequest
+{
+    u32 masterTransmitTimestamp;
+    u32 previousMasterReceiveTimestamp;
+    bool isMasterTimeReportingEnabled;
+} TTimeSyncRequest;
+
+typedef struct _TTimeSyncResponse
+{
+    u32 masterTransmitTimestamp;
+    u32 deviceReceiveTimestamp;
+    u32 previousDeviceTransmitTimestamp;
+    i32 offset;
+    float skewPpm;
+    bool isSynchronized;
+} TTimeSyncResponse;
+
+typedef struct _TSetUnitAddressRequest
+{
+    u8 address;
+} TSetUnitAddressRequest;
+
+typedef struct _TSetUnitAddressResponse
+{
+    u8 address;
+    bool success;
+} TSetUnitAddressResponse;
+
+typedef struct _TLinkStatisticsRequest
+{
+    bool reset;
+} TLinkStatisticsRequest;
+
+typedef struct _TLinkStatisticsResponse
+{
+    u32 counters [ELinkCounter_Count];
+    u16 txQueueHighWaterMark;
+    u32 meanTxLatency;
+    u32 maxTxLatency;
+    bool isReset;
+} TLinkStatisticsResponse;
+
+typedef struct _TStartTrajectoryRequest
+{
+    ETrajectoryUnderrunPolicy underrunPolicy;
+    u32 prebufferTime;
+} TStartTrajectoryRequest;
+
+typedef struct _TStartTrajectoryResponse
+{
+    bool success;
+} TStartTrajectoryResponse;
+
+typedef struct _TTrajectoryChunkRequest
+{
+    u32 firstPointIndex;
+    bool isLastChunk;
+    u8 pointsCount;
+    u32 times [TRAJECTORY_CHUNK_SIZE];
+    float temperatures [TRAJECTORY_CHUNK_SIZE];
+} TTrajectoryChunkRequest;
+
+typedef struct _TTrajectoryChunkResponse
+{
+    u32 nextPointIndex;
+    u16 bufferedPointsCount;
+    u16 freePointsCount;
+    bool success;
+} TTrajectoryChunkResponse;
+
+typedef struct _TStopTrajectoryRequest
+{
+    bool dummy;
+} TStopTrajectoryRequest;
+
+typedef struct _TStopTrajectoryResponse
+{
+    u32 underrunsCount;
+    bool success;
+} TStopTrajectoryResponse;
+
+typedef struct _TBeginConfigurationBatchRequest
+{
+    bool dummy;
+} TBeginConfigurationBatchRequest;
+
+typedef struct _TBeginConfigurationBatchResponse
+{
+    bool success;
+} TBeginConfigurationBatchResponse;
+
+typedef struct _TCommitConfigurationBatchRequest
+{
+    bool dummy;
+} TCommitConfigurationBatchRequest;
+
+typedef struct _TCommitConfigurationBatchResponse
+{
+    u8 stagedChangesCount;
+    u8 appliedChangesCount;
+    bool success;
+} TCommitConfigurationBatchResponse;
+
+typedef struct _TAbortConfigurationBatchRequest
+{
+    bool dummy;
+} TAbortConfigurationBatchRequest;
+
+typedef struct _TAbortConfigurationBatchResponse
+{
+    u8 discardedChangesCount;
+    bool success;
+} TAbortConfigurationBatchResponse;
+
+typedef struct _TEmergencyStopInd
+{
+    SEmergencyStopReport report;
+} TEmergencyStopInd;
+
+typedef struct _TClearEmergencyStopRequest
+{
+    bool dummy;
+} TClearEmergencyStopRequest;
+
+typedef struct _TClearEmergencyStopResponse
+{
+    bool success;
+} TClearEmergencyStopResponse;
+
+typedef struct _TSetFlowControlRequest
+{
+    bool enabled;
+    u8 initialCredits;
+} TSetFlowControlRequest;
+
+typedef struct _TSetFlowControlResponse
+{
+    bool enabled;
+    u8 rxCredits;
+    bool success;
+} TSetFlowControlResponse;
+
+typedef struct _TTxCreditInd
+{
+    u8 grantedCredits;
+} TTxCreditInd;
+
+typedef struct _TRxCreditInd
+{
+    u8 returnedCreditsTotal;
+} TRxCreditInd;
+
+typedef struct _TStartBulkTransferRequest
+{
+    EBulkTransferSource source;
+    u32 offset;
+} TStartBulkTransferRequest;
+
+typedef struct _TStartBulkTransferResponse
+{
+    EBulkTransferSource source;
+    u8 transferId;
+    u32 totalSize;
+    bool success;
+} TStartBulkTransferResponse;
+
+typedef struct _TBulkChunkInd
+{
+    u8 transferId;
+    u32 totalSize;
+    u32 offset;
+    u16 length;
+    TByte data [BULK_CHUNK_DATA_SIZE];
+} TBulkChunkInd;
+
+typedef struct _TLoadCommandScriptRequest
+{
+    u8 chunkIndex;
+    u8 chunksCount;
+    u8 length;
+    TByte code [COMMAND_SCRIPT_CHUNK_SIZE];
+} TLoadCommandScriptRequest;
+
+typedef struct _TLoadCommandScriptResponse
+{
+    u8 chunkIndex;
+    u16 loadedLength;
+    bool isScriptApplied;
+    bool success;
+} TLoadCommandScriptResponse;
+
+typedef struct _TStartCommandScriptRequest
+{
+    bool dummy;
+} TStartCommandScriptRequest;
+
+typedef struct _TStartCommandScriptResponse
+{
+    bool success;
+} TStartCommandScriptResponse;
+
+typedef struct _TStopCommandScriptRequest
+{
+    bool dummy;
+} TStopCommandScriptRequest;
+
+typedef struct _TStopCommandScriptResponse
+{
+    bool success;
+} TStopCommandScriptResponse;
+
+typedef struct _TCommandScriptMarkerInd
+{
+    u16 marker;
+    u16 pc;
+    u32 timestamp;
+} TCommandScriptMarkerInd;
+
+typedef struct _TCommandScriptDoneInd
+{
+    ECommandScriptStatus status;
+    u16 pc;
+    u32 executionTime;
+} TCommandScriptDoneInd;
+
+typedef struct _TSetSampleStreamFormatRequest
+{
+    ESampleStreamFormat format;
+} TSetSampleStreamFormatRequest;
+
+typedef struct _TSetSampleStreamFormatResponse
+{
+    ESampleStreamFormat format;
+    bool success;
+} TSetSampleStreamFormatResponse;
+
+typedef struct _TSampleCarrierConversionDescriptorInd
+{
+    SSampleCarrierConversionDescriptor descriptor;
+} TSampleCarrierConversionDescriptorInd;
+
+typedef struct _TSampleCarrierRawDataInd
+{
+    EUnitId unitId;
+    u32 code;
+    u8 configurationId;
+    u32 timestamp;
+    u16 sequenceNumber;
+} TSampleCarrierRawDataInd;
+
+typedef struct _TRequestBusyInd
+{
+    u8 id;
+} TRequestBusyInd;
+
 #endif
@@ -0,0 +1,139 @@
+#ifndef _MESSAGES_REGISTRY_H_
+
+#define _MESSAGES_REGISTRY_H_
+
+// Single list of all Master messages. Every table describing messages (identifiers, names,
+// lengths, memory pools, TX lanes and request handlers) is generated from it.
+//
+// MESSAGE(name, id, poolSize, direction, lane)
+//      Message with T<name> payload structure allocated from its own memory pool.
+// RAW_MESSAGE(name, id, direction, lane)
+//      Message with payload built directly by the link layer (no structure, no memory pool).
+//
+// Directions:
+//      FromMaster  - request dispatched to handle<name>() in MasterDataManager,
+//      ToMaster    - response or indication sent to Master,
+//      Link        - message from Master consumed by MasterUartGateway (never consumes RX credit).
+
+#define MESSAGE_ID_LIMIT 128
+
+#define MESSAGES_REGISTRY(MESSAGE, RAW_MESSAGE) \
+    MESSAGE(LogInd,                                                         1,    30,  ToMaster,    Logs) \
+    MESSAGE(FaultInd,                                                       2,    3,   ToMaster,    Responses) \
+    MESSAGE(PollingRequest,                                                 3,    3,   FromMaster,  Responses) \
+    MESSAGE(PollingResponse,                                                4,    3,   ToMaster,    Responses) \
+    MESSAGE(ResetUnitRequest,                                               5,    1,   FromMaster,  Responses) \
+    MESSAGE(ResetUnitResponse,                                              6,    1,   ToMaster,    Responses) \
+    MESSAGE(SampleCarrierDataInd,                                           7,    5,   ToMaster,    BulkSamples) \
+    MESSAGE(HeaterTemperatureInd,                                           8,    5,   ToMaster,    ControlTelemetry) \
+    MESSAGE(ReferenceTemperatureInd,                                        9,    5,   ToMaster,    ControlTelemetry) \
+    MESSAGE(ControllerDataInd,                                              10,   15,  ToMaster,    ControlTelemetry) \
+    MESSAGE(SetHeaterPowerRequest,                                          11,   2,   FromMaster,  Responses) \
+    MESSAGE(SetHeaterPowerResponse,                                         12,   2,   ToMaster,    Responses) \
+    MESSAGE(CallibreADS1248Request,                                         13,   1,   FromMaster,  Responses) \
+    MESSAGE(CallibreADS1248Response,                                        14,   1,   ToMaster,    Responses) \
+    MESSAGE(SetChannelGainADS1248Request,                                   15,   1,   FromMaster,  Responses) \
+    MESSAGE(SetChannelGainADS1248Response,                                  16,   1,   ToMaster,    Responses) \
+    MESSAGE(SetChannelSamplingSpeedADS1248Request,                          17,   1,   FromMaster,  Responses) \
+    MESSAGE(SetChannelSamplingSpeedADS1248Response,                         18,   1,   ToMaster,    Responses) \
+    MESSAGE(StartRegisteringDataRequest,                                    19,   5,   FromMaster,  Responses) \
+    MESSAGE(StartRegisteringDataResponse,                                   20,   1,   ToMaster,    Responses) \
+    MESSAGE(StopRegisteringDataRequest,                                     21,   1,   FromMaster,  Responses) \
+    MESSAGE(StopRegisteringDataResponse,                                    22,   1,   ToMaster,    Responses) \
+    MESSAGE(SetNewDeviceModeADS1248Request,                                 23,   1,   FromMaster,  Responses) \
+    MESSAGE(SetNewDeviceModeADS1248Response,                                24,   1,   ToMaster,    Responses) \
+    MESSAGE(SetNewDeviceModeLMP90100ControlSystemRequest,                   25,   1,   FromMaster,  Responses) \
+    MESSAGE(SetNewDeviceModeLMP90100ControlSystemResponse,                  26,   1,   ToMaster,    Responses) \
+    MESSAGE(SetNewDeviceModeLMP90100SignalsMeasurementRequest,              27,   1,   FromMaster,  Responses) \
+    MESSAGE(SetNewDeviceModeLMP90100SignalsMeasurementResponse,             28,   1,   ToMaster,    Responses) \
+    MESSAGE(SetControlSystemTypeRequest,                                    29,   1,   FromMaster,  Responses) \
+    MESSAGE(SetControlSystemTypeResponse,                                   30,   1,   ToMaster,    Responses) \
+    MESSAGE(SetControllerTunesRequest,                                      31,   2,   FromMaster,  Responses) \
+    MESSAGE(SetControllerTunesResponse,                                     32,   2,   ToMaster,    Responses) \
+    MESSAGE(SetProcessModelParametersRequest,                               33,   1,   FromMaster,  Responses) \
+    MESSAGE(SetProcessModelParametersResponse,                              34,   1,   ToMaster,    Responses) \
+    MESSAGE(SetControllingAlgorithmExecutionPeriodRequest,                  35,   1,   FromMaster,  Responses) \
+    MESSAGE(SetControllingAlgorithmExecutionPeriodResponse,                 36,   1,   ToMaster,    Responses) \
+    MESSAGE(RegisterNewSegmentToProgramRequest,                             37,   2,   FromMaster,  Responses) \
+    MESSAGE(RegisterNewSegmentToProgramResponse,                            38,   2,   ToMaster,    Responses) \
+    MESSAGE(DeregisterSegmentFromProgramRequest,                            39,   2,   FromMaster,  Responses) \
+    MESSAGE(DeregisterSegmentFromProgramResponse,                           40,   2,   ToMaster,    Responses) \
+    MESSAGE(StartSegmentProgramRequest,                                     41,   1,   FromMaster,  Responses) \
+    MESSAGE(StartSegmentProgramResponse,                                    42,   1,   ToMaster,    Responses) \
+    MESSAGE(StopSegmentProgramRequest,                                      43,   1,   FromMaster,  Responses) \
+    MESSAGE(StopSegmentProgramResponse,                                     44,   1,   ToMaster,    Responses) \
+    MESSAGE(SegmentStartedInd,                                              45,   2,   ToMaster,    Responses) \
+    MESSAGE(SegmentsProgramDoneInd,                                         46,   1,   ToMaster,    Responses) \
+    MESSAGE(StartReferenceTemperatureStabilizationRequest,                  47,   1,   FromMaster,  Responses) \
+    MESSAGE(StartReferenceTemperatureStabilizationResponse,                 48,   1,   ToMaster,    Responses) \
+    MESSAGE(StopReferenceTemperatureStabilizationRequest,                   49,   1,   FromMaster,  Responses) \
+    MESSAGE(StopReferenceTemperatureStabilizationResponse,                  50,   1,   ToMaster,    Responses) \
+    MESSAGE(SetRTDPolynomialCoefficientsRequest,                            51,   2,   FromMaster,  Responses) \
+    MESSAGE(SetRTDPolynomialCoefficientsResponse,                           52,   2,   ToMaster,    Responses) \
+    MESSAGE(UnitReadyInd,                                                   53,   14,  ToMaster,    Responses) \
+    MESSAGE(SetHeaterTemperatureInFeedbackModeRequest,                      54,   2,   FromMaster,  Responses) \
+    MESSAGE(SetHeaterTemperatureInFeedbackModeResponse,                     55,   2,   ToMaster,    Responses) \
+    MESSAGE(SetFramingModeRequest,                                          56,   1,   FromMaster,  Responses) \
+    MESSAGE(SetFramingModeResponse,                                         57,   1,   ToMaster,    Responses) \
+    RAW_MESSAGE(ContainerInd,                                               58,        ToMaster,    BulkSamples) \
+    MESSAGE(SetBaudRateRequest,                                             59,   1,   FromMaster,  Responses) \
+    MESSAGE(SetBaudRateResponse,                                            60,   1,   ToMaster,    Responses) \
+    MESSAGE(SetStreamFilterRequest,                                         61,   1,   FromMaster,  Responses) \
+    MESSAGE(SetStreamFilterResponse,                                        62,   1,   ToMaster,    Responses) \
+    MESSAGE(SetReliableDeliveryRequest,                                     63,   1,   FromMaster,  Responses) \
+    MESSAGE(SetReliableDeliveryResponse,                                    64,   1,   ToMaster,    Responses) \
+    MESSAGE(DeliveryAckInd,                                                 65,   2,   Link,        Responses) \
+    MESSAGE(LoadSegmentsProgramRequest,                                     66,   1,   FromMaster,  Responses) \
+    MESSAGE(LoadSegmentsProgramResponse,                                    67,   1,   ToMaster,    Responses) \
+    MESSAGE(SnapshotRequest,                                                68,   1,   FromMaster,  Responses) \
+    MESSAGE(SnapshotResponse,                                               69,   1,   ToMaster,    Responses) \
+    MESSAGE(StartRecordingRequest,                                          70,   1,   FromMaster,  Responses) \
+    MESSAGE(StartRecordingResponse,                                         71,   1,   ToMaster,    Responses) \
+    MESSAGE(StopRecordingRequest,                                           72,   1,   FromMaster,  Responses) \
+    MESSAGE(StopRecordingResponse,                                          73,   1,   ToMaster,    Responses) \
+    MESSAGE(ReadRecordingRequest,                                           74,   1,   FromMaster,  Responses) \
+    MESSAGE(ReadRecordingResponse,                                          75,   4,   ToMaster,    Responses) \
+    MESSAGE(TimeSyncRequest,                                                76,   1,   FromMaster,  Responses) \
+    MESSAGE(TimeSyncResponse,                                               77,   1,   ToMaster,    Responses) \
+    MESSAGE(SetUnitAddressRequest,                                          78,   1,   FromMaster,  Responses) \
+    MESSAGE(SetUnitAddressResponse,                                         79,   1,   ToMaster,    Responses) \
+    MESSAGE(LinkStatisticsRequest,                                          80,   1,   FromMaster,  Responses) \
+    MESSAGE(LinkStatisticsResponse,                                         81,   1,   ToMaster,    Responses) \
+    MESSAGE(StartTrajectoryRequest,                                         82,   1,   FromMaster,  Responses) \
+    MESSAGE(StartTrajectoryResponse,                                        83,   1,   ToMaster,    Responses) \
+    MESSAGE(TrajectoryChunkRequest,                                         84,   2,   FromMaster,  Responses) \
+    MESSAGE(TrajectoryChunkResponse,                                        85,   2,   ToMaster,    Responses) \
+    MESSAGE(StopTrajectoryRequest,                                          86,   1,   FromMaster,  Responses) \
+    MESSAGE(StopTrajectoryResponse,                                         87,   1,   ToMaster,    Responses) \
+    MESSAGE(BeginConfigurationBatchRequest,                                 88,   1,   FromMaster,  Responses) \
+    MESSAGE(BeginConfigurationBatchResponse,                                89,   1,   ToMaster,    Responses) \
+    MESSAGE(CommitConfigurationBatchRequest,                                90,   1,   FromMaster,  Responses) \
+    MESSAGE(CommitConfigurationBatchResponse,                               91,   1,   ToMaster,    Responses) \
+    MESSAGE(AbortConfigurationBatchRequest,                                 92,   1,   FromMaster,  Responses) \
+    MESSAGE(AbortConfigurationBatchResponse,                                93,   1,   ToMaster,    Responses) \
+    MESSAGE(EmergencyStopInd,                                               94,   2,   ToMaster,    Responses) \
+    MESSAGE(ClearEmergencyStopRequest,                                      95,   1,   FromMaster,  Responses) \
+    MESSAGE(ClearEmergencyStopResponse,                                     96,   1,   ToMaster,    Responses) \
+    MESSAGE(SetFlowControlRequest,                                          97,   1,   FromMaster,  Responses) \
+    MESSAGE(SetFlowControlResponse,                                         98,   1,   ToMaster,    Responses) \
+    MESSAGE(UnexpectedMasterMessageInd,                                     99,   2,   ToMaster,    Responses) \
+    MESSAGE(TxCreditInd,                                                    100,  2,   Link,        Responses) \
+    MESSAGE(RxCreditInd,                                                    101,  2,   ToMaster,    ControlTelemetry) \
+    MESSAGE(StartBulkTransferRequest,                                       102,  1,   FromMaster,  Responses) \
+    MESSAGE(StartBulkTransferResponse,                                      103,  1,   ToMaster,    Responses) \
+    MESSAGE(BulkChunkInd,                                                   104,  2,   ToMaster,    BulkTransfer) \
+    MESSAGE(LoadCommandScriptRequest,                                       105,  1,   FromMaster,  Responses) \
+    MESSAGE(LoadCommandScriptResponse,                                      106,  1,   ToMaster,    Responses) \
+    MESSAGE(StartCommandScriptRequest,                                      107,  1,   FromMaster,  Responses) \
+    MESSAGE(StartCommandScriptResponse,                                     108,  1,   ToMaster,    Responses) \
+    MESSAGE(StopCommandScriptRequest,                                       109,  1,   FromMaster,  Responses) \
+    MESSAGE(StopCommandScriptResponse,                                      110,  1,   ToMaster,    Responses) \
+    MESSAGE(CommandScriptMarkerInd,                                         111,  4,   ToMaster,    ControlTelemetry) \
+    MESSAGE(CommandScriptDoneInd,                                           112,  2,   ToMaster,    Responses) \
+    MESSAGE(SetSampleStreamFormatRequest,                                   113,  1,   FromMaster,  Responses) \
+    MESSAGE(SetSampleStreamFormatResponse,                                  114,  1,   ToMaster,    Responses) \
+    MESSAGE(SampleCarrierConversionDescriptorInd,                           115,  2,   ToMaster,    Responses) \
+    MESSAGE(SampleCarrierRawDataInd,                                        116,  5,   ToMaster,    BulkSamples) \
+    MESSAGE(RequestBusyInd,                                                 117,  2,   ToMaster,    Responses)
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef _S_EMERGENCY_STOP_REPORT_H_
+
+#define _S_EMERGENCY_STOP_REPORT_H_
+
+#include "Defines/CommonDefines.h"
+#include "stdbool.h"
+
+typedef struct _SEmergencyStopReport
+{
+    u32 triggerTimestamp;
+    u32 peltierStopTime;
+    u32 heaterStopTime;
+    u16 heaterOutputValue;
+    bool wasReferenceStabilizationActive;
+    bool wasControllerRunning;
+    bool wasSegmentsProgramRunning;
+    bool wasTrajectoryRunning;
+    bool success;
+} SEmergencyStopReport;
+
+#endif
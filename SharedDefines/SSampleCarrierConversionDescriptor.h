@@ -0,0 +1,32 @@
+#ifndef _S_SAMPLE_CARRIER_CONVERSION_DESCRIPTOR_H_
+
+#define _S_SAMPLE_CARRIER_CONVERSION_DESCRIPTOR_H_
+
+#include "Defines/CommonDefines.h"
+#include "stdbool.h"
+
+#define RTD_TEMPERATURE_COEFFICIENTS_COUNT 4
+
+// Everything Master needs to convert raw sample carrier codes the same way the unit does:
+//      thermocouple [uV]   = sign * ( magnitude * referenceVoltage / gain / positiveFullScaleCode ) * outputScale,
+//                            codes above positiveFullScaleCode are negative, magnitude = ~code & positiveFullScaleCode,
+//                            negative ThermocoupleReference codes read as 0 uV when isThermocoupleReferenceClamped is set
+//      RTD [Ohm]           = 4 * referenceResistance * code / ( fullScaleCode * gain ) + comparatorResistance
+//      RTD [oC]            = ( c0 + sqrt(c1 + c2 * R) ) / c3
+
+typedef struct _SSampleCarrierConversionDescriptor
+{
+    u8 configurationId;
+    float thermocoupleReferenceVoltage;
+    float thermocoupleGain;
+    u32 thermocouplePositiveFullScaleCode;
+    float thermocoupleOutputScale;
+    bool isThermocoupleReferenceClamped;
+    float rtdReferenceResistance;
+    float rtdGain;
+    float rtdComparatorResistance;
+    u32 rtdFullScaleCode;
+    float rtdTemperatureCoefficients [RTD_TEMPERATURE_COEFFICIENTS_COUNT];
+} SSampleCarrierConversionDescriptor;
+
+#endif
@@ -4,6 +4,7 @@
 
 #define THERMOCOUPLES_COUNT 5
 
+#include "Defines/CommonDefines.h"
 #include "SharedDefines/EUnitId.h"
 
 /*
@@ -21,6 +22,7 @@ typedef struct _SSampleCarrierData
 {
     EUnitId unitId;
     float value;
+    u32 timestamp;
 } SSampleCarrierData;
 
 #endif
@@ -3,6 +3,7 @@
 #define _T_MESSAGE_H_
 
 #include "Defines/CommonDefines.h"
+#include "stdbool.h"
 #include "SharedDefines/EMessageId.h"
 
 typedef struct _TMessage
@@ -10,8 +11,12 @@ typedef struct _TMessage
     EMessageId id;
     u8 transactionId;
     u16 crc;
-    u8 length;
+    u16 length;
     TByte* data;
+    bool isReliable;
+    bool isBroadcast;
+    u8 sequenceNumber;
+    u32 timestamp;
 } TMessage;
 
 #endif
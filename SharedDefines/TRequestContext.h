@@ -0,0 +1,15 @@
+#ifndef _T_REQUEST_CONTEXT_H_
+
+#define _T_REQUEST_CONTEXT_H_
+
+#include "Defines/CommonDefines.h"
+#include "stdbool.h"
+
+typedef struct _TRequestContext
+{
+    u8 transactionId;
+    bool isBroadcast;
+    bool isStaged;
+} TRequestContext;
+
+#endif
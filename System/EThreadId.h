@@ -18,6 +18,8 @@ typedef enum _EThreadId
     EThreadId_MasterDataReceiver                        = 9,
     EThreadId_MasterDataManager                         = 10,
     EThreadId_StaticSegmentProgramExecutor              = 11,
+    EThreadId_MeasurementRequestsWorker                 = 12,
+    EThreadId_HeaterRequestsWorker                      = 13,
     EThreadId_ISR                                       = 98,
     EThreadId_Unknown                                   = 99
 } EThreadId;
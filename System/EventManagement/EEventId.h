@@ -20,6 +20,10 @@ typedef enum _EEventId
     EEventId_ReceiveData                        = 13,
     EEventId_StartReceivingData                 = 14,
     EEventId_StartStaticSegment                 = 15,
+    EEventId_FrameFromMasterReceivedInd         = 16,
+    EEventId_TxCreditsGrantedInd                = 17,
+    EEventId_FrameBoundaryReq                   = 18,
+    EEventId_DeliveryAckReceivedInd             = 19,
     EEventId_Terminate                          = 99
 } EEventId;
 
@@ -134,10 +134,13 @@ DEFINE_EVENT_QUEUE_SIZED(MasterDataTransmitter, 10);
 DEFINE_EVENT_QUEUE_SIZED(MasterDataReceiver, 10);
 DEFINE_EVENT_QUEUE_SIZED(MasterDataManager, 10);
 DEFINE_EVENT_QUEUE_SIZED(StaticSegmentProgramExecutor, 2);
+DEFINE_EVENT_QUEUE_SIZED(MeasurementRequestsWorker, 6);
+DEFINE_EVENT_QUEUE_SIZED(HeaterRequestsWorker, 6);
 
 DEFINE_EVENT_HEAP(NewRTDValueInd, 10);
 DEFINE_EVENT_HEAP(NewThermocoupleVoltageValueInd, 10);
-DEFINE_EVENT_HEAP(DataFromMasterReceivedInd, 20);
+DEFINE_EVENT_HEAP(DataFromMasterReceivedInd, 32);
+DEFINE_EVENT_HEAP(FrameFromMasterReceivedInd, 4);
 
 /***************************************INTERNAL FUNCTION DECLARATIONS*******************************************************/
 
@@ -172,10 +175,13 @@ void Event_setup(void)
     CREATE_EVENT_QUEUE(MasterDataReceiver, Signal);
     CREATE_EVENT_QUEUE(MasterDataManager, Signal);
     CREATE_EVENT_QUEUE(StaticSegmentProgramExecutor, Signal);
+    CREATE_EVENT_QUEUE(MeasurementRequestsWorker, Signal);
+    CREATE_EVENT_QUEUE(HeaterRequestsWorker, Signal);
     
     CREATE_EVENT_HEAP(NewRTDValueInd);
     CREATE_EVENT_HEAP(NewThermocoupleVoltageValueInd);
     CREATE_EVENT_HEAP(DataFromMasterReceivedInd);
+    CREATE_EVENT_HEAP(FrameFromMasterReceivedInd);
 }
 
 OsEventId Event_getId(EThreadId threadId)
@@ -192,6 +198,8 @@ OsEventId Event_getId(EThreadId threadId)
     EVENT_GET_ID_HANDLER(MasterDataReceiver)
     EVENT_GET_ID_HANDLER(MasterDataManager)
     EVENT_GET_ID_HANDLER(StaticSegmentProgramExecutor)
+    EVENT_GET_ID_HANDLER(MeasurementRequestsWorker)
+    EVENT_GET_ID_HANDLER(HeaterRequestsWorker)
     
     return NULL;
 }
@@ -253,6 +261,8 @@ osStatus sendEventToThread(EThreadId threadId, TEvent* allocatedEvent)
         SEND_EVENT_TO_THREAD_HANDLER(MasterDataReceiver)
         SEND_EVENT_TO_THREAD_HANDLER(MasterDataManager)
         SEND_EVENT_TO_THREAD_HANDLER(StaticSegmentProgramExecutor)
+        SEND_EVENT_TO_THREAD_HANDLER(MeasurementRequestsWorker)
+        SEND_EVENT_TO_THREAD_HANDLER(HeaterRequestsWorker)
     }
     
     return status;
@@ -289,6 +299,8 @@ TEvent* allocateMallocEvent(EThreadId threadId)
     ALLOCATE_MALLOC_HANDLER(MasterDataReceiver)
     ALLOCATE_MALLOC_HANDLER(MasterDataManager)
     ALLOCATE_MALLOC_HANDLER(StaticSegmentProgramExecutor)
+    ALLOCATE_MALLOC_HANDLER(MeasurementRequestsWorker)
+    ALLOCATE_MALLOC_HANDLER(HeaterRequestsWorker)
     
     return allocatedEvent;
 }
@@ -300,6 +312,7 @@ void allocateMallocEventMessage(TEvent* event, EEventId eventId)
         ALLOCATE_MALLOC_EVENT_MESSAGE_HANDLER(NewRTDValueInd)
         ALLOCATE_MALLOC_EVENT_MESSAGE_HANDLER(NewThermocoupleVoltageValueInd)
         ALLOCATE_MALLOC_EVENT_MESSAGE_HANDLER(DataFromMasterReceivedInd)
+        ALLOCATE_MALLOC_EVENT_MESSAGE_HANDLER(FrameFromMasterReceivedInd)
         
         default :
             break;
@@ -324,6 +337,8 @@ TEvent* allocateCallocEvent(EThreadId threadId)
     ALLOCATE_CALLOC_HANDLER(MasterDataReceiver)
     ALLOCATE_CALLOC_HANDLER(MasterDataManager)
     ALLOCATE_CALLOC_HANDLER(StaticSegmentProgramExecutor)
+    ALLOCATE_CALLOC_HANDLER(MeasurementRequestsWorker)
+    ALLOCATE_CALLOC_HANDLER(HeaterRequestsWorker)
     
     return allocatedEvent;
 }
@@ -335,6 +350,7 @@ void allocateCallocEventMessage(TEvent* event, EEventId eventId)
         ALLOCATE_CALLOC_EVENT_MESSAGE_HANDLER(NewRTDValueInd)
         ALLOCATE_CALLOC_EVENT_MESSAGE_HANDLER(NewThermocoupleVoltageValueInd)
         ALLOCATE_CALLOC_EVENT_MESSAGE_HANDLER(DataFromMasterReceivedInd)
+        ALLOCATE_CALLOC_EVENT_MESSAGE_HANDLER(FrameFromMasterReceivedInd)
         
         default :
             break;
@@ -350,6 +366,7 @@ void freeEventMessage(TEvent* event)
         FREE_ALLOCATED_EVENT_MESSAGE_HANDLER(NewRTDValueInd)
         FREE_ALLOCATED_EVENT_MESSAGE_HANDLER(NewThermocoupleVoltageValueInd)
         FREE_ALLOCATED_EVENT_MESSAGE_HANDLER(DataFromMasterReceivedInd)
+        FREE_ALLOCATED_EVENT_MESSAGE_HANDLER(FrameFromMasterReceivedInd)
         
         default :
             break;
@@ -370,6 +387,8 @@ void freeEvent(EThreadId threadId, TEvent* event)
     FREE_ALLOCATED_EVENT_HANDLER(MasterDataReceiver)
     FREE_ALLOCATED_EVENT_HANDLER(MasterDataManager)
     FREE_ALLOCATED_EVENT_HANDLER(StaticSegmentProgramExecutor)
+    FREE_ALLOCATED_EVENT_HANDLER(MeasurementRequestsWorker)
+    FREE_ALLOCATED_EVENT_HANDLER(HeaterRequestsWorker)
 }
 
 #undef waitForEvent
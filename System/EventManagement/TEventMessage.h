@@ -4,21 +4,35 @@
 
 #include "SharedDefines/EUnitId.h"
 #include "SharedDefines/TMessage.h"
+#include "SharedDefines/TRequestContext.h"
 
 typedef struct _TEventMessageNewRTDValueInd
 {
     float value;
+    u32 code;
+    u32 timestamp;
 } TEventMessageNewRTDValueInd;
 
 typedef struct _TEventMessageNewThermocoupleVoltageValueInd
 {
     EUnitId thermocouple;
     double value;
+    u32 code;
+    float gain;
+    u32 timestamp;
 } TEventMessageNewThermocoupleVoltageValueInd;
 
 typedef struct _TEventMessageDataFromMasterReceivedInd
 {
     TMessage message;
+    TRequestContext context;
 } TEventMessageDataFromMasterReceivedInd;
 
+typedef struct _TEventMessageFrameFromMasterReceivedInd
+{
+    TByte* frame;
+    u16 length;
+    u32 timestamp;
+} TEventMessageFrameFromMasterReceivedInd;
+
 #endif
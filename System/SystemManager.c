@@ -1,5 +1,6 @@
 #include "System/SystemManager.h"
 #include "System/KernelManager.h"
+#include "System/TelemetryScheduler.h"
 #include "System/EventManagement/Event.h"
 #include "System/EventManagement/EEventId.h"
 #include "System/EventManagement/TEvent.h"
@@ -11,10 +12,12 @@
 
 #include "Utilities/Logger/Logger.h"
 #include "Peripherals/EXTI.h"
+#include "Peripherals/FlashStorage.h"
 #include "Peripherals/LED.h"
 #include "Peripherals/I2C1.h"
 #include "Peripherals/SPI2.h"
 #include "Peripherals/SPI3.h"
+#include "Peripherals/TIM2.h"
 #include "Peripherals/TIM3.h"
 #include "Peripherals/UART1.h"
 #include "Peripherals/UART2.h"
@@ -31,12 +34,22 @@
 #include "Controller/ReferenceTemperatureController.h"
 #include "Controller/InertialModel.h"
 #include "Controller/SegmentsManager.h"
+#include "Controller/SampleRecorder.h"
+#include "Controller/SetPointTrajectory.h"
+#include "Controller/ConfigurationBatch.h"
+#include "Controller/EmergencyStop.h"
+#include "Controller/CommandScript.h"
 
 #include "MasterCommunication/MasterDataManager.h"
 #include "MasterCommunication/MasterDataMemoryManager.h"
 #include "MasterCommunication/MasterDataReceiver.h"
 #include "MasterCommunication/MasterDataTransmitter.h"
 #include "MasterCommunication/MasterUartGateway.h"
+#include "MasterCommunication/TimeSynchronizer.h"
+#include "MasterCommunication/LinkStatistics.h"
+#include "MasterCommunication/BulkTransfer.h"
+#include "MasterCommunication/MeasurementRequestsWorker.h"
+#include "MasterCommunication/HeaterRequestsWorker.h"
 
 #include "Testing/SampleThread.h"
 
@@ -80,13 +93,16 @@ void setup(void)
 {
     Event_setup();
     KernelManager_setup();
+    TelemetryScheduler_setup();
     
     EXTI_setup();
+    FlashStorage_setup();
     I2C1_setup();
     LED_setup();
     Logger_setup();
     SPI2_setup();
     SPI3_setup();
+    TIM2_setup();
     
     ADS1248_setup();
     LMP90100ControlSystem_setup();
@@ -97,6 +113,11 @@ void setup(void)
     HeaterTemperatureReader_setup();
     SampleCarrierDataManager_setup();
     SegmentsManager_setup();
+    SampleRecorder_setup();
+    SetPointTrajectory_setup();
+    ConfigurationBatch_setup();
+    EmergencyStop_setup();
+    CommandScript_setup();
     ReferenceTemperatureReader_setup();
     ReferenceTemperatureController_setup();
     
@@ -105,6 +126,11 @@ void setup(void)
     MasterDataReceiver_setup();
     MasterDataTransmitter_setup();
     MasterUartGateway_setup();
+    TimeSynchronizer_setup();
+    LinkStatistics_setup();
+    BulkTransfer_setup();
+    MeasurementRequestsWorker_setup();
+    HeaterRequestsWorker_setup();
 }
 
 void createThreads(void)
@@ -121,6 +147,8 @@ void createThreads(void)
     THREAD_CREATE(MasterDataManager, Low, configNORMAL_STACK_SIZE);
     THREAD_CREATE(MasterDataReceiver, High, configNORMAL_STACK_SIZE);
     THREAD_CREATE(MasterDataTransmitter, Low, configMAXIMUM_STACK_SIZE);
+    THREAD_CREATE(MeasurementRequestsWorker, Low, configNORMAL_STACK_SIZE);
+    THREAD_CREATE(HeaterRequestsWorker, Low, configNORMAL_STACK_SIZE);
     //THREAD_CREATE(SampleThread, Normal, configMINIMAL_STACK_SIZE);
 }
 
@@ -193,6 +221,7 @@ bool configurePeripheralsPhaseOne(void)
     conditionalExecutor(I2C1_initialize, &result);
     conditionalExecutor(SPI2_initialize, &result);
     conditionalExecutor(SPI3_initialize, &result);
+    conditionalExecutor(TIM2_initialize, &result);
     
     if (UART2_isInitialized())
     {
@@ -289,6 +318,8 @@ void initializeCommunicationWithMaster(void)
     KernelManager_startThread(mThreadId, EThreadId_MasterDataManager);
     KernelManager_startThread(mThreadId, EThreadId_MasterDataReceiver);
     KernelManager_startThread(mThreadId, EThreadId_MasterDataTransmitter);
+    KernelManager_startThread(mThreadId, EThreadId_MeasurementRequestsWorker);
+    KernelManager_startThread(mThreadId, EThreadId_HeaterRequestsWorker);
     
     CREATE_EVENT(StartReceivingData, EThreadId_MasterDataReceiver);
     SEND_EVENT();
@@ -0,0 +1,262 @@
+#include "System/TelemetryScheduler.h"
+
+#include "MasterCommunication/MasterDataTransmitter.h"
+
+#include "FaultManagement/FaultIndication.h"
+
+#include "Utilities/Logger/Logger.h"
+#include "Utilities/Printer/CStringConverter.h"
+
+#include "cmsis_os.h"
+
+// Single time base for periodic telemetry. Every stream period is a multiple of the tick, and each stream
+// gets a phase chosen so that it collides with as few already scheduled streams as possible. Streams due
+// in the same tick are emitted back to back and the container is flushed at the end of the tick, so they go out
+// together in one container frame as long as they fit in it.
+
+#define TELEMETRY_SCHEDULER_TICK_MS 10U
+
+typedef struct _STelemetryStreamSchedule
+{
+    void (*callback)(void);
+    u16 periodTicks;
+    u16 phaseTicks;
+} STelemetryStreamSchedule;
+
+static osMutexDef(mMutex);
+static osMutexId mMutexId = NULL;
+
+static osTimerId mTickTimerId = NULL;
+static bool mIsTickTimerStarted = false;
+static u32 mTick = 0;
+
+static STelemetryStreamSchedule mSchedules [ETelemetryStream_Count];
+
+static void tickCallback(const void* arg);
+static u16 choosePhase(ETelemetryStream stream, u16 periodTicks);
+static u16 greatestCommonDivisor(u16 a, u16 b);
+static bool isAnyStreamRegistered(void);
+static bool startTickTimer(void);
+static bool stopTickTimer(void);
+static const char* getLoggerPrefix(void);
+
+void TelemetryScheduler_setup(void)
+{
+    mMutexId = osMutexCreate(osMutex(mMutex));
+    
+    osTimerDef(tickTimer, tickCallback);
+    mTickTimerId = osTimerCreate(osTimer(tickTimer), osTimerPeriodic, NULL);
+    
+    for (u8 iter = 0; ETelemetryStream_Count > iter; ++iter)
+    {
+        mSchedules[iter].callback = NULL;
+    }
+}
+
+bool TelemetryScheduler_registerStream(ETelemetryStream stream, void (*callback)(void), u16 period)
+{
+    if ( (ETelemetryStream_Count <= stream) || (NULL == callback) )
+    {
+        return false;
+    }
+    
+    u16 periodTicks = (period + (TELEMETRY_SCHEDULER_TICK_MS / 2U)) / TELEMETRY_SCHEDULER_TICK_MS;
+    if (0 == periodTicks)
+    {
+        periodTicks = 1;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    mSchedules[stream].callback = NULL;
+    mSchedules[stream].periodTicks = periodTicks;
+    mSchedules[stream].phaseTicks = choosePhase(stream, periodTicks);
+    mSchedules[stream].callback = callback;
+    
+    bool result = startTickTimer();
+    
+    osMutexRelease(mMutexId);
+    
+    Logger_debug
+    (
+        "%s: %s stream scheduled every %u ms with %u ms phase.",
+        getLoggerPrefix(),
+        CStringConverter_ETelemetryStream(stream),
+        periodTicks * TELEMETRY_SCHEDULER_TICK_MS,
+        mSchedules[stream].phaseTicks * TELEMETRY_SCHEDULER_TICK_MS
+    );
+    
+    return result;
+}
+
+bool TelemetryScheduler_deregisterStream(ETelemetryStream stream)
+{
+    if (ETelemetryStream_Count <= stream)
+    {
+        return false;
+    }
+    
+    osMutexWait(mMutexId, osWaitForever);
+    
+    mSchedules[stream].callback = NULL;
+    
+    bool result = true;
+    if (!isAnyStreamRegistered())
+    {
+        result = stopTickTimer();
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    Logger_debug("%s: %s stream descheduled.", getLoggerPrefix(), CStringConverter_ETelemetryStream(stream));
+    
+    return result;
+}
+
+void tickCallback(const void* arg)
+{
+    void (*dueCallbacks [ETelemetryStream_Count])(void);
+    u8 dueCallbacksCount = 0;
+    
+    // Callbacks take their producer mutexes, so they are called after the scheduler mutex is released.
+    osMutexWait(mMutexId, osWaitForever);
+    
+    ++mTick;
+    for (u8 iter = 0; ETelemetryStream_Count > iter; ++iter)
+    {
+        STelemetryStreamSchedule* schedule = &(mSchedules[iter]);
+        if ( (NULL != schedule->callback) && (schedule->phaseTicks == (mTick % schedule->periodTicks)) )
+        {
+            dueCallbacks[dueCallbacksCount++] = schedule->callback;
+        }
+    }
+    
+    osMutexRelease(mMutexId);
+    
+    for (u8 iter = 0; dueCallbacksCount > iter; ++iter)
+    {
+        (*dueCallbacks[iter])();
+    }
+    
+    if (0 < dueCallbacksCount)
+    {
+        MasterDataTransmitter_flushContainer();
+    }
+}
+
+u16 choosePhase(ETelemetryStream stream, u16 periodTicks)
+{
+    // Two streams fire in the same tick only if their phases are congruent modulo gcd of their periods.
+    // The phase with the fewest such collisions wins, ties go to the one farthest from its closest neighbour.
+    u16 bestPhase = 0;
+    u8 bestCollisionsCount = ETelemetryStream_Count;
+    u16 bestDistance = 0;
+    
+    for (u16 phase = 0; periodTicks > phase; ++phase)
+    {
+        u8 collisionsCount = 0;
+        u16 distance = periodTicks;
+        
+        for (u8 iter = 0; ETelemetryStream_Count > iter; ++iter)
+        {
+            STelemetryStreamSchedule* schedule = &(mSchedules[iter]);
+            if ( (stream == iter) || (NULL == schedule->callback) )
+            {
+                continue;
+            }
+            
+            u16 gcd = greatestCommonDivisor(periodTicks, schedule->periodTicks);
+            u16 offset = (phase + gcd - (schedule->phaseTicks % gcd)) % gcd;
+            u16 neighbourDistance = ( offset < (gcd - offset) ) ? offset : (gcd - offset);
+            
+            if (0 == neighbourDistance)
+            {
+                ++collisionsCount;
+            }
+            
+            if (distance > neighbourDistance)
+            {
+                distance = neighbourDistance;
+            }
+        }
+        
+        if ( (bestCollisionsCount > collisionsCount) || ( (bestCollisionsCount == collisionsCount) && (bestDistance < distance) ) )
+        {
+            bestCollisionsCount = collisionsCount;
+            bestDistance = distance;
+            bestPhase = phase;
+        }
+    }
+    
+    return bestPhase;
+}
+
+u16 greatestCommonDivisor(u16 a, u16 b)
+{
+    while (0 != b)
+    {
+        u16 rest = a % b;
+        a = b;
+        b = rest;
+    }
+    
+    return a;
+}
+
+bool isAnyStreamRegistered(void)
+{
+    for (u8 iter = 0; ETelemetryStream_Count > iter; ++iter)
+    {
+        if (NULL != mSchedules[iter].callback)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool startTickTimer(void)
+{
+    if (!mIsTickTimerStarted)
+    {
+        osStatus osResult = osTimerStart(mTickTimerId, TELEMETRY_SCHEDULER_TICK_MS);
+        if (osOK != osResult)
+        {
+            Logger_error("%s: Starting tick timer failed.", getLoggerPrefix());
+            Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
+            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+            return false;
+        }
+        
+        mIsTickTimerStarted = true;
+    }
+    
+    return true;
+}
+
+bool stopTickTimer(void)
+{
+    if (mIsTickTimerStarted)
+    {
+        osStatus osResult = osTimerStop(mTickTimerId);
+        if (osOK != osResult)
+        {
+            Logger_error("%s: Stopping tick timer failed.", getLoggerPrefix());
+            Logger_error("%s: RTOS failure: %s.", getLoggerPrefix(), CStringConverter_osStatus(osResult));
+            FaultIndication_start(EFaultId_System, EUnitId_Nucleo, EUnitId_Empty);
+            return false;
+        }
+        
+        mIsTickTimerStarted = false;
+    }
+    
+    return true;
+}
+
+const char* getLoggerPrefix(void)
+{
+    return "TelemetryScheduler";
+}
+
+#undef TELEMETRY_SCHEDULER_TICK_MS
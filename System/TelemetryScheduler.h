@@ -0,0 +1,14 @@
+#ifndef _TELEMETRY_SCHEDULER_H_
+
+#define _TELEMETRY_SCHEDULER_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/ETelemetryStream.h"
+#include "stdbool.h"
+
+void TelemetryScheduler_setup(void);
+
+bool TelemetryScheduler_registerStream(ETelemetryStream stream, void (*callback)(void), u16 period);
+bool TelemetryScheduler_deregisterStream(ETelemetryStream stream);
+
+#endif
@@ -0,0 +1,97 @@
+#include "Utilities/Cobs.h"
+
+u16 Cobs_encode(const TByte* source, u16 length, TByte* destination)
+{
+    u16 codeIndex = 0;
+    u16 writeIndex = 1;
+    u8 code = 1;
+    
+    for (u16 iter = 0; length > iter; ++iter)
+    {
+        if (COBS_DELIMITER == source[iter])
+        {
+            destination[codeIndex] = code;
+            codeIndex = writeIndex++;
+            code = 1;
+        }
+        else
+        {
+            destination[writeIndex++] = source[iter];
+            ++code;
+            
+            if (0xFF == code)
+            {
+                destination[codeIndex] = code;
+                codeIndex = writeIndex++;
+                code = 1;
+            }
+        }
+    }
+    
+    destination[codeIndex] = code;
+    
+    return writeIndex;
+}
+
+void Cobs_initializeDecoder(SCobsDecoder* decoder, TByte* buffer, u16 bufferSize)
+{
+    decoder->buffer = buffer;
+    decoder->bufferSize = bufferSize;
+    decoder->length = 0;
+    decoder->blockRemaining = 0;
+    decoder->isZeroPending = false;
+    decoder->isCorrupted = false;
+}
+
+ECobsDecoderStatus Cobs_decodeByte(SCobsDecoder* decoder, TByte byte)
+{
+    if (COBS_DELIMITER == byte)
+    {
+        if ( !decoder->isCorrupted && !decoder->isZeroPending && (0 == decoder->blockRemaining) && (0 == decoder->length) )
+        {
+            return ECobsDecoderStatus_InProgress;
+        }
+        
+        if ( decoder->isCorrupted || (0 != decoder->blockRemaining) || (0 == decoder->length) )
+        {
+            return ECobsDecoderStatus_FrameCorrupted;
+        }
+        
+        return ECobsDecoderStatus_FrameDone;
+    }
+    
+    if (decoder->isCorrupted)
+    {
+        return ECobsDecoderStatus_InProgress;
+    }
+    
+    if (0 == decoder->blockRemaining)
+    {
+        if (decoder->isZeroPending)
+        {
+            if (decoder->bufferSize <= decoder->length)
+            {
+                decoder->isCorrupted = true;
+                return ECobsDecoderStatus_InProgress;
+            }
+            
+            decoder->buffer[decoder->length++] = COBS_DELIMITER;
+        }
+        
+        decoder->blockRemaining = byte - 1;
+        decoder->isZeroPending = (0xFF != byte);
+    }
+    else
+    {
+        if (decoder->bufferSize <= decoder->length)
+        {
+            decoder->isCorrupted = true;
+            return ECobsDecoderStatus_InProgress;
+        }
+        
+        decoder->buffer[decoder->length++] = byte;
+        --(decoder->blockRemaining);
+    }
+    
+    return ECobsDecoderStatus_InProgress;
+}
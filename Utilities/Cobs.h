@@ -0,0 +1,33 @@
+#ifndef _COBS_H_
+
+#define _COBS_H_
+
+#include "Defines/CommonDefines.h"
+#include "stdbool.h"
+
+#define COBS_DELIMITER 0x00
+#define COBS_MAX_ENCODED_LENGTH(length) ( (length) + ( (length) / 254 ) + 1 )
+
+typedef enum _ECobsDecoderStatus
+{
+    ECobsDecoderStatus_InProgress       = 0,
+    ECobsDecoderStatus_FrameDone        = 1,
+    ECobsDecoderStatus_FrameCorrupted   = 2
+} ECobsDecoderStatus;
+
+typedef struct _SCobsDecoder
+{
+    TByte* buffer;
+    u16 bufferSize;
+    u16 length;
+    u8 blockRemaining;
+    bool isZeroPending;
+    bool isCorrupted;
+} SCobsDecoder;
+
+u16 Cobs_encode(const TByte* source, u16 length, TByte* destination);
+
+void Cobs_initializeDecoder(SCobsDecoder* decoder, TByte* buffer, u16 bufferSize);
+ECobsDecoderStatus Cobs_decodeByte(SCobsDecoder* decoder, TByte byte);
+
+#endif
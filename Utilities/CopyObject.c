@@ -6,6 +6,11 @@ void CopyObject_TMessage(TMessage* source, TMessage* dest)
     dest->id = source->id;
     dest->length = source->length;
     dest->transactionId = source->transactionId;
+    dest->crc = source->crc;
+    dest->isReliable = source->isReliable;
+    dest->isBroadcast = source->isBroadcast;
+    dest->sequenceNumber = source->sequenceNumber;
+    dest->timestamp = source->timestamp;
 }
 
 void CopyObject_SFaultIndication(SFaultIndication* source, SFaultIndication* dest)
@@ -27,6 +32,7 @@ void CopyObject_SSampleCarrierData(SSampleCarrierData* source, SSampleCarrierDat
     dest->rtdTemperatureValue = source->rtdTemperatureValue;*/
     dest->unitId = source->unitId;
     dest->value = source->value;
+    dest->timestamp = source->timestamp;
 }
 
 void CopyObject_SPidTunes(SPidTunes* source, SPidTunes* dest)
@@ -54,3 +60,34 @@ void CopyObject_SSegmentData(SSegmentData* source, SSegmentData* dest)
     dest->temperatureStep = source->temperatureStep;
     dest->type = source->type;
 }
+
+void CopyObject_SEmergencyStopReport(SEmergencyStopReport* source, SEmergencyStopReport* dest)
+{
+    dest->triggerTimestamp = source->triggerTimestamp;
+    dest->peltierStopTime = source->peltierStopTime;
+    dest->heaterStopTime = source->heaterStopTime;
+    dest->heaterOutputValue = source->heaterOutputValue;
+    dest->wasReferenceStabilizationActive = source->wasReferenceStabilizationActive;
+    dest->wasControllerRunning = source->wasControllerRunning;
+    dest->wasSegmentsProgramRunning = source->wasSegmentsProgramRunning;
+    dest->wasTrajectoryRunning = source->wasTrajectoryRunning;
+    dest->success = source->success;
+}
+
+void CopyObject_SSampleCarrierConversionDescriptor(SSampleCarrierConversionDescriptor* source, SSampleCarrierConversionDescriptor* dest)
+{
+    dest->configurationId = source->configurationId;
+    dest->thermocoupleReferenceVoltage = source->thermocoupleReferenceVoltage;
+    dest->thermocoupleGain = source->thermocoupleGain;
+    dest->thermocouplePositiveFullScaleCode = source->thermocouplePositiveFullScaleCode;
+    dest->thermocoupleOutputScale = source->thermocoupleOutputScale;
+    dest->isThermocoupleReferenceClamped = source->isThermocoupleReferenceClamped;
+    dest->rtdReferenceResistance = source->rtdReferenceResistance;
+    dest->rtdGain = source->rtdGain;
+    dest->rtdComparatorResistance = source->rtdComparatorResistance;
+    dest->rtdFullScaleCode = source->rtdFullScaleCode;
+    for (u8 iter = 0; RTD_TEMPERATURE_COEFFICIENTS_COUNT > iter; ++iter)
+    {
+        dest->rtdTemperatureCoefficients[iter] = source->rtdTemperatureCoefficients[iter];
+    }
+}
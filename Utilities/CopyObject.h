@@ -8,6 +8,8 @@
 #include "SharedDefines/SPidTunes.h"
 #include "SharedDefines/SControllerData.h"
 #include "SharedDefines/SSegmentData.h"
+#include "SharedDefines/SEmergencyStopReport.h"
+#include "SharedDefines/SSampleCarrierConversionDescriptor.h"
 
 void CopyObject_TMessage(TMessage* source, TMessage* dest);
 void CopyObject_SFaultIndication(SFaultIndication* source, SFaultIndication* dest);
@@ -15,5 +17,7 @@ void CopyObject_SSampleCarrierData(SSampleCarrierData* source, SSampleCarrierDat
 void CopyObject_SPidTunes(SPidTunes* source, SPidTunes* dest);
 void CopyObject_SControllerData(SControllerData* source, SControllerData* dest);
 void CopyObject_SSegmentData(SSegmentData* source, SSegmentData* dest);
+void CopyObject_SEmergencyStopReport(SEmergencyStopReport* source, SEmergencyStopReport* dest);
+void CopyObject_SSampleCarrierConversionDescriptor(SSampleCarrierConversionDescriptor* source, SSampleCarrierConversionDescriptor* dest);
 
 #endif
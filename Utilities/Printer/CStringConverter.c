@@ -4,180 +4,23 @@
 
 // SHARED DEFINES
 
+#define MESSAGE_NAME(name, id, poolSize, direction, lane) [EMessageId_##name] = #name,
+#define RAW_MESSAGE_NAME(name, id, direction, lane) [EMessageId_##name] = #name,
+
+static const char* const mMessageNames [EMessageId_Limit] =
+{
+    [EMessageId_Unknown] = "Unknown",
+    MESSAGES_REGISTRY(MESSAGE_NAME, RAW_MESSAGE_NAME)
+};
+
+#undef MESSAGE_NAME
+#undef RAW_MESSAGE_NAME
+
 const char* CStringConverter_EMessageId(EMessageId messageId)
 {
-    switch (messageId)
+    if ( (EMessageId_Limit > messageId) && (NULL != mMessageNames[messageId]) )
     {
-        case EMessageId_PollingRequest :
-            return "PollingRequest";
-        
-        case EMessageId_PollingResponse :
-            return "PollingResponse";
-        
-        case EMessageId_CallibreADS1248Request :
-            return "CallibreADS1248Request";
-        
-        case EMessageId_CallibreADS1248Response :
-            return "CallibreADS1248Response";
-        
-        case EMessageId_FaultInd :
-            return "FaultInd";
-        
-        case EMessageId_HeaterTemperatureInd :
-            return "HeaterTemperatureInd";
-        
-        case EMessageId_LogInd :
-            return "LogInd";
-        
-        case EMessageId_ReferenceTemperatureInd :
-            return "ReferenceTemperatureInd";
-        
-        case EMessageId_RegisterNewSegmentToProgramRequest :
-            return "RegisterNewSegmentToProgramRequest";
-        
-        case EMessageId_RegisterNewSegmentToProgramResponse :
-            return "RegisterNewSegmentToProgramResponse";
-        
-        case EMessageId_ResetUnitRequest :
-            return "ResetUnitRequest";
-        
-        case EMessageId_ResetUnitResponse :
-            return "ResetUnitResponse";
-        
-        case EMessageId_SampleCarrierDataInd :
-            return "SampleCarrierDataInd";
-        
-        case EMessageId_SetChannelGainADS1248Request :
-            return "SetChannelGainADS1248Request";
-        
-        case EMessageId_SetChannelGainADS1248Response :
-            return "SetChannelGainADS1248Response";
-        
-        case EMessageId_SetChannelSamplingSpeedADS1248Request :
-            return "SetChannelSamplingSpeedADS1248Response";
-        
-        case EMessageId_SetChannelSamplingSpeedADS1248Response :
-            return "SetChannelSamplingSpeedADS1248Response";
-        
-        case EMessageId_SetControllerTunesRequest :
-            return "SetControllerTunesRequest";
-        
-        case EMessageId_SetControllerTunesResponse :
-            return "SetControllerTunesResponse";
-        
-        case EMessageId_SetControlSystemTypeRequest :
-            return "SetControlSystemTypeRequest";
-        
-        case EMessageId_SetControlSystemTypeResponse :
-            return "SetControlSystemTypeResponse";
-        
-        case EMessageId_SetHeaterPowerRequest :
-            return "SetHeaterPowerRequest";
-        
-        case EMessageId_SetHeaterPowerResponse :
-            return "SetHeaterPowerResponse";
-        
-        case EMessageId_SetNewDeviceModeADS1248Request :
-            return "SetNewDeviceModeADS1248Request";
-        
-        case EMessageId_SetNewDeviceModeADS1248Response :
-            return "SetNewDeviceModeADS1248Response";
-        
-        case EMessageId_SetNewDeviceModeLMP90100ControlSystemRequest :
-            return "SetNewDeviceModeLMP90100ControlSystemRequest";
-        
-        case EMessageId_SetNewDeviceModeLMP90100ControlSystemResponse :
-            return "SetNewDeviceModeLMP90100ControlSystemResponse";
-        
-        case EMessageId_SetNewDeviceModeLMP90100SignalsMeasurementRequest :
-            return "SetNewDeviceModeLMP90100SignalsMeasurementRequest";
-        
-        case EMessageId_SetNewDeviceModeLMP90100SignalsMeasurementResponse :
-            return "SetNewDeviceModeLMP90100SignalsMeasurementResponse";
-        
-        case EMessageId_SetProcessModelParametersRequest :
-            return "SetProcessModelParametersRequest";
-        
-        case EMessageId_SetProcessModelParametersResponse :
-            return  "SetProrcessModelParametersResponse";
-        
-        case EMessageId_UnexpectedMasterMessageInd :
-            return "UnexpectedMasterMessageInd";
-        
-        case EMessageId_UnitReadyInd :
-            return "UnitReadyInd";
-        
-        case EMessageId_SegmentStartedInd :
-            return "SegmentStartedInd";
-        
-        case EMessageId_SetRTDPolynomialCoefficientsRequest :
-            return "SetRTDPolynomialCoefficientsRequest";
-        
-        case EMessageId_SetRTDPolynomialCoefficientsResponse :
-            return "SetRTDPolynomialCoefficientsResponse";
-        
-        case EMessageId_StartReferenceTemperatureStabilizationRequest :
-            return "StartReferenceTemperatureStabilizationRequest";
-        
-        case EMessageId_StartReferenceTemperatureStabilizationResponse :
-            return "StartReferenceTemperatureStabilizationResponse";
-        
-        case EMessageId_StartRegisteringDataRequest :
-            return "StartRegisteringDataRequest";
-        
-        case EMessageId_StartRegisteringDataResponse :
-            return "StartRegisteringDataResponse";
-        
-        case EMessageId_StopReferenceTemperatureStabilizationRequest :
-            return "StopReferenceTemperatureStabilizationRequest";
-        
-        case EMessageId_StopReferenceTemperatureStabilizationResponse :
-            return "StopReferenceTemperatureStabilizationResponse";
-        
-        case EMessageId_StopRegisteringDataRequest :
-            return "StopRegisteringDataRequest";
-        
-        case EMessageId_StopRegisteringDataResponse :
-            return "StopRegisteringDataResponse";
-        
-        case EMessageId_SetControllingAlgorithmExecutionPeriodRequest :
-            return "SetControllingAlgorithmExecutionPeriodRequest";
-        
-        case EMessageId_SetControllingAlgorithmExecutionPeriodResponse :
-            return "SetControllingAlgorithmExecutionPeriodResponse";
-        
-        case EMessageId_ControllerDataInd :
-            return "ControllerDataInd";
-        
-        case EMessageId_SegmentsProgramDoneInd :
-            return "SegmentsProgramDoneInd";
-        
-        case EMessageId_DeregisterSegmentFromProgramRequest :
-            return "DeregisterSegmentFromProgramRequest";
-        
-        case EMessageId_DeregisterSegmentFromProgramResponse :
-            return "DeregisterSegmentFromProgramResponse";
-        
-        case EMessageId_StartSegmentProgramRequest :
-            return "StartSegmentProgramRequest";
-        
-        case EMessageId_StartSegmentProgramResponse :
-            return "StartSegmentProgramResponse";
-        
-        case EMessageId_StopSegmentProgramRequest :
-            return "StopSegmentProgramRequest";
-        
-        case EMessageId_StopSegmentProgramResponse :
-            return "StopSegmentProgramResponse";
-        
-        case EMessageId_SetHeaterTemperatureInFeedbackModeRequest :
-            return "SetHeaterTemperatureInFeedbackModeRequest";
-        
-        case EMessageId_SetHeaterTemperatureInFeedbackModeResponse :
-            return "SetHeaterTemperatureInFeedbackModeResponse";
-        
-        case EMessageId_Unknown :
-            return "Unknown";
+        return mMessageNames[messageId];
     }
     
     return "Unknown EMessageId";
@@ -286,7 +129,7 @@ const char* CStringConverter_EUnitId(EUnitId unitId)
                         
         case EUnitId_Thermocouple4 :
             return "Thermocouple 4";
-
+        
         case EUnitId_Peltier :
             return "Peltier";
         
@@ -342,19 +185,19 @@ const char* CStringConverter_EExtiType(EExtiType extiType)
     {
         case EExtiType_EXTI0 :
             return "EXTI0";
-
+        
         case EExtiType_EXTI1 :
             return "EXTI1";
-
+        
         case EExtiType_EXTI2 :
             return "EXTI2";
-
+        
         case EExtiType_EXTI3 :
             return "EXTI3";
-
+        
         case EExtiType_EXTI4 :
             return "EXTI4";
-
+        
         case EExtiType_EXTI9_5 :
             return "EXTI9_5";
         
@@ -457,6 +300,18 @@ const char* CStringConverter_EEventId(EEventId eventId)
         case EEventId_StartStaticSegment :
             return "StartStaticSegment";
         
+        case EEventId_FrameFromMasterReceivedInd :
+            return "FrameFromMasterReceivedInd";
+        
+        case EEventId_TxCreditsGrantedInd :
+            return "TxCreditsGrantedInd";
+        
+        case EEventId_FrameBoundaryReq :
+            return "FrameBoundaryReq";
+        
+        case EEventId_DeliveryAckReceivedInd :
+            return "DeliveryAckReceivedInd";
+        
         case EEventId_Terminate :
             return "Terminate";
     }
@@ -507,6 +362,12 @@ const char* CStringConverter_EThreadId(EThreadId threadId)
         case EThreadId_StaticSegmentProgramExecutor :
             return "StaticSegmentProgramExecutor";
         
+        case EThreadId_MeasurementRequestsWorker :
+            return "MeasurementRequestsWorker";
+        
+        case EThreadId_HeaterRequestsWorker :
+            return "HeaterRequestsWorker";
+        
         case EThreadId_ISR :
             return "ISR";
     }
@@ -724,6 +585,239 @@ const char* CStringConverter_ERegisteringDataType(ERegisteringDataType registeri
     return "Unknown ERegisteringDataType";
 }
 
+const char* CStringConverter_EFramingMode(EFramingMode framingMode)
+{
+    switch (framingMode)
+    {
+        case EFramingMode_Legacy :
+            return "Legacy";
+        
+        case EFramingMode_Cobs :
+            return "COBS";
+    }
+    
+    return "Unknown EFramingMode";
+}
+
+const char* CStringConverter_ETxLane(ETxLane lane)
+{
+    switch (lane)
+    {
+        case ETxLane_Responses :
+            return "Responses";
+        
+        case ETxLane_ControlTelemetry :
+            return "Control Telemetry";
+        
+        case ETxLane_BulkSamples :
+            return "Bulk Samples";
+        
+        case ETxLane_BulkTransfer :
+            return "Bulk Transfer";
+        
+        case ETxLane_Logs :
+            return "Logs";
+        
+        case ETxLane_Count :
+            break;
+    }
+    
+    return "Unknown ETxLane";
+}
+
+const char* CStringConverter_EStreamFilterType(EStreamFilterType filterType)
+{
+    switch (filterType)
+    {
+        case EStreamFilterType_Decimation :
+            return "Decimation";
+        
+        case EStreamFilterType_Boxcar :
+            return "Boxcar";
+        
+        case EStreamFilterType_Cic :
+            return "CIC";
+        
+        case EStreamFilterType_Min :
+            return "Min";
+        
+        case EStreamFilterType_Max :
+            return "Max";
+    }
+    
+    return "Unknown EStreamFilterType";
+}
+
+const char* CStringConverter_ETelemetryStream(ETelemetryStream stream)
+{
+    switch (stream)
+    {
+        case ETelemetryStream_HeaterTemperature :
+            return "Heater Temperature";
+        
+        case ETelemetryStream_ControllerData :
+            return "Controller Data";
+        
+        case ETelemetryStream_Count :
+            break;
+    }
+    
+    return "Unknown ETelemetryStream";
+}
+
+const char* CStringConverter_EBulkTransferSource(EBulkTransferSource source)
+{
+    switch (source)
+    {
+        case EBulkTransferSource_Recording :
+            return "Recording";
+        
+        case EBulkTransferSource_Count :
+            break;
+    }
+    
+    return "Unknown EBulkTransferSource";
+}
+
+const char* CStringConverter_ECommandScriptOpcode(ECommandScriptOpcode opcode)
+{
+    switch (opcode)
+    {
+        case ECommandScriptOpcode_End :
+            return "End";
+        
+        case ECommandScriptOpcode_SetRegister :
+            return "Set Register";
+        
+        case ECommandScriptOpcode_Wait :
+            return "Wait";
+        
+        case ECommandScriptOpcode_SetSegment :
+            return "Set Segment";
+        
+        case ECommandScriptOpcode_LoopBegin :
+            return "Loop Begin";
+        
+        case ECommandScriptOpcode_LoopEnd :
+            return "Loop End";
+        
+        case ECommandScriptOpcode_EmitMarker :
+            return "Emit Marker";
+        
+        case ECommandScriptOpcode_Count :
+            break;
+    }
+    
+    return "Unknown ECommandScriptOpcode";
+}
+
+const char* CStringConverter_ECommandScriptRegister(ECommandScriptRegister scriptRegister)
+{
+    switch (scriptRegister)
+    {
+        case ECommandScriptRegister_HeaterPower :
+            return "Heater Power";
+        
+        case ECommandScriptRegister_HeaterSetPoint :
+            return "Heater Set Point";
+        
+        case ECommandScriptRegister_HeaterControllerRunning :
+            return "Heater Controller Running";
+        
+        case ECommandScriptRegister_ReferenceStabilization :
+            return "Reference Stabilization";
+        
+        case ECommandScriptRegister_ADS1248Gain :
+            return "ADS1248 Gain";
+        
+        case ECommandScriptRegister_ADS1248SamplingSpeed :
+            return "ADS1248 Sampling Speed";
+        
+        case ECommandScriptRegister_ControlSystemType :
+            return "Control System Type";
+        
+        case ECommandScriptRegister_AlgorithmExecutionPeriod :
+            return "Algorithm Execution Period";
+        
+        case ECommandScriptRegister_SegmentsProgramRunning :
+            return "Segments Program Running";
+        
+        case ECommandScriptRegister_Count :
+            break;
+    }
+    
+    return "Unknown ECommandScriptRegister";
+}
+
+const char* CStringConverter_ECommandScriptCondition(ECommandScriptCondition condition)
+{
+    switch (condition)
+    {
+        case ECommandScriptCondition_Delay :
+            return "Delay";
+        
+        case ECommandScriptCondition_HeaterTemperatureAbove :
+            return "Heater Temperature Above";
+        
+        case ECommandScriptCondition_HeaterTemperatureBelow :
+            return "Heater Temperature Below";
+        
+        case ECommandScriptCondition_ReferenceTemperatureAbove :
+            return "Reference Temperature Above";
+        
+        case ECommandScriptCondition_ReferenceTemperatureBelow :
+            return "Reference Temperature Below";
+        
+        case ECommandScriptCondition_ControllerErrorWithin :
+            return "Controller Error Within";
+        
+        case ECommandScriptCondition_Count :
+            break;
+    }
+    
+    return "Unknown ECommandScriptCondition";
+}
+
+const char* CStringConverter_ECommandScriptStatus(ECommandScriptStatus status)
+{
+    switch (status)
+    {
+        case ECommandScriptStatus_Done :
+            return "Done";
+        
+        case ECommandScriptStatus_Stopped :
+            return "Stopped";
+        
+        case ECommandScriptStatus_WaitTimeout :
+            return "Wait Timeout";
+        
+        case ECommandScriptStatus_InstructionFailed :
+            return "Instruction Failed";
+        
+        case ECommandScriptStatus_EmergencyStop :
+            return "Emergency Stop";
+    }
+    
+    return "Unknown ECommandScriptStatus";
+}
+
+const char* CStringConverter_ESampleStreamFormat(ESampleStreamFormat format)
+{
+    switch (format)
+    {
+        case ESampleStreamFormat_Converted :
+            return "Converted";
+        
+        case ESampleStreamFormat_RawCode :
+            return "Raw Code";
+        
+        case ESampleStreamFormat_Count :
+            break;
+    }
+    
+    return "Unknown ESampleStreamFormat";
+}
+
 const char* CStringConverter_osStatus(osStatus status)
 {
     switch (status)
@@ -9,6 +9,16 @@
 #include "SharedDefines/EControlSystemType.h"
 #include "SharedDefines/EPid.h"
 #include "SharedDefines/ERegisteringDataType.h"
+#include "SharedDefines/EFramingMode.h"
+#include "SharedDefines/ETxLane.h"
+#include "SharedDefines/EStreamFilterType.h"
+#include "SharedDefines/ETelemetryStream.h"
+#include "SharedDefines/EBulkTransferSource.h"
+#include "SharedDefines/ECommandScriptOpcode.h"
+#include "SharedDefines/ECommandScriptRegister.h"
+#include "SharedDefines/ECommandScriptCondition.h"
+#include "SharedDefines/ECommandScriptStatus.h"
+#include "SharedDefines/ESampleStreamFormat.h"
 
 #include "Peripherals/TypesLed.h"
 #include "Peripherals/TypesExti.h"
@@ -54,6 +64,16 @@ const char* CStringConverter_EADS1248SamplingSpeed(EADS1248SamplingSpeed ads1248
 const char* CStringConverter_EControlSystemType(EControlSystemType controlSystemType);
 const char* CStringConverter_EPid(EPid pid);
 const char* CStringConverter_ERegisteringDataType(ERegisteringDataType registeringDataType);
+const char* CStringConverter_EFramingMode(EFramingMode framingMode);
+const char* CStringConverter_ETxLane(ETxLane lane);
+const char* CStringConverter_EStreamFilterType(EStreamFilterType filterType);
+const char* CStringConverter_ETelemetryStream(ETelemetryStream stream);
+const char* CStringConverter_EBulkTransferSource(EBulkTransferSource source);
+const char* CStringConverter_ECommandScriptOpcode(ECommandScriptOpcode opcode);
+const char* CStringConverter_ECommandScriptRegister(ECommandScriptRegister scriptRegister);
+const char* CStringConverter_ECommandScriptCondition(ECommandScriptCondition condition);
+const char* CStringConverter_ECommandScriptStatus(ECommandScriptStatus status);
+const char* CStringConverter_ESampleStreamFormat(ESampleStreamFormat format);
 
 // CMSIS RTOS
 
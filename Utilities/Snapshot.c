@@ -0,0 +1,61 @@
+#include "Utilities/Snapshot.h"
+
+#include "cmsis_os.h"
+#include "stm32f4xx_hal.h"
+
+// Sequence lock with single writer. Odd sequence means the writer is inside its critical section;
+// a reader retries a bounded number of times and never blocks the writer.
+// Timestamps are given by the writer: when the value was acquired, in the TIM2 microsecond timebase
+// of every sample stream, not when it was published.
+
+void Snapshot_beginWrite(SSnapshot* snapshot)
+{
+    ++(snapshot->sequence);
+    __DMB();
+}
+
+void Snapshot_endWrite(SSnapshot* snapshot, u32 timestamp)
+{
+    snapshot->timestamp = timestamp;
+    __DMB();
+    ++(snapshot->sequence);
+}
+
+u32 Snapshot_beginRead(const SSnapshot* snapshot)
+{
+    u32 sequence = snapshot->sequence;
+    __DMB();
+    return sequence;
+}
+
+bool Snapshot_endRead(const SSnapshot* snapshot, u32 sequence)
+{
+    __DMB();
+    return ( (0 == (sequence & 1)) && (snapshot->sequence == sequence) );
+}
+
+void Snapshot_writeFloat(SFloatSnapshot* snapshot, float value, u32 timestamp)
+{
+    Snapshot_beginWrite(&(snapshot->header));
+    snapshot->value = value;
+    Snapshot_endWrite(&(snapshot->header), timestamp);
+}
+
+bool Snapshot_readFloat(const SFloatSnapshot* snapshot, float* value, u32* timestamp)
+{
+    for (u8 iter = 0; SNAPSHOT_MAX_READ_ATTEMPTS > iter; ++iter)
+    {
+        u32 sequence = Snapshot_beginRead(&(snapshot->header));
+        float readValue = snapshot->value;
+        u32 readTimestamp = snapshot->header.timestamp;
+        
+        if (Snapshot_endRead(&(snapshot->header), sequence))
+        {
+            *value = readValue;
+            *timestamp = ( 0 != sequence ) ? readTimestamp : 0;
+            return ( 0 != sequence );
+        }
+    }
+    
+    return false;
+}
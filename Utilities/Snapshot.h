@@ -0,0 +1,30 @@
+#ifndef _SNAPSHOT_H_
+
+#define _SNAPSHOT_H_
+
+#include "Defines/CommonDefines.h"
+#include "stdbool.h"
+
+#define SNAPSHOT_MAX_READ_ATTEMPTS 4
+
+typedef struct _SSnapshot
+{
+    volatile u32 sequence;
+    volatile u32 timestamp;
+} SSnapshot;
+
+typedef struct _SFloatSnapshot
+{
+    SSnapshot header;
+    volatile float value;
+} SFloatSnapshot;
+
+void Snapshot_beginWrite(SSnapshot* snapshot);
+void Snapshot_endWrite(SSnapshot* snapshot, u32 timestamp);
+u32 Snapshot_beginRead(const SSnapshot* snapshot);
+bool Snapshot_endRead(const SSnapshot* snapshot, u32 sequence);
+
+void Snapshot_writeFloat(SFloatSnapshot* snapshot, float value, u32 timestamp);
+bool Snapshot_readFloat(const SFloatSnapshot* snapshot, float* value, u32* timestamp);
+
+#endif
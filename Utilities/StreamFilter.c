@@ -0,0 +1,134 @@
+#include "Utilities/StreamFilter.h"
+
+#include "string.h"
+
+#define CIC_FIXED_POINT_SCALE 65536.0F
+
+static float calculateCicOutput(SStreamFilter* filter);
+
+bool StreamFilter_configure(SStreamFilter* filter, EStreamFilterType type, u16 decimationFactor)
+{
+    if ( (EStreamFilterType_Max < type) || (0 == decimationFactor) || (STREAM_FILTER_MAX_DECIMATION_FACTOR < decimationFactor) )
+    {
+        return false;
+    }
+    
+    memset(filter, 0, sizeof(SStreamFilter));
+    filter->type = type;
+    filter->decimationFactor = decimationFactor;
+    
+    return true;
+}
+
+bool StreamFilter_process(SStreamFilter* filter, float input, float* output)
+{
+    if (1 >= filter->decimationFactor)
+    {
+        *output = input;
+        return true;
+    }
+    
+    switch (filter->type)
+    {
+        case EStreamFilterType_Decimation :
+        {
+            if (0 == filter->count)
+            {
+                filter->value = input;
+            }
+            break;
+        }
+        
+        case EStreamFilterType_Boxcar :
+        {
+            filter->sum += input;
+            break;
+        }
+        
+        case EStreamFilterType_Cic :
+        {
+            u64 sample = (u64) ( (i64) ( input * CIC_FIXED_POINT_SCALE ) );
+            
+            for (u8 iter = 0; STREAM_FILTER_CIC_ORDER > iter; ++iter)
+            {
+                filter->integrators[iter] += sample;
+                sample = filter->integrators[iter];
+            }
+            break;
+        }
+        
+        case EStreamFilterType_Min :
+        {
+            if ( (0 == filter->count) || (input < filter->value) )
+            {
+                filter->value = input;
+            }
+            break;
+        }
+        
+        case EStreamFilterType_Max :
+        {
+            if ( (0 == filter->count) || (input > filter->value) )
+            {
+                filter->value = input;
+            }
+            break;
+        }
+        
+        default :
+            break;
+    }
+    
+    if (filter->decimationFactor > ++(filter->count))
+    {
+        return false;
+    }
+    
+    filter->count = 0;
+    
+    switch (filter->type)
+    {
+        case EStreamFilterType_Boxcar :
+        {
+            *output = filter->sum / filter->decimationFactor;
+            filter->sum = 0.0F;
+            break;
+        }
+        
+        case EStreamFilterType_Cic :
+        {
+            *output = calculateCicOutput(filter);
+            break;
+        }
+        
+        default :
+        {
+            *output = filter->value;
+            break;
+        }
+    }
+    
+    return true;
+}
+
+float calculateCicOutput(SStreamFilter* filter)
+{
+    u64 sample = filter->integrators[STREAM_FILTER_CIC_ORDER - 1];
+    
+    for (u8 iter = 0; STREAM_FILTER_CIC_ORDER > iter; ++iter)
+    {
+        u64 difference = sample - filter->combDelays[iter];
+        filter->combDelays[iter] = sample;
+        sample = difference;
+    }
+    
+    float gain = CIC_FIXED_POINT_SCALE;
+    for (u8 iter = 0; STREAM_FILTER_CIC_ORDER > iter; ++iter)
+    {
+        gain *= filter->decimationFactor;
+    }
+    
+    return ( (float) ( (i64) sample ) / gain );
+}
+
+#undef CIC_FIXED_POINT_SCALE
@@ -0,0 +1,26 @@
+#ifndef _STREAM_FILTER_H_
+
+#define _STREAM_FILTER_H_
+
+#include "Defines/CommonDefines.h"
+#include "SharedDefines/EStreamFilterType.h"
+#include "stdbool.h"
+
+#define STREAM_FILTER_CIC_ORDER 3
+#define STREAM_FILTER_MAX_DECIMATION_FACTOR 256
+
+typedef struct _SStreamFilter
+{
+    EStreamFilterType type;
+    u16 decimationFactor;
+    u16 count;
+    float value;
+    float sum;
+    u64 integrators [STREAM_FILTER_CIC_ORDER];
+    u64 combDelays [STREAM_FILTER_CIC_ORDER];
+} SStreamFilter;
+
+bool StreamFilter_configure(SStreamFilter* filter, EStreamFilterType type, u16 decimationFactor);
+bool StreamFilter_process(SStreamFilter* filter, float input, float* output);
+
+#endif